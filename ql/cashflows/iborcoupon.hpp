@@ -53,6 +53,12 @@ namespace QuantLib {
         const boost::shared_ptr<IborIndex>& iborIndex() const {
             return iborIndex_;
         }
+        //! start of the period spanned by the index fixing
+        const Date& fixingValueDate() const { return fixingValueDate_; }
+        //! end of the period spanned by the index fixing
+        const Date& fixingEndDate() const { return fixingEndDate_; }
+        //! index year fraction of the period spanned by the fixing
+        Time spanningTime() const { return spanningTime_; }
         //@}
         //! \name FloatingRateCoupon interface
         //@{
@@ -42,6 +42,15 @@ namespace QuantLib {
         registerWith(termStructure_);
     }
 
+    TreeCallableFixedRateBondEngine::TreeCallableFixedRateBondEngine(
+                           const boost::shared_ptr<ShortRateTreeCache>& cache,
+                           const Handle<YieldTermStructure>& termStructure)
+    : LatticeShortRateModelEngine<CallableBond::arguments,
+                                  CallableBond::results>(cache),
+      termStructure_(termStructure) {
+        registerWith(termStructure_);
+    }
+
     void TreeCallableFixedRateBondEngine::calculate() const {
         QL_REQUIRE(!model_.empty(), "no model specified");
 
@@ -50,6 +50,10 @@ namespace QuantLib {
                            const TimeGrid& timeGrid,
                            const Handle<YieldTermStructure>& termStructure =
                                                  Handle<YieldTermStructure>()) ;
+        TreeCallableFixedRateBondEngine(
+                           const boost::shared_ptr<ShortRateTreeCache>&,
+                           const Handle<YieldTermStructure>& termStructure =
+                                                 Handle<YieldTermStructure>());
         //@}
         void calculate() const;
       private:
@@ -75,6 +79,12 @@ namespace QuantLib {
                            const Handle<YieldTermStructure>& termStructure =
                                                  Handle<YieldTermStructure>())
         : TreeCallableFixedRateBondEngine(model, timeGrid, termStructure) {}
+
+        TreeCallableZeroCouponBondEngine(
+                           const boost::shared_ptr<ShortRateTreeCache>& cache,
+                           const Handle<YieldTermStructure>& termStructure =
+                                                 Handle<YieldTermStructure>())
+        : TreeCallableFixedRateBondEngine(cache, termStructure) {}
     };
 
 }
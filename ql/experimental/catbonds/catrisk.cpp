@@ -19,7 +19,10 @@
 
 #include <ql/experimental/catbonds/catrisk.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
+#include <ql/utilities/dataparsers.hpp>
 #include <boost/make_shared.hpp>
+#include <fstream>
+#include <sstream>
 
 namespace QuantLib {
 
@@ -27,6 +30,42 @@ namespace QuantLib {
         Integer round(Real r) {
             return (r > 0.0) ? Integer(std::floor(r + 0.5)) : Integer(std::ceil(r - 0.5));
         }
+
+        class VectorEventReader : public EventReader {
+          public:
+            VectorEventReader(boost::shared_ptr<std::vector<std::pair<Date, Real> > > events)
+            : events_(events), i_(0) {}
+            bool next(std::pair<Date, Real>& event) {
+                if (i_ >= events_->size())
+                    return false;
+                event = (*events_)[i_++];
+                return true;
+            }
+          private:
+            boost::shared_ptr<std::vector<std::pair<Date, Real> > > events_;
+            Size i_;
+        };
+    }
+
+    StreamEventReader::StreamEventReader(const boost::shared_ptr<std::istream>& stream)
+    : stream_(stream) {
+        QL_REQUIRE(stream_ && *stream_, "invalid event stream");
+    }
+
+    bool StreamEventReader::next(std::pair<Date, Real>& event) {
+        std::string line;
+        while (std::getline(*stream_, line)) {
+            std::istringstream fields(line);
+            std::string date;
+            if (!(fields >> date) || date[0] == '#')
+                continue;
+            Real loss;
+            QL_REQUIRE(fields >> loss, "no loss given in event \"" << line << "\"");
+            event = std::make_pair(DateParser::parseISO(date), loss);
+            return true;
+        }
+        QL_REQUIRE(stream_->eof(), "error reading event stream");
+        return false;
     }
 
     EventSetSimulation::EventSetSimulation(boost::shared_ptr<std::vector<std::pair<Date, Real> > > events, 
@@ -34,7 +73,21 @@ namespace QuantLib {
                                            Date eventsEnd, 
                                            Date start, 
                                            Date end) 
-    : CatSimulation(start, end), events_(events), eventsStart_(eventsStart), eventsEnd_(eventsEnd), i_(0) {
+    : CatSimulation(start, end), events_(boost::make_shared<VectorEventReader>(events)), eventsStart_(eventsStart), eventsEnd_(eventsEnd), nextRead_(false) {
+        initialize();
+    }
+
+    EventSetSimulation::EventSetSimulation(boost::shared_ptr<EventReader> events, 
+                                           Date eventsStart, 
+                                           Date eventsEnd, 
+                                           Date start, 
+                                           Date end) 
+    : CatSimulation(start, end), events_(events), eventsStart_(eventsStart), eventsEnd_(eventsEnd), nextRead_(false) {
+        QL_REQUIRE(events_, "null event reader");
+        initialize();
+    }
+
+    void EventSetSimulation::initialize() {
         years_ = end_.year()-start_.year();
         if(eventsStart_.month()<start_.month() 
                             || (eventsStart_.month()==start_.month() 
@@ -44,7 +97,13 @@ namespace QuantLib {
             periodStart_ = Date(start_.dayOfMonth(), start_.month(), eventsStart_.year()+1);
         }
         periodEnd_ = Date(end_.dayOfMonth(), end_.month(), periodStart_.year()+years_);
-        while(i_<events_->size() && (*events_)[i_].first<periodStart_) ++i_; //i points to the first element after the start of the relevant period.
+        while(peek() && next_.first<periodStart_) nextRead_ = false; //next_ is the first element after the start of the relevant period.
+    }
+
+    bool EventSetSimulation::peek() {
+        if (!nextRead_)
+            nextRead_ = events_->next(next_);
+        return nextRead_;
     }
 
     bool EventSetSimulation::nextPath(std::vector< std::pair< Date, Real > >& path) {
@@ -52,13 +111,13 @@ namespace QuantLib {
         if(periodEnd_>eventsEnd_) //Ran out of event data 
             return false;
 
-        while(i_<events_->size() && (*events_)[i_].first<periodStart_) {
-            ++i_; //skip the elements between the previous period and this period
+        while(peek() && next_.first<periodStart_) {
+            nextRead_ = false; //skip the elements between the previous period and this period
         }
-        while(i_<events_->size()  && (*events_)[i_].first<=periodEnd_){
-            std::pair<Date, Real> e(events_->at(i_).first+(start_.year() - periodStart_.year())*Years, events_->at(i_).second);
+        while(peek() && next_.first<=periodEnd_){
+            std::pair<Date, Real> e(next_.first+(start_.year() - periodStart_.year())*Years, next_.second);
             path.push_back(e);
-            ++i_; //i points to the first element after the start of the relevant period.
+            nextRead_ = false; //next_ will be the first element after the start of the relevant period.
         }
         if(start_+years_*Years<end_) {
             periodStart_+=(years_+1)*Years;
@@ -79,6 +138,18 @@ namespace QuantLib {
         return boost::make_shared<EventSetSimulation>(events_, eventsStart_, eventsEnd_, start, end);
     }
 
+    EventFile::EventFile(const std::string& fileName, 
+                         Date eventsStart, 
+                         Date eventsEnd) 
+    : fileName_(fileName), eventsStart_(eventsStart), eventsEnd_(eventsEnd) {}
+
+    boost::shared_ptr<CatSimulation> EventFile::newSimulation(const Date& start, const Date& end) const{
+        boost::shared_ptr<std::istream> file(new std::ifstream(fileName_.c_str()));
+        QL_REQUIRE(*file, "unable to open event file " << fileName_);
+        boost::shared_ptr<EventReader> reader(new StreamEventReader(file));
+        return boost::make_shared<EventSetSimulation>(reader, eventsStart_, eventsEnd_, start, end);
+    }
+
     BetaRiskSimulation::BetaRiskSimulation(Date start, Date end, Real maxLoss, Real lambda, Real alpha, Real beta) 
               : CatSimulation(start, end), 
                 maxLoss_(maxLoss), 
@@ -35,6 +35,8 @@
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic pop
 #endif
+#include <istream>
+#include <string>
 #include <vector>
 
 namespace QuantLib {
@@ -59,20 +61,48 @@ namespace QuantLib {
         virtual boost::shared_ptr<CatSimulation> newSimulation(const Date& start, const Date& end) const = 0;
     };
 
+    //! sequential source of historical events, sorted by date
+    class EventReader {
+      public:
+        virtual ~EventReader() {}
+        //! reads the next event; returns false after the last one
+        virtual bool next(std::pair<Date, Real>& event) = 0;
+    };
+
+    //! reads events from a stream
+    /*! Each event is given as an ISO date (yyyy-mm-dd) followed by
+        the loss, separated by whitespace; lines starting with # are
+        skipped.  Events are read as needed, so that the catalog
+        doesn't need to be held in memory.
+    */
+    class StreamEventReader : public EventReader {
+      public:
+        explicit StreamEventReader(const boost::shared_ptr<std::istream>& stream);
+        virtual bool next(std::pair<Date, Real>& event);
+      private:
+        boost::shared_ptr<std::istream> stream_;
+    };
+
     class EventSetSimulation : public CatSimulation {
       public:
         EventSetSimulation(boost::shared_ptr<std::vector<std::pair<Date, Real> > > events, Date eventsStart, Date eventsEnd, Date start, Date end);
+        EventSetSimulation(boost::shared_ptr<EventReader> events, Date eventsStart, Date eventsEnd, Date start, Date end);
         virtual bool nextPath(std::vector<std::pair<Date, Real> > &path);
       
       private:
-        boost::shared_ptr<std::vector<std::pair<Date, Real> > > events_;
+        void initialize();
+        // reads the next event into next_ if needed; false at the end
+        bool peek();
+
+        boost::shared_ptr<EventReader> events_;
         Date eventsStart_;
         Date eventsEnd_;
 
         Year years_;
         Date periodStart_;
         Date periodEnd_;
-        unsigned int i_;
+        std::pair<Date, Real> next_;
+        bool nextRead_;
     };
 
     class EventSet : public CatRisk {        
@@ -88,6 +118,24 @@ namespace QuantLib {
         Date eventsEnd_;
     };
 
+    //! historical event set read from a file for each simulation
+    /*! The file is in the format read by StreamEventReader and is
+        streamed rather than loaded, so that large catalogs can be
+        used.
+    */
+    class EventFile : public CatRisk {
+      public:
+        EventFile(const std::string& fileName,
+                  Date eventsStart,
+                  Date eventsEnd);
+
+        boost::shared_ptr<CatSimulation> newSimulation(const Date& start, const Date& end) const;
+      private:
+        std::string fileName_;
+        Date eventsStart_;
+        Date eventsEnd_;
+    };
+
     class BetaRiskSimulation : public CatSimulation {
       public:
         BetaRiskSimulation(Date start, 
@@ -20,6 +20,8 @@
 #include <ql/experimental/catbonds/montecarlocatbondengine.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <algorithm>
+#include <map>
+#include <string>
 
 namespace QuantLib {
 
@@ -73,7 +75,6 @@ namespace QuantLib {
 
     Real MonteCarloCatBondEngine::npv(bool includeSettlementDateFlows, Date settlementDate, Date npvDate, Real& lossProbability, Real &exhaustionProbability, Real& expectedLoss) const
     {
-        const size_t MAX_PATHS = 10000; //TODO
         lossProbability =  0.0;
         exhaustionProbability = 0.0;
         expectedLoss = 0.0;
@@ -86,51 +87,177 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Real totalNPV = 0.0;
-        Date effectiveDate = std::max(arguments_.startDate, settlementDate);
-        Date maturityDate = (*arguments_.cashflows.rbegin())->date();
-        boost::shared_ptr<CatSimulation> catSimulation = catRisk_->newSimulation(effectiveDate, maturityDate);
-        std::vector<std::pair<Date, Real> > eventsPath;
-        NotionalPath notionalPath;
-        Real riskFreeNPV = pathNpv(includeSettlementDateFlows, settlementDate, notionalPath);
-        size_t pathCount=0;
-        while(catSimulation->nextPath(eventsPath) && pathCount<MAX_PATHS)
-        {
-            arguments_.notionalRisk->updatePath(eventsPath, notionalPath);
-            if(notionalPath.loss()>0) { //optimization, most paths will not include any loss
-                totalNPV += pathNpv(includeSettlementDateFlows, settlementDate, notionalPath);
-                lossProbability+=1;
-                if (notionalPath.loss()==1) 
-                    exhaustionProbability+=1;
-                expectedLoss+=notionalPath.loss();
-            } else {
-                totalNPV += riskFreeNPV;
+        std::vector<RiskyFlows> flows(1, riskyFlows(arguments_, includeSettlementDateFlows, settlementDate));
+        simulate(flows);
+        lossProbability = flows[0].lossProbability;
+        exhaustionProbability = flows[0].exhaustionProbability;
+        expectedLoss = flows[0].expectedLoss;
+        return flows[0].npv/discountCurve_->discount(npvDate);
+    }
+
+    MonteCarloCatBondEngine::RiskyFlows MonteCarloCatBondEngine::riskyFlows(
+                                     const CatBond::arguments& arguments,
+                                     bool includeSettlementDateFlows,
+                                     Date settlementDate) const {
+        RiskyFlows flows;
+        flows.notionalRisk = arguments.notionalRisk;
+        flows.start = std::max(arguments.startDate, settlementDate);
+        flows.end = (*arguments.cashflows.rbegin())->date();
+        flows.riskFreeNpv = 0.0;
+        // amounts and discounts don't depend on the path and are
+        // calculated once, before the simulation
+        for (Size i=0; i<arguments.cashflows.size(); ++i) {
+            const boost::shared_ptr<CashFlow>& cf = arguments.cashflows[i];
+            if (!cf->hasOccurred(settlementDate, includeSettlementDateFlows)) {
+                Real amount = cf->amount()*discountCurve_->discount(cf->date()); //TODO: fix for more complicated cashflows
+                flows.dates.push_back(cf->date());
+                flows.discountedAmounts.push_back(amount);
+                flows.riskFreeNpv += amount;
             }
-            pathCount++;
         }
-        lossProbability/=pathCount;
-        exhaustionProbability/=pathCount;
-        expectedLoss/=pathCount;
-        return totalNPV/(pathCount*discountCurve_->discount(npvDate));
+        return flows;
     }
 
-    Real MonteCarloCatBondEngine::pathNpv(bool includeSettlementDateFlows, 
-                                          Date settlementDate, 
-                                          const NotionalPath& notionalPath) const {
-        Real totalNPV = 0.0;
-        for (Size i=0; i<arguments_.cashflows.size(); ++i) {
-            if (!arguments_.cashflows[i]->hasOccurred(settlementDate, 
-                                        includeSettlementDateFlows)) {
-                Real amount = cashFlowRiskyValue(arguments_.cashflows[i], notionalPath);
-                totalNPV += amount * discountCurve_->discount(arguments_.cashflows[i]->date());
+    void MonteCarloCatBondEngine::simulate(std::vector<RiskyFlows>& flows) const {
+        const Size MAX_PATHS = 10000; //TODO
+        const Size BLOCK_SIZE = 1024;
+        const Size n = flows.size();
+
+        // all flows see the same events
+        Date start = flows[0].start, end = flows[0].end;
+        for (Size j=0; j<n; ++j) {
+            QL_REQUIRE(flows[j].start == start && flows[j].end == end,
+                       "flows with different risk periods");
+            flows[j].npv = flows[j].lossProbability = 0.0;
+            flows[j].exhaustionProbability = flows[j].expectedLoss = 0.0;
+        }
+
+        boost::shared_ptr<CatSimulation> catSimulation = catRisk_->newSimulation(start, end);
+        std::vector<std::vector<std::pair<Date, Real> > > eventsPaths(BLOCK_SIZE);
+        std::vector<Real> values(BLOCK_SIZE*n), losses(BLOCK_SIZE*n);
+        std::vector<std::string> errors(BLOCK_SIZE);
+        Size pathCount = 0;
+        bool morePaths = true;
+        while (morePaths && pathCount<MAX_PATHS) {
+            // the paths are simulated sequentially...
+            Size block = 0;
+            while (block<BLOCK_SIZE && pathCount+block<MAX_PATHS) {
+                if (!catSimulation->nextPath(eventsPaths[block])) {
+                    morePaths = false;
+                    break;
+                }
+                ++block;
+            }
+
+            // ...and evaluated in parallel
+            #pragma omp parallel for
+            for (long i=0; i<long(block); ++i) {
+                try {
+                    NotionalPath notionalPath;
+                    for (Size j=0; j<n; ++j) {
+                        const RiskyFlows& f = flows[j];
+                        f.notionalRisk->updatePath(eventsPaths[i], notionalPath);
+                        Real loss = notionalPath.loss();
+                        Real value = f.riskFreeNpv;
+                        if (loss>0) { //optimization, most paths will not include any loss
+                            value = 0.0;
+                            for (Size k=0; k<f.dates.size(); ++k)
+                                value += f.discountedAmounts[k]*notionalPath.notionalRate(f.dates[k]);
+                        }
+                        values[i*n+j] = value;
+                        losses[i*n+j] = loss;
+                    }
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                }
+            }
+
+            // results are accumulated in order, so that they don't
+            // depend on the number of threads
+            for (Size i=0; i<block; ++i) {
+                QL_REQUIRE(errors[i].empty(), errors[i]);
+                for (Size j=0; j<n; ++j) {
+                    Real loss = losses[i*n+j];
+                    flows[j].npv += values[i*n+j];
+                    if (loss>0) {
+                        flows[j].lossProbability+=1;
+                        if (loss==1)
+                            flows[j].exhaustionProbability+=1;
+                        flows[j].expectedLoss+=loss;
+                    }
+                }
             }
+            pathCount += block;
+        }
+
+        for (Size j=0; j<n; ++j) {
+            flows[j].npv/=pathCount;
+            flows[j].lossProbability/=pathCount;
+            flows[j].exhaustionProbability/=pathCount;
+            flows[j].expectedLoss/=pathCount;
         }
-        return totalNPV;
     }
 
-    Real MonteCarloCatBondEngine::cashFlowRiskyValue(const boost::shared_ptr<CashFlow> cf, 
-                                                     const NotionalPath& notionalPath) const {
-        return cf->amount()*notionalPath.notionalRate(cf->date()); //TODO: fix for more complicated cashflows
+    std::vector<CatBond::results> MonteCarloCatBondEngine::portfolioResults(
+                    const std::vector<boost::shared_ptr<CatBond> >& bonds) const {
+        QL_REQUIRE(!discountCurve_.empty(),
+                   "discounting term structure handle is empty");
+
+        Date valuationDate = (*discountCurve_)->referenceDate();
+        bool includeRefDateFlows =
+            includeSettlementDateFlows_ ?
+            *includeSettlementDateFlows_ :
+            Settings::instance().includeReferenceDateEvents();
+
+        // each bond is valued as of the valuation date and of its
+        // settlement date, as in calculate(); flows with the same
+        // risk period are simulated together on the same events
+        std::vector<CatBond::results> results(bonds.size());
+        std::vector<Date> settlementDates(bonds.size());
+        std::vector<RiskyFlows> flows;
+        std::vector<Size> index(bonds.size(), Null<Size>());
+        typedef std::map<std::pair<Date, Date>, std::vector<Size> > Groups;
+        Groups groups;
+        for (Size i=0; i<bonds.size(); ++i) {
+            CatBond::arguments arguments;
+            bonds[i]->setupArguments(&arguments);
+            arguments.validate();
+            results[i].reset();
+            results[i].valuationDate = valuationDate;
+            results[i].value = results[i].settlementValue = 0.0;
+            results[i].lossProbability = results[i].exhaustionProbability = results[i].expectedLoss = 0.0;
+            settlementDates[i] = arguments.settlementDate;
+            if (arguments.cashflows.empty())
+                continue;
+            index[i] = flows.size();
+            flows.push_back(riskyFlows(arguments, includeRefDateFlows, valuationDate));
+            flows.push_back(riskyFlows(arguments, includeRefDateFlows, arguments.settlementDate));
+            for (Size j=index[i]; j<flows.size(); ++j)
+                groups[std::make_pair(flows[j].start,
+                                      flows[j].end)].push_back(j);
+        }
+
+        for (Groups::const_iterator g=groups.begin(); g!=groups.end(); ++g) {
+            const std::vector<Size>& members = g->second;
+            std::vector<RiskyFlows> group(members.size());
+            for (Size j=0; j<members.size(); ++j)
+                group[j] = flows[members[j]];
+            simulate(group);
+            for (Size j=0; j<members.size(); ++j)
+                flows[members[j]] = group[j];
+        }
+
+        for (Size i=0; i<bonds.size(); ++i) {
+            if (index[i] == Null<Size>())
+                continue;
+            const RiskyFlows& value = flows[index[i]];
+            results[i].value = value.npv/discountCurve_->discount(valuationDate);
+            results[i].settlementValue = flows[index[i]+1].npv/discountCurve_->discount(settlementDates[i]);
+            results[i].lossProbability = value.lossProbability;
+            results[i].exhaustionProbability = value.exhaustionProbability;
+            results[i].expectedLoss = value.expectedLoss;
+        }
+        return results;
     }
 
 }
@@ -28,6 +28,19 @@
 
 namespace QuantLib {
 
+    //! Monte Carlo pricing engine for cat bonds
+    /*! Event paths are simulated sequentially in blocks; the paths
+        of each block are then applied to the notional risk and the
+        bond is valued on each of them in parallel, when OpenMP is
+        enabled.  Results don't depend on the number of threads.
+
+        Several cat bonds sharing the same catastrophe risk can be
+        priced together, with one pass over the simulated events for
+        each distinct risk period; see portfolioResults().
+
+        \warning The notional risk (and its payment offset) of the
+                 priced bonds must be safe to use from several threads.
+    */
     class MonteCarloCatBondEngine :
         public CatBond::engine
     {
@@ -41,9 +54,33 @@ namespace QuantLib {
         Handle<YieldTermStructure> discountCurve() const {
             return discountCurve_;
         }
+        /*! prices the given bonds on shared simulated events.  The
+            events are simulated once for each distinct risk period
+            of the bonds, as seen from the valuation date and from
+            their settlement dates, and all the bonds with that
+            period are valued on them.  Each bond is thus priced on
+            the same paths it would be priced on by calculate(),
+            also when its risk period has already started.
+        */
+        std::vector<CatBond::results> portfolioResults(
+                    const std::vector<boost::shared_ptr<CatBond> >& bonds) const;
     protected:
-        Real cashFlowRiskyValue(const boost::shared_ptr<CashFlow> cf, 
-                                const NotionalPath& notionalPath) const;
+        // bond flows still to be paid, with their discounts, and the
+        // corresponding simulation results
+        struct RiskyFlows {
+            boost::shared_ptr<NotionalRisk> notionalRisk;
+            Date start, end;
+            std::vector<Date> dates;
+            std::vector<Real> discountedAmounts;
+            Real riskFreeNpv;
+            Real npv, lossProbability, exhaustionProbability, expectedLoss;
+        };
+
+        RiskyFlows riskyFlows(const CatBond::arguments& arguments,
+                              bool includeSettlementDateFlows,
+                              Date settlementDate) const;
+
+        void simulate(std::vector<RiskyFlows>& flows) const;
 
         Real npv(bool includeSettlementDateFlows, 
                  Date settlementDate, 
@@ -51,10 +88,6 @@ namespace QuantLib {
                  Real& lossProbability, 
                  Real& exhaustionProbability, 
                  Real& expectedLoss) const;
-
-        Real pathNpv(bool includeSettlementDateFlows, 
-                     Date settlementDate, 
-                     const NotionalPath& notionalPath) const;
       private:
         boost::shared_ptr<CatRisk> catRisk_;
         Handle<YieldTermStructure> discountCurve_;
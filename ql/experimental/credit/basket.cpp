@@ -123,10 +123,11 @@ namespace QuantLib {
         QL_REQUIRE(endDate >= refDate_, 
             "Target date lies before basket inception");
         Real loss = 0.0;
+        vector<DefaultProbKey> defKeys = defaultKeys();
         for (Size i = 0; i < size(); i++) {
             boost::shared_ptr<DefaultEvent> credEvent =
                 pool_->get(pool_->names()[i]).defaultedBetween(refDate_,
-                    endDate, pool_->defaultKeys()[i]);
+                    endDate, defKeys[i]);
             if (credEvent) {
                 /* \todo If the event has not settled one would need to 
                 introduce some model recovery rate (independently of a loss 
@@ -137,7 +138,7 @@ namespace QuantLib {
                             // notionals_[i],
                             exposure(pool_->names()[i], credEvent->date()),
                             credEvent->settlement().recoveryRate(
-                                pool_->defaultKeys()[i].seniority()));
+                                defKeys[i].seniority()));
             }
         }
         return loss;
@@ -148,10 +149,11 @@ namespace QuantLib {
             "Target date lies before basket inception");
         
         Real loss = 0.0;
+        vector<DefaultProbKey> defKeys = defaultKeys();
         for (Size i = 0; i < size(); i++) {
             boost::shared_ptr<DefaultEvent> credEvent =
                 pool_->get(pool_->names()[i]).defaultedBetween(refDate_,
-                    endDate, pool_->defaultKeys()[i]);
+                    endDate, defKeys[i]);
             if (credEvent) {
                 if(credEvent->hasSettled()) {
                     loss += claim_->amount(credEvent->date(),
@@ -161,7 +163,7 @@ namespace QuantLib {
                             /* also the seniority does not belong to the 
                             counterparty anymore but to the position.....*/
                             credEvent->settlement().recoveryRate(
-                                pool_->defaultKeys()[i].seniority()));
+                                defKeys[i].seniority()));
                 }
             }
         }
@@ -175,11 +177,12 @@ namespace QuantLib {
     Disposable<std::vector<Size> > 
         Basket::liveList(const Date& endDate) const {
         std::vector<Size> calcBufferLiveList;
+        vector<DefaultProbKey> defKeys = defaultKeys();
         for (Size i = 0; i < size(); i++)
             if (!pool_->get(pool_->names()[i]).defaultedBetween(
                     refDate_,
                     endDate,
-                    pool_->defaultKeys()[i]))
+                    defKeys[i]))
                 calcBufferLiveList.push_back(i);
 
         return calcBufferLiveList;
@@ -218,10 +221,11 @@ namespace QuantLib {
         QL_REQUIRE(d >= refDate_, "Target date lies before basket inception");
         vector<Real> prob;
         const std::vector<Size>& alive = liveList();
+        vector<DefaultProbKey> defKeys = defaultKeys();
 
         for(Size i=0; i<alive.size(); i++)
             prob.push_back(pool_->get(pool_->names()[i]).defaultProbability(
-                pool_->defaultKeys()[i])->defaultProbability(d, true));
+                defKeys[i])->defaultProbability(d, true));
         return prob;
     }
 
@@ -271,9 +275,9 @@ namespace QuantLib {
             "Target date lies before basket inception");
 
         const std::vector<Size>& alive = liveList(endDate);
-        vector<DefaultProbKey> defKeys;
+        vector<DefaultProbKey> allKeys = defaultKeys(), defKeys;
         for(Size i=0; i<alive.size(); i++)
-            defKeys.push_back(pool_->defaultKeys()[alive[i]]);
+            defKeys.push_back(allKeys[alive[i]]);
         return defKeys;
     }
 
@@ -51,6 +51,7 @@ namespace QuantLib {
         using LatentModel<copulaPolicy>::inverseCumulativeY;
         using LatentModel<copulaPolicy>::cumulativeZ;
         using LatentModel<copulaPolicy>::integratedExpectedValue;// which one?
+        using LatentModel<copulaPolicy>::integratedExpectedValueOnBlocks;
     protected:
         // not a handle, the model doesnt keep any cached magnitudes, no need 
         //  for notifications, still...
@@ -160,6 +161,24 @@ namespace QuantLib {
         
             return res;
         }
+        /*! Conditional default probabilities of a given name for each of
+        a block of values of the LM independent factors; same as the
+        method above, for integrations on blocks.
+        */
+        Disposable<std::vector<Probability> > 
+            conditionalDefaultProbabilitiesInvP(Real invCumYProb, 
+            Size iName, 
+            const std::vector<std::vector<Real> >& block) const {
+            std::vector<Probability> res(block.size());
+            const std::vector<Real>& weights = factorWeights_[iName];
+            for (Size i=0; i<block.size(); ++i) {
+                Real sumMs = std::inner_product(weights.begin(), 
+                    weights.end(), block[i].begin(), 0.);
+                res[i] = cumulativeZ((invCumYProb - sumMs) / 
+                    idiosyncFctrs_[iName]);
+            }
+            return res;
+        }
     protected:
         /*! Returns the probability of default of a given name conditional on
         the realization of a given set of values of the model independent
@@ -194,6 +213,21 @@ namespace QuantLib {
                 conditionalDefaultProbabilityInvP(invCumYProb2, iName2, 
                     mktFactors);
         }
+        //! Conditional default probability products on a block of factors.
+        Disposable<std::vector<Probability> > condProbProducts(
+            Real invCumYProb1, Real invCumYProb2, 
+            Size iName1, Size iName2, 
+            const std::vector<std::vector<Real> >& block) const {
+            std::vector<Probability> res =
+                conditionalDefaultProbabilitiesInvP(invCumYProb1, iName1, 
+                    block);
+            std::vector<Probability> p2 =
+                conditionalDefaultProbabilitiesInvP(invCumYProb2, iName2, 
+                    block);
+            for (Size i=0; i<res.size(); ++i)
+                res[i] *= p2[i];
+            return res;
+        }
         //! Conditional probability of n default events or more.
         // \todo: check the issuer has not defaulted.
         Real conditionalProbAtLeastNEvents(Size n, const Date& date,
@@ -213,14 +247,25 @@ namespace QuantLib {
                 defaultProbability(basket_->defaultKeys()[iName])
                 ->defaultProbability(d);
             if (pUncond < 1.e-10) return 0.;
+            Real invP = inverseCumulativeY(pUncond, iName);
 
-            return integratedExpectedValue(
+            return integratedExpectedValueOnBlocks(
+              boost::function<Disposable<std::vector<Real> > (
+                const std::vector<std::vector<Real> >& block)>(
+                boost::bind(
+                &DefaultLatentModel<copulaPolicy>
+                    ::conditionalDefaultProbabilitiesInvP,
+                this,
+                invP,
+                iName, 
+                _1)
+              ),
               boost::function<Real (const std::vector<Real>& v1)>(
                 boost::bind(
                 &DefaultLatentModel<copulaPolicy>
                     ::conditionalDefaultProbabilityInvP,
                 this,
-                inverseCumulativeY(pUncond, iName),
+                invP,
                 iName, 
                 _1)
               ));
@@ -272,7 +317,12 @@ namespace QuantLib {
         // avoid repetitive calls when i=j?
         Real E1i1j; // joint default covariance term
         if(iNamei !=iNamej) {
-            E1i1j = integratedExpectedValue(
+            E1i1j = integratedExpectedValueOnBlocks(
+              boost::function<Disposable<std::vector<Real> > (
+                const std::vector<std::vector<Real> >& block)>(
+                boost::bind(
+                &DefaultLatentModel<CP>::condProbProducts,
+                this, invPi, invPj, iNamei, iNamej, _1) ),
               boost::function<Real (const std::vector<Real>& v1)>(
                 boost::bind(
                 &DefaultLatentModel<CP>::condProbProduct,
@@ -0,0 +1,325 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fftlossmodel.hpp
+    \brief Loss distribution of heterogeneous pools by Fourier inversion
+*/
+
+#ifndef quantlib_fft_loss_model_hpp
+#define quantlib_fft_loss_model_hpp
+
+#include <ql/experimental/credit/basket.hpp>
+#include <ql/experimental/credit/constantlosslatentmodel.hpp>
+#include <ql/experimental/credit/defaultlossmodel.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+#include <complex>
+#include <map>
+
+namespace QuantLib {
+
+    //! Default loss model for heterogeneous pools using Fourier inversion
+    /*! Losses are measured in units of the total loss given default
+        of the remaining pool divided by the number of buckets, and
+        the loss given default of each name is rounded to the closest
+        multiple of the unit.  Conditional on the value of the market
+        factor, names default independently and the characteristic
+        function of the pool loss on the lattice is the product of
+        those of the single names:
+        \f[
+            \phi(k|m) = \prod_i \left( 1 - p_i(m) + p_i(m)\,
+                        \omega^{k w_i} \right),
+            \qquad \omega = e^{-2\pi i/M}
+        \f]
+        where \f$ w_i \f$ is the loss of the i-th name in units and
+        \f$ M \f$ is the smallest power of two above the number of
+        attainable losses.  The conditional characteristic functions
+        are integrated over the market factor with the same midpoint
+        rule used by InhomogeneousPoolLossModel and the unconditional
+        loss distribution is obtained with a single inverse FFT.  The
+        cost is proportional to names \f$ \times M \f$ for each node
+        of the factor, instead of names \f$ \times \f$ buckets for the
+        recursion in RecursiveLossModel; when OpenMP is enabled, the
+        nodes are evaluated in parallel.
+
+        With the compound-Poisson approximation, each name is
+        replaced by a Poisson number of losses of the same size with
+        intensity \f$ \lambda_i = p_i(m) \f$, so that the expected
+        loss is preserved; the characteristic function is then
+        \f$ \exp(\hat\Lambda(k|m) - \sum_i \lambda_i) \f$, where
+        \f$ \hat\Lambda \f$ is the transform of the intensities
+        aggregated by loss size, and costs a single FFT per node.  The
+        approximation overestimates the tail of the distribution and
+        should be used only when the conditional default
+        probabilities are small.
+
+        \warning Names whose loss given default is less than half a
+                 unit don't contribute to the loss.
+
+        \test expected tranche losses are checked against those of
+              RecursiveLossModel on the same lattice.
+        \todo Extend to the multifactor case for a generic LM
+    */
+    template<class copulaPolicy>
+    class FFTLossModel : public DefaultLossModel {
+      public:
+        typedef copulaPolicy copulaType;
+        enum Method { Exact, CompoundPoisson };
+
+        FFTLossModel(
+            const boost::shared_ptr<ConstantLossLatentmodel<copulaPolicy> >&
+                copula,
+            Size nBuckets,
+            Real max = 5.,
+            Real min = -5.,
+            Size nSteps = 50,
+            Method method = Exact)
+        : copula_(copula), nBuckets_(nBuckets), max_(max), min_(min),
+          nSteps_(nSteps), delta_((max - min)/nSteps), method_(method) {
+            QL_REQUIRE(copula->numFactors() == 1,
+                "FFT loss model not implemented for multifactor");
+            QL_REQUIRE(nBuckets_ > 0, "number of buckets must be positive");
+            QL_REQUIRE(nSteps_ > 0, "number of steps must be positive");
+        }
+        Real expectedTrancheLoss(const Date& d) const;
+        Real percentile(const Date& d, Real percentile) const;
+        Real expectedShortfall(const Date& d, Probability percentile) const;
+        /*! returns the cumulative probability of each attainable loss
+            amount on the lattice. */
+        Disposable<std::map<Real, Probability> > lossDistribution(
+                                                        const Date& d) const;
+        //! probability of each multiple of the loss unit
+        Disposable<std::vector<Probability> > lossProbability(
+                                                        const Date& d) const;
+        //! the loss amount corresponding to one unit of the lattice
+        Real lossUnit() const { return lossUnit_; }
+      protected:
+        const boost::shared_ptr<ConstantLossLatentmodel<copulaPolicy> > copula_;
+      private:
+        void resetModel();
+        void conditionalCharacteristicFunction(
+                              const std::vector<Real>& invProb,
+                              const std::vector<Real>& mktFactor,
+                              std::vector<std::complex<Real> >& phi) const;
+        Real trancheLoss(Size j) const {
+            return std::min(std::max(j*lossUnit_ - attachAmount_, 0.),
+                            detachAmount_ - attachAmount_);
+        }
+
+        Size nBuckets_;
+        const Real max_, min_;
+        const Size nSteps_;
+        const Real delta_;
+        Method method_;
+        // cached remaining basket magnitudes and lattice
+        Real attachAmount_, detachAmount_, lossUnit_;
+        std::vector<Size> weights_;
+        Size order_;
+        std::vector<std::complex<Real> > roots_;
+    };
+
+    typedef FFTLossModel<GaussianCopulaPolicy> FFTGaussLossModel;
+    typedef FFTLossModel<TCopulaPolicy> FFTStudentLossModel;
+
+    // -------------------------------------------------------------------
+
+    template<class CP>
+    void FFTLossModel<CP>::resetModel() {
+        attachAmount_ = basket_->remainingAttachmentAmount();
+        detachAmount_ = basket_->remainingDetachmentAmount();
+        std::vector<Real> notionals = basket_->remainingNotionals();
+
+        copula_->resetBasket(basket_.currentLink());
+
+        const std::vector<Real>& recoveries = copula_->recoveries();
+        std::vector<Real> lgds(notionals.size());
+        Real totalLgd = 0.0;
+        for (Size i=0; i<notionals.size(); ++i) {
+            lgds[i] = notionals[i]*(1.0-recoveries[i]);
+            totalLgd += lgds[i];
+        }
+        QL_REQUIRE(totalLgd > 0.0, "null loss given default for the pool");
+        lossUnit_ = totalLgd/nBuckets_;
+
+        weights_.resize(lgds.size());
+        Size maxLoss = 0;
+        for (Size i=0; i<lgds.size(); ++i) {
+            weights_[i] = static_cast<Size>(std::floor(lgds[i]/lossUnit_+0.5));
+            maxLoss += weights_[i];
+        }
+        // the lattice must hold all attainable losses to avoid
+        // aliasing; the compound-Poisson distribution is unbounded
+        // and is given room for its tail.
+        order_ = std::max<Size>(FastFourierTransform::min_order(maxLoss+1),
+                                1);
+        if (method_ == CompoundPoisson)
+            ++order_;
+        Size M = Size(1) << order_;
+        roots_.resize(M);
+        for (Size n=0; n<M; ++n)
+            roots_[n] = std::complex<Real>(std::cos(2.0*M_PI*n/M),
+                                           -std::sin(2.0*M_PI*n/M));
+    }
+
+    template<class CP>
+    void FFTLossModel<CP>::conditionalCharacteristicFunction(
+                              const std::vector<Real>& invProb,
+                              const std::vector<Real>& mktFactor,
+                              std::vector<std::complex<Real> >& phi) const {
+        const Size M = roots_.size();
+        phi.assign(M/2+1, std::complex<Real>(1.0));
+        if (method_ == Exact) {
+            for (Size i=0; i<weights_.size(); ++i) {
+                Probability p = copula_->conditionalDefaultProbabilityInvP(
+                                                 invProb[i], i, mktFactor);
+                if (p == 0.0 || weights_[i] == 0)
+                    continue;
+                // k*w_i mod M is updated incrementally
+                Size n = 0;
+                for (Size k=0; k<=M/2; ++k) {
+                    phi[k] *= (1.0-p) + p*roots_[n];
+                    n = (n + weights_[i]) & (M-1);
+                }
+            }
+        } else {
+            std::vector<Real> intensities(M, 0.0);
+            Real totalIntensity = 0.0;
+            for (Size i=0; i<weights_.size(); ++i) {
+                if (weights_[i] == 0)
+                    continue;
+                Real lambda = copula_->conditionalDefaultProbabilityInvP(
+                                                 invProb[i], i, mktFactor);
+                intensities[weights_[i]] += lambda;
+                totalIntensity += lambda;
+            }
+            std::vector<std::complex<Real> > transformed(M);
+            FastFourierTransform fft(order_);
+            fft.transform(intensities.begin(), intensities.end(),
+                          transformed.begin());
+            for (Size k=0; k<=M/2; ++k)
+                phi[k] = std::exp(transformed[k] - totalIntensity);
+        }
+    }
+
+    template<class CP>
+    Disposable<std::vector<Probability> >
+    FFTLossModel<CP>::lossProbability(const Date& d) const {
+        const Size M = roots_.size();
+        std::vector<Real> invProb = basket_->remainingProbabilities(d);
+        for (Size iName=0; iName<invProb.size(); ++iName)
+            invProb[iName] =
+                copula_->inverseCumulativeY(invProb[iName], iName);
+
+        // the integrand is evaluated on each node independently...
+        std::vector<std::vector<std::complex<Real> > > phis(nSteps_);
+        std::vector<Real> nodeWeights(nSteps_);
+        std::vector<std::string> errors(nSteps_);
+        #pragma omp parallel for
+        for (long i=0; i<long(nSteps_); ++i) {
+            try {
+                std::vector<Real> mkft(1, min_ + delta_*(i+0.5));
+                nodeWeights[i] = delta_ * copula_->density(mkft);
+                conditionalCharacteristicFunction(invProb, mkft, phis[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+        for (Size i=0; i<nSteps_; ++i)
+            QL_REQUIRE(errors[i].empty(), errors[i]);
+
+        // ...and the results are summed in order, so that they don't
+        // depend on the number of threads.
+        std::vector<std::complex<Real> > phi(M, std::complex<Real>(0.0));
+        Real totalWeight = 0.0;
+        for (Size i=0; i<nSteps_; ++i) {
+            for (Size k=0; k<=M/2; ++k)
+                phi[k] += nodeWeights[i]*phis[i][k];
+            totalWeight += nodeWeights[i];
+        }
+        // the distribution is real
+        for (Size k=M/2+1; k<M; ++k)
+            phi[k] = std::conj(phi[M-k]);
+
+        std::vector<std::complex<Real> > density(M);
+        FastFourierTransform fft(order_);
+        fft.inverse_transform(phi.begin(), phi.end(), density.begin());
+        // the midpoint rule is normalized so that probabilities sum to 1
+        std::vector<Probability> result(M);
+        for (Size j=0; j<M; ++j)
+            result[j] = std::max(density[j].real()/(M*totalWeight), 0.0);
+        return result;
+    }
+
+    template<class CP>
+    Disposable<std::map<Real, Probability> >
+    FFTLossModel<CP>::lossDistribution(const Date& d) const {
+        std::vector<Probability> probs = lossProbability(d);
+        std::map<Real, Probability> distrib;
+        Probability sum = 0.0;
+        for (Size j=0; j<probs.size(); ++j) {
+            sum += probs[j];
+            distrib.insert(std::make_pair(j*lossUnit_, sum));
+        }
+        return distrib;
+    }
+
+    template<class CP>
+    Real FFTLossModel<CP>::expectedTrancheLoss(const Date& d) const {
+        std::vector<Probability> probs = lossProbability(d);
+        Real expectedLoss = 0.0;
+        for (Size j=0; j<probs.size(); ++j)
+            expectedLoss += trancheLoss(j)*probs[j];
+        return expectedLoss;
+    }
+
+    template<class CP>
+    Real FFTLossModel<CP>::percentile(const Date& d, Real percentile) const {
+        QL_REQUIRE(percentile >= 0.0 && percentile <= 1.0,
+                   "percentile (" << percentile << ") out of range");
+        std::vector<Probability> probs = lossProbability(d);
+        Probability sum = 0.0;
+        Size j = 0;
+        for (; j<probs.size()-1; ++j) {
+            sum += probs[j];
+            if (sum >= percentile)
+                break;
+        }
+        return trancheLoss(j);
+    }
+
+    template<class CP>
+    Real FFTLossModel<CP>::expectedShortfall(const Date& d,
+                                             Probability percentile) const {
+        QL_REQUIRE(percentile >= 0.0 && percentile < 1.0,
+                   "percentile (" << percentile << ") out of range");
+        std::vector<Probability> probs = lossProbability(d);
+        // losses below the percentile are discarded; the atom at the
+        // percentile is included in part if needed.
+        Probability sum = 0.0;
+        Real tail = 0.0;
+        for (Size j=0; j<probs.size(); ++j) {
+            Probability next = sum + probs[j];
+            if (next > percentile)
+                tail += trancheLoss(j) *
+                    (next - std::max<Real>(sum, percentile));
+            sum = next;
+        }
+        return tail/(1.0-percentile);
+    }
+
+}
+
+#endif
@@ -110,7 +110,11 @@ namespace QuantLib {
           nSims_(nSims), copula_(copula) {}
 
         void update() {
-            simsBuffer_.clear();
+            simsOffsets_.clear();
+            eventNames_.clear();
+            eventDays_.clear();
+            eventLosses_.clear();
+            scannedDate_ = Date();
             // tell basket to notify instruments, etc, we are invalid
             if(!basket_.empty()) basket_->notifyObservers();
             LazyObject::update();
@@ -123,25 +127,21 @@ namespace QuantLib {
             performSimulations();
         }
 
-        void performSimulations() const {
-            // Next sequence should determine the event and push it into buffer
-            for(Size i=nSims_; i; i--) {
-                const std::vector<Real>& sample =
-                    copulasRng_->nextSequence().value;
-                static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                    this)->nextSample(sample);
-            // alternatively make call an explicit local method...
-            }
-        }
+        /* Samples are drawn sequentially, in blocks, from the single
+        generator so that results do not depend on the number of threads;
+        the events generated by each sample of a block (the expensive part,
+        involving the default time inversions) are then computed in parallel
+        when OpenMP is enabled. Derived classes' nextSample must therefore be
+        thread safe.
+        */
+        void performSimulations() const;
 
-        /* Method to access simulation results and avoiding a copy of
-        each thread results buffer. PerformCalculations should have been called.
-        Here in the monothread version this method is redundant/trivial but
-        serves to detach the statistics access to the way the simulations are
-        stored.
+        /* Computes the portfolio loss and number of defaults of each
+        simulation up to the given date in a single pass over the stored
+        events. The results are kept until a different date is requested, so
+        that the statistics for the same date share the pass.
         */
-        const std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >&
-            getSim(const Size iSim) const { return simsBuffer_[iSim]; }
+        void scanSimulations(const Date& d) const;
 
         /* Allows statistics to be written generically for fixed and random
         recovery rates. */
@@ -212,18 +212,115 @@ namespace QuantLib {
 
         const Size nSims_;
 
-        mutable std::vector<std::vector<simEvent<derivedRandomLM<copulaPolicy,
-            USNG > > > > simsBuffer_;
+        /* Simulation results, stored by columns; the events of the i-th
+        simulation are those in [simsOffsets_[i], simsOffsets_[i+1]). The
+        loss of each event (exposure times loss given default) is stored
+        instead of its recovery.
+        */
+        mutable std::vector<Size> simsOffsets_;
+        mutable std::vector<unsigned short> eventNames_;
+        mutable std::vector<unsigned short> eventDays_;
+        mutable std::vector<Real> eventLosses_;
+        // results of the last pass over the events
+        mutable Date scannedDate_;
+        mutable std::vector<Real> simLosses_;
+        mutable std::vector<Size> simDefaults_;
 
         mutable copulaPolicy copula_;
         mutable boost::shared_ptr<copulaRNG_type> copulasRng_;
 
         // Maximum time inversion horizon
         static const Size maxHorizon_ = 4050; // over 11 years
+        // Number of samples drawn before their events are computed
+        static const Size simsBlockSize_ = 1024;
         // Inversion probability limits are computed by children in initdates()
     };
 
 
+    /* ---- Simulation ---------------------------------------------------  */
+
+    template<template <class, class> class D, class C, class URNG>
+    void RandomLM<D, C, URNG>::performSimulations() const {
+        typedef std::vector<simEvent<D<C, URNG> > > events_type;
+        const D<C, URNG>* model = static_cast<const D<C, URNG>* >(this);
+
+        // exposures do not depend on the event date yet (see Basket)
+        std::vector<Real> exposures(basket_->size());
+        for(Size iName=0; iName<exposures.size(); iName++)
+            exposures[iName] = basket_->exposure(basket_->names()[iName]);
+
+        simsOffsets_.assign(1, 0);
+        eventNames_.clear();
+        eventDays_.clear();
+        eventLosses_.clear();
+        scannedDate_ = Date();
+
+        std::vector<std::vector<Real> > samples(simsBlockSize_);
+        std::vector<events_type> events(simsBlockSize_);
+        std::vector<std::string> errors(simsBlockSize_);
+        for(Size done=0; done<nSims_; done+=simsBlockSize_) {
+            Size blockSims = std::min(simsBlockSize_, nSims_-done);
+            for(Size i=0; i<blockSims; i++)
+                samples[i] = copulasRng_->nextSequence().value;
+
+            // exceptions can't propagate out of the parallel loop
+            #pragma omp parallel for
+            for(long i=0; i<long(blockSims); i++) {
+                try {
+                    events[i].clear();
+                    model->nextSample(samples[i], events[i]);
+                } catch(std::exception& e) {
+                    errors[i] = e.what();
+                }
+            }
+
+            for(Size i=0; i<blockSims; i++) {
+                QL_REQUIRE(errors[i].empty(), errors[i]);
+                for(Size iEvt=0; iEvt<events[i].size(); iEvt++) {
+                    // duck type on the members:
+                    Size iName = events[i][iEvt].nameIdx;
+                    eventNames_.push_back(
+                        static_cast<unsigned short>(iName));
+                    eventDays_.push_back(static_cast<unsigned short>(
+                        events[i][iEvt].dayFromRef));
+                    eventLosses_.push_back(exposures[iName] *
+                        (1.-getEventRecovery(events[i][iEvt])));
+                }
+                simsOffsets_.push_back(eventNames_.size());
+            }
+        }
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    void RandomLM<D, C, URNG>::scanSimulations(const Date& d) const {
+        calculate();
+        if(d == scannedDate_) return;
+
+        Date today = Settings::instance().evaluationDate();
+        Date::serial_type val = d.serialNumber() - today.serialNumber();
+
+        simLosses_.resize(nSims_);
+        simDefaults_.resize(nSims_);
+        #pragma omp parallel for
+        for(long iSim=0; iSim < long(nSims_); iSim++) {
+            Real portfSimLoss = 0.;
+            Size simCount = 0;
+            for(Size iEvt=simsOffsets_[iSim]; iEvt<simsOffsets_[iSim+1];
+                iEvt++) {
+                // if event is within time horizon...
+                if(val > static_cast<Date::serial_type>(eventDays_[iEvt])) {
+                    portfSimLoss += eventLosses_[iEvt];
+                    simCount++;
+                }
+            }
+            simLosses_[iSim] = portfSimLoss;
+            simDefaults_[iSim] = simCount;
+        }
+        scannedDate_ = d;
+    }
+
+
     /* ---- Statistics ---------------------------------------------------  */
 
     template<template <class, class> class D, class C, class URNG>
@@ -234,21 +331,13 @@ namespace QuantLib {
         Date today = Settings::instance().evaluationDate();
 
         QL_REQUIRE(d>today, "Date for statistic must be in the future.");
-        // casted to natural to avoid warning, we have just checked the sign
-        Natural val = d.serialNumber() - today.serialNumber();
 
         if(n==0) return 1.;
 
+        scanSimulations(d);
         Real counts = 0.;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            Size simCount = 0;
-            const std::vector<simEvent<D<C, URNG> > >& events =
-                getSim(iSim);
-            for(Size iEvt=0; iEvt < events.size(); iEvt++)
-                // duck type on the members:
-                if(val > events[iEvt].dayFromRef) simCount++;
-                if(simCount >= n) counts++;
-        }
+        for(Size iSim=0; iSim < nSims_; iSim++)
+            if(simDefaults_[iSim] >= n) counts++;
         return counts/nSims_;
         // \todo Provide confidence interval
     }
@@ -268,17 +357,19 @@ namespace QuantLib {
         // casted to natural to avoid warning, we have just checked the sign
         Natural val = d.serialNumber() - today.serialNumber();
 
+        scanSimulations(d);
         std::vector<Probability> hitsByDate(basketSize, 0.);
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            // not enough events in this simulation, skip it
+            if(simDefaults_[iSim] < n) continue;
             std::map<unsigned short, unsigned short> namesDefaulting;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
+            for(Size iEvt=simsOffsets_[iSim]; iEvt<simsOffsets_[iSim+1];
+                iEvt++) {
                 // if event is within time horizon...
-                if(val > events[iEvt].dayFromRef)
+                if(val > eventDays_[iEvt])
                     //...count it. notice insertion sorts by date.
-                    namesDefaulting.insert(std::make_pair<unsigned short,
-                      unsigned short>(events[iEvt].dayFromRef,
-                        events[iEvt].nameIdx));
+                    namesDefaulting.insert(std::make_pair(eventDays_[iEvt],
+                        eventNames_[iEvt]));
             }
             if(namesDefaulting.size() >= n) {
                 std::map<unsigned short, unsigned short>::const_iterator
@@ -314,13 +405,13 @@ namespace QuantLib {
         Real expectedDefi = 0.;
         Real expectedDefj = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
             Real imatch = 0., jmatch = 0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if((val > events[iEvt].dayFromRef) &&
-                   (events[iEvt].nameIdx == iName)) imatch = 1.;
-                if((val > events[iEvt].dayFromRef) &&
-                   (events[iEvt].nameIdx == jName)) jmatch = 1.;
+            for(Size iEvt=simsOffsets_[iSim]; iEvt<simsOffsets_[iSim+1];
+                iEvt++) {
+                if((val > eventDays_[iEvt]) &&
+                   (eventNames_[iEvt] == iName)) imatch = 1.;
+                if((val > eventDays_[iEvt]) &&
+                   (eventNames_[iEvt] == jName)) jmatch = 1.;
             }
             expectedDefiDefj += imatch * jmatch;
             expectedDefi += imatch;
@@ -348,35 +439,18 @@ namespace QuantLib {
     std::pair<Real, Real> RandomLM<D, C, URNG>::expectedTrancheLossInterval(
         const Date& d, Probability confidencePerc) const
     {
-        calculate();
-        Date today = Settings::instance().evaluationDate();
-        Date::serial_type val = d.serialNumber() - today.serialNumber();
+        scanSimulations(d);
 
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
         // Real trancheLoss= 0.;
         GeneralStatistics lossStats;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                // if event is within time horizon...
-                if(val > static_cast<Date::serial_type>(events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-               }
-            }
+        lossStats.reserve(nSims_);
+        for(Size iSim=0; iSim < nSims_; iSim++)
             lossStats.add(// d  ates? current losses? realized defaults, not yet
-                std::min(std::max(portfSimLoss - attachAmount, 0.),
+                std::min(std::max(simLosses_[iSim] - attachAmount, 0.),
                     detachAmount - attachAmount) );
-        }
         return std::make_pair(lossStats.mean(), lossStats.errorEstimate() *
             InverseCumulativeNormal::standard_value(0.5*(1.+confidencePerc)));
     }
@@ -402,39 +476,19 @@ namespace QuantLib {
 
     template<template <class, class> class D, class C, class URNG>
     Histogram RandomLM<D, C, URNG>::computeHistogram(const Date& d) const {
-        std::vector<Real> data;
-        std::set<Real> keys;// attainable loss values
-        keys.insert(0.);
         Date today = Settings::instance().evaluationDate();
-        Date::serial_type val = d.serialNumber() - today.serialNumber();
         // redundant test? should have been tested by the basket caller?
         QL_REQUIRE(d >= today,
             "Requested percentile date must lie after computation date.");
-        calculate();
+        scanSimulations(d);
 
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-          // test needed (here and the others) to reuse simulations:
-          //          if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            data.push_back(std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount));
-            keys.insert(data.back());
-        }
+        std::vector<Real> data(nSims_);
+        for(Size iSim=0; iSim < nSims_; iSim++)
+            data[iSim] = std::min(std::max(simLosses_[iSim] - attachAmount,
+                0.), detachAmount - attachAmount);
         // avoid using as many points as in the simulation.
         Size nPts = std::min<Size>(data.size(), 150);// fix
         return Histogram(data.begin(), data.end(), nPts);
@@ -456,27 +510,12 @@ namespace QuantLib {
         Date::serial_type val = d.serialNumber() - today.serialNumber();
         if(val <= 0) return 0.;// plus basket realized losses
 
+        scanSimulations(d);
         //GenericRiskStatistics<GeneralStatistics> statsX;
-        std::vector<Real> losses;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
-                    //if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
-            losses.push_back(portfSimLoss);
-        }
+        std::vector<Real> losses(nSims_);
+        for(Size iSim=0; iSim < nSims_; iSim++)
+            losses[iSim] = std::min(std::max(simLosses_[iSim] - attachAmount,
+                0.), detachAmount - attachAmount);
 
         std::sort(losses.begin(), losses.end());
         Real posit = std::ceil(percent * nSims_);
@@ -541,33 +580,16 @@ namespace QuantLib {
 
         QL_REQUIRE(percentile >= 0. && percentile <= 1.,
             "Incorrect percentile");
-        calculate();
+        scanSimulations(d);
 
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
-        std::vector<Real> rankLosses;
-        Date today = Settings::instance().evaluationDate();
-        Date::serial_type val = d.serialNumber() - today.serialNumber();
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                 //   if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
-            // update dataset for rank stat:
-            rankLosses.push_back(portfSimLoss);
-        }
+        // dataset for rank stat:
+        std::vector<Real> rankLosses(nSims_);
+        for(Size iSim=0; iSim < nSims_; iSim++)
+            rankLosses[iSim] = std::min(std::max(simLosses_[iSim]
+                - attachAmount, 0.), detachAmount - attachAmount);
 
         std::sort(rankLosses.begin(), rankLosses.end());
         Size quantilePosition = static_cast<Size>(floor(nSims_*percentile));
@@ -640,7 +662,7 @@ namespace QuantLib {
     {
         /* Check 'loss' value integrity: i.e. is within tranche limits? (should
             have been done basket...)*/
-        calculate();
+        scanSimulations(date);
 
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
@@ -652,47 +674,34 @@ namespace QuantLib {
         Date today = Settings::instance().evaluationDate();
         Date::serial_type val = date.serialNumber() - today.serialNumber();
 
+        // (date, position) of the events of a simulation within the horizon
+        std::vector<std::pair<unsigned short, Size> > splitEventsBuffer;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            //std::vector<Real> splitBuffer(numLiveNames_, 0.);
-            std::vector<simEvent<D<C, URNG> > > splitEventsBuffer;
-
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                // if(basket_->pool()->has(copula_->pool()->names()[iName])) {
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                        //and will sort later if buffer applies:
-                        splitEventsBuffer.push_back(events[iEvt]);
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
+            Real portfSimLoss = std::min(std::max(simLosses_[iSim]
+                - attachAmount, 0.), detachAmount - attachAmount);
 
             /* second pass; split is conditional to total losses within target
             losses/percentile:  */
             Real ptflCumulLoss = 0.;
             if(portfSimLoss > loss) {
+                splitEventsBuffer.clear();
+                for(Size iEvt=simsOffsets_[iSim]; iEvt<simsOffsets_[iSim+1];
+                    iEvt++) {
+                    if(val > static_cast<Date::serial_type>(eventDays_[iEvt]))
+                        splitEventsBuffer.push_back(
+                            std::make_pair(eventDays_[iEvt], iEvt));
+                }
                 std::sort(splitEventsBuffer.begin(), splitEventsBuffer.end());
                 //NOW THIS:
                 split.assign(numLiveNames, 0.);
                 /*  if the name triggered a loss in the portf limits assign
                 this loss to that name..  */
                 for(Size i=0; i<splitEventsBuffer.size(); i++) {
-                    Size iName = splitEventsBuffer[i].nameIdx;
-                    Real lossName =
-            // allows amortizing (others should be like this)
-            // basket_->remainingNotionals(Date(simsBuffer_[i].dayFromRef +
-            //      today.serialNumber()))[iName] *
-                        basket_->exposure(basket_->names()[iName],
-                            Date(splitEventsBuffer[i].dayFromRef +
-                                today.serialNumber())) *
-                                (1.-getEventRecovery(splitEventsBuffer[i]));
+                    Size iEvt = splitEventsBuffer[i].second;
+                    Size iName = eventNames_[iEvt];
+                    // allows amortizing (others should be like this) once
+                    //   exposures depend on the event date
+                    Real lossName = eventLosses_[iEvt];
 
                     Real tranchedLossBefore =
                         std::min(std::max(ptflCumulLoss - attachAmount, 0.),
@@ -782,7 +791,8 @@ namespace QuantLib {
 
     // move this one to a separte file?
     /*! Random default with deterministic recovery event type.\par
-    Stores sims results in a bitfield buffer for lean memory storage.
+    Events are generated in this bitfield form for lean memory storage and
+    then stored by columns by the base class.
     Although strictly speaking this is not guaranteed by the compiler it
     amounts to reducing the memory storage by half.
     Some computations, like conditional statistics, precise that all sims
@@ -865,7 +875,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+                        std::vector<defaultSimEvent>& events) const;
         void initDates() const {
             /* Precalculate horizon time default probabilities (used to
               determine if the default took place and subsequently compute its
@@ -875,10 +886,16 @@ namespace QuantLib {
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const boost::shared_ptr<Pool>& pool = this->basket_->pool();
-            for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
-                horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
-                    defaultProbability(this->basket_->defaultKeys()[iName])
-                        ->defaultProbability(maxHorizonDate, true));
+            const std::vector<DefaultProbKey> defaultKeys =
+                this->basket_->defaultKeys();
+            horizonDefaultPs_.clear();
+            defaultCurves_.clear();
+            for(Size iName=0; iName < this->basket_->size(); ++iName) {//'live'
+                defaultCurves_.push_back(pool->get(pool->names()[iName]).
+                    defaultProbability(defaultKeys[iName]));
+                horizonDefaultPs_.push_back(defaultCurves_.back()
+                    ->defaultProbability(maxHorizonDate, true));
+            }
         }
         Real getEventRecovery(const defaultSimEvent& evt) const {
             return recoveries_[evt.nameIdx];
@@ -916,6 +933,9 @@ namespace QuantLib {
         // Default probabilities for each name at the time of the maximun
         //   horizon date. Cached for perf.
         mutable std::vector<Probability> horizonDefaultPs_;
+        // Default curves of each name, read by the simulation threads.
+        mutable std::vector<Handle<DefaultProbabilityTermStructure> >
+            defaultCurves_;
     };
 
 
@@ -924,12 +944,9 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomDefaultLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const
     {
-        const boost::shared_ptr<Pool>& pool = this->basket_->pool();
-        // starts with no events
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
-
         for(Size iName=0; iName<copula_->size(); iName++) {
             Real latentVarSample =
                 copula_->latentVarValue(values, iName);
@@ -938,8 +955,7 @@ namespace QuantLib {
             // If the default simulated lies before the max date:
             if (horizonDefaultPs_[iName] >= simDefaultProb) {
                 const Handle<DefaultProbabilityTermStructure>& dfts =
-                    pool->get(pool->names()[iName]).// use 'live' names
-                    defaultProbability(this->basket_->defaultKeys()[iName]);
+                    defaultCurves_[iName];// use 'live' names
                 // compute and store default time with respect to the
                 //  curve ref date:
                 Size dateSTride =
@@ -956,7 +972,7 @@ namespace QuantLib {
                                         std::log(1.-simDefaultProb)
                     /std::log(1.-data_.horizonDefaultPs_[iName])));
                    */
-                this->simsBuffer_.back().push_back(defaultSimEvent(iName,
+                events.push_back(defaultSimEvent(iName,
                     dateSTride));
                //emplace_back
             }
@@ -100,7 +100,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomLossLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+                        std::vector<defaultSimEvent>& events) const;
 
         // see note on randomdefaultlatentmodel
         void initDates() const {
@@ -112,10 +113,16 @@ namespace QuantLib {
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const boost::shared_ptr<Pool>& pool = this->basket_->pool();
-            for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
-                horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
-                    defaultProbability(this->basket_->defaultKeys()[iName])
-                        ->defaultProbability(maxHorizonDate, true));
+            const std::vector<DefaultProbKey> defaultKeys =
+                this->basket_->defaultKeys();
+            horizonDefaultPs_.clear();
+            defaultCurves_.clear();
+            for(Size iName=0; iName < this->basket_->size(); ++iName) {//'live'
+                defaultCurves_.push_back(pool->get(pool->names()[iName]).
+                    defaultProbability(defaultKeys[iName]));
+                horizonDefaultPs_.push_back(defaultCurves_.back()
+                    ->defaultProbability(maxHorizonDate, true));
+            }
         }
        Real getEventRecovery(const defaultSimEvent& evt) const {
             return evt.recovery();
@@ -145,6 +152,9 @@ namespace QuantLib {
         // Default probabilities for each name at the time of the maximun 
         //   horizon date. Cached for perf.
         mutable std::vector<Probability> horizonDefaultPs_;
+        // Default curves of each name, read by the simulation threads.
+        mutable std::vector<Handle<DefaultProbabilityTermStructure> >
+            defaultCurves_;
     };
 
 
@@ -153,11 +163,9 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomLossLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const 
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const 
     {
-        const boost::shared_ptr<Pool>& pool = this->basket_->pool();
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
-
         // half the model is defaults, the other half are RRs...
         for(Size iName=0; iName<copula_->size()/2; iName++) {
             // ...but samples must be full
@@ -174,9 +182,8 @@ namespace QuantLib {
                 copula_->cumulativeY(latentVarSample, iName);
             // If the default simulated lies before the max date:
             if (horizonDefaultPs_[iName] >= simDefaultProb) {
-                const Handle<DefaultProbabilityTermStructure>& dfts = 
-                    pool->get(pool->names()[iName]).  // use 'live' names
-                    defaultProbability(this->basket_->defaultKeys()[iName]);
+                const Handle<DefaultProbabilityTermStructure>& dfts =
+                    defaultCurves_[iName];// use 'live' names
                 // compute and store default time with respect to the 
                 //  curve ref date:
                 Size dateSTride =
@@ -208,9 +215,9 @@ namespace QuantLib {
                 Real latentRRVarSample = 
                     copula_->latentRRVarValue(values, iName);
                 Real recovery = 
-                    copula_->conditionalRecovery(latentRRVarSample,
-                        iName, eventDate);
-                this->simsBuffer_.back().push_back(
+                    copula_->conditionalRecoveryP(latentRRVarSample,
+                        dfts->defaultProbability(eventDate, true), iName);
+                events.push_back(
                   defaultSimEvent(iName, dateSTride, recovery));
                 //emplace_back
             }
@@ -393,7 +393,7 @@ namespace QuantLib {
             invUncondProbs[i] = 
             copula_->inverseCumulativeY(invUncondProbs[i], i);
 
-        return copula_->integratedExpectedValue(
+        return copula_->integratedExpectedValueOnBlocks(
             boost::function<Real (const std::vector<Real>& v1)>(
                 boost::bind(
                     &SaddlePointLossModel<CP>::CumulantGeneratingCond,
@@ -415,7 +415,7 @@ namespace QuantLib {
             invUncondProbs[i] = 
             copula_->inverseCumulativeY(invUncondProbs[i], i);
 
-       return copula_->integratedExpectedValue(
+       return copula_->integratedExpectedValueOnBlocks(
             boost::function<Real (const std::vector<Real>& v1)>(
                 boost::bind(
                     &SaddlePointLossModel<CP>::CumGen1stDerivativeCond,
@@ -437,7 +437,7 @@ namespace QuantLib {
             invUncondProbs[i] = 
             copula_->inverseCumulativeY(invUncondProbs[i], i);
 
-        return copula_->integratedExpectedValue(
+        return copula_->integratedExpectedValueOnBlocks(
             boost::function<Real (const std::vector<Real>& v1)>(
                 boost::bind(
                     &SaddlePointLossModel<CP>::CumGen2ndDerivativeCond,
@@ -459,7 +459,7 @@ namespace QuantLib {
             invUncondProbs[i] = 
             copula_->inverseCumulativeY(invUncondProbs[i], i);
 
-        return copula_->integratedExpectedValue(
+        return copula_->integratedExpectedValueOnBlocks(
             boost::function<Real (const std::vector<Real>& v1)>(
                 boost::bind(
                     &SaddlePointLossModel<CP>::CumGen3rdDerivativeCond,
@@ -481,7 +481,7 @@ namespace QuantLib {
             invUncondProbs[i] = 
             copula_->inverseCumulativeY(invUncondProbs[i], i);
 
-        return copula_->integratedExpectedValue(
+        return copula_->integratedExpectedValueOnBlocks(
             boost::function<Real (const std::vector<Real>& v1)>(
                 boost::bind(
                     &SaddlePointLossModel<CP>::CumGen4thDerivativeCond,
@@ -508,7 +508,7 @@ namespace QuantLib {
             invUncondProbs[i] = 
             copula_->inverseCumulativeY(invUncondProbs[i], i);
 
-        return copula_->integratedExpectedValue(
+        return copula_->integratedExpectedValueOnBlocks(
             boost::function<Real (const std::vector<Real>& v1)>(
                 boost::bind(
                     &SaddlePointLossModel<CP>::probOverLossCond,
@@ -533,7 +533,7 @@ namespace QuantLib {
             invUncondProbs[i] = 
             copula_->inverseCumulativeY(invUncondProbs[i], i);
 
-        return copula_->integratedExpectedValue(
+        return copula_->integratedExpectedValueOnBlocks(
             boost::function<Real (const std::vector<Real>& v1)>(
                 boost::bind(
                     &SaddlePointLossModel<CP>::probOverLossPortfCond,
@@ -555,7 +555,7 @@ namespace QuantLib {
             invUncondProbs[i] = 
             copula_->inverseCumulativeY(invUncondProbs[i], i);
 
-        return copula_->integratedExpectedValue(
+        return copula_->integratedExpectedValueOnBlocks(
             boost::function<Real (const std::vector<Real>& v1)>(
                 boost::bind(
                     &SaddlePointLossModel<CP>::conditionalExpectedTrancheLoss,
@@ -576,7 +576,7 @@ namespace QuantLib {
             invUncondProbs[i] = 
             copula_->inverseCumulativeY(invUncondProbs[i], i);
 
-        return copula_->integratedExpectedValue(
+        return copula_->integratedExpectedValueOnBlocks(
             boost::function<Real (const std::vector<Real>& v1)>(
                 boost::bind(
                     &SaddlePointLossModel<CP>::probDensityCond,
@@ -1416,7 +1416,7 @@ namespace QuantLib {
                 copula_->inverseCumulativeY(invUncondProbs[i], i);
 
         // Integrate with the tranche or the portfolio according to the limits.
-        return copula_->integratedExpectedValue(
+        return copula_->integratedExpectedValueOnBlocks(
             boost::function<Real (const std::vector<Real>& v1)>(
                 boost::bind(
                   &SaddlePointLossModel<CP>::expectedShortfallFullPortfolioCond,
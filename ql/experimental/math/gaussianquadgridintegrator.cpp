@@ -0,0 +1,202 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/math/gaussianquadgridintegrator.hpp>
+#include <ql/math/integrals/gaussianquadratures.hpp>
+#include <ql/math/factorial.hpp>
+#include <map>
+#include <numeric>
+#include <string>
+
+namespace QuantLib {
+
+    namespace {
+
+        struct Rule {
+            std::vector<Real> x, w;
+        };
+
+        Rule gaussHermiteRule(Size order) {
+            GaussHermiteIntegration integration(order);
+            Rule rule;
+            rule.x.assign(integration.x().begin(), integration.x().end());
+            rule.w.assign(integration.weights().begin(),
+                          integration.weights().end());
+            // the central node of odd rules must coincide across
+            // rules for the sparse grid to merge it
+            for (Size i=0; i<rule.x.size(); ++i)
+                if (std::fabs(rule.x[i]) < 1.0e-14)
+                    rule.x[i] = 0.0;
+            return rule;
+        }
+
+        // adds the tensor product of the given rules, times a
+        // coefficient, to the accumulated nodes
+        void addTensorProduct(const std::vector<const Rule*>& rules,
+                              Real coefficient,
+                              std::map<std::vector<Real>, Real>& nodes) {
+            Size d = rules.size();
+            std::vector<Size> index(d, 0);
+            std::vector<Real> node(d);
+            for (;;) {
+                Real weight = coefficient;
+                for (Size k=0; k<d; ++k) {
+                    node[k] = rules[k]->x[index[k]];
+                    weight *= rules[k]->w[index[k]];
+                }
+                nodes[node] += weight;
+                // next index, last dimension running fastest
+                Size k = d;
+                while (k > 0 && ++index[k-1] == rules[k-1]->x.size())
+                    index[--k] = 0;
+                if (k == 0)
+                    break;
+            }
+        }
+
+    }
+
+    GaussianQuadGridIntegrator::GaussianQuadGridIntegrator(Size dimension,
+                                                           Size order,
+                                                           Grid grid,
+                                                           Size blockSize)
+    : dimension_(dimension), blockSize_(blockSize), size_(0) {
+        QL_REQUIRE(dimension_ > 0, "null dimension");
+        QL_REQUIRE(order > 0, "null order");
+        QL_REQUIRE(blockSize_ > 0, "null block size");
+
+        std::map<std::vector<Real>, Real> nodes;
+        switch (grid) {
+          case TensorProduct: {
+              Rule rule = gaussHermiteRule(order);
+              addTensorProduct(std::vector<const Rule*>(dimension_, &rule),
+                               1.0, nodes);
+              break;
+          }
+          case Smolyak: {
+              // combination technique: the sum over the levels l with
+              // q-d+1 <= |l| <= q of (-1)^(q-|l|) binom(d-1,q-|l|)
+              // times the tensor product of the rules with 2l_i-1 points
+              Size levels = (order+1)/2, d = dimension_;
+              Size q = levels + d - 1;
+              std::vector<Rule> rules(levels+1);
+              for (Size l=1; l<=levels; ++l)
+                  rules[l] = gaussHermiteRule(2*l-1);
+              std::vector<Size> l(d, 1);
+              std::vector<const Rule*> product(d);
+              for (;;) {
+                  Size norm = std::accumulate(l.begin(), l.end(), Size(0));
+                  if (norm + d > q && norm <= q) {
+                      Size j = q - norm;
+                      Real coefficient =
+                          (j % 2 == 0 ? 1.0 : -1.0) *
+                          Factorial::get(d-1) /
+                          (Factorial::get(j) * Factorial::get(d-1-j));
+                      for (Size k=0; k<d; ++k)
+                          product[k] = &rules[l[k]];
+                      addTensorProduct(product, coefficient, nodes);
+                  }
+                  Size k = d;
+                  while (k > 0 && ++l[k-1] > levels)
+                      l[--k] = 1;
+                  if (k == 0)
+                      break;
+              }
+              break;
+          }
+          default:
+            QL_FAIL("unknown grid type");
+        }
+
+        for (std::map<std::vector<Real>, Real>::const_iterator i =
+                 nodes.begin(); i != nodes.end(); ++i) {
+            if (i->second != 0.0)
+                addNode(i->first, i->second);
+        }
+    }
+
+    void GaussianQuadGridIntegrator::addNode(const std::vector<Real>& node,
+                                             Real weight) {
+        if (blocks_.empty() || blocks_.back().size() == blockSize_) {
+            blocks_.push_back(Block());
+            blocks_.back().reserve(blockSize_);
+            weights_.push_back(std::vector<Real>());
+            weights_.back().reserve(blockSize_);
+        }
+        blocks_.back().push_back(node);
+        weights_.back().push_back(weight);
+        ++size_;
+    }
+
+    Real GaussianQuadGridIntegrator::operator()(
+          const boost::function<Real (const std::vector<Real>&)>& f) const {
+        Real sum = 0.0;
+        for (Size i=0; i<blocks_.size(); ++i)
+            for (Size j=0; j<blocks_[i].size(); ++j)
+                sum += weights_[i][j] * f(blocks_[i][j]);
+        return sum;
+    }
+
+    Disposable<std::vector<Real> > GaussianQuadGridIntegrator::integrateV(
+                const boost::function<Disposable<std::vector<Real> > (
+                                     const std::vector<Real>&)>& f) const {
+        std::vector<Real> sum;
+        for (Size i=0; i<blocks_.size(); ++i) {
+            for (Size j=0; j<blocks_[i].size(); ++j) {
+                std::vector<Real> term = f(blocks_[i][j]);
+                if (sum.empty())
+                    sum.resize(term.size(), 0.0);
+                QL_REQUIRE(term.size() == sum.size(),
+                           "inconsistent integrand size");
+                for (Size k=0; k<term.size(); ++k)
+                    sum[k] += weights_[i][j] * term[k];
+            }
+        }
+        return sum;
+    }
+
+    Real GaussianQuadGridIntegrator::integrateBlocks(
+                const boost::function<Disposable<std::vector<Real> > (
+                                                 const Block&)>& f) const {
+        std::vector<Real> sums(blocks_.size(), 0.0);
+        std::vector<std::string> errors(blocks_.size());
+        // exceptions can't propagate out of the parallel loop and
+        // are reported afterwards
+        #pragma omp parallel for
+        for (long i=0; i<long(blocks_.size()); ++i) {
+            try {
+                std::vector<Real> values = f(blocks_[i]);
+                QL_REQUIRE(values.size() == blocks_[i].size(),
+                           "wrong number of values (" << values.size()
+                           << ") returned for " << blocks_[i].size()
+                           << " nodes");
+                sums[i] = std::inner_product(values.begin(), values.end(),
+                                             weights_[i].begin(), 0.0);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+
+        Real sum = 0.0;
+        for (Size i=0; i<blocks_.size(); ++i) {
+            QL_REQUIRE(errors[i].empty(), errors[i]);
+            sum += sums[i];
+        }
+        return sum;
+    }
+
+}
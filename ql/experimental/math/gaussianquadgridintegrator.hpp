@@ -0,0 +1,104 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file gaussianquadgridintegrator.hpp
+    \brief Tabulated Gauss-Hermite integration over \f$ R^n \f$
+*/
+
+#ifndef quantlib_math_gaussian_quad_grid_integrator_hpp
+#define quantlib_math_gaussian_quad_grid_integrator_hpp
+
+#include <ql/utilities/disposable.hpp>
+#include <ql/types.hpp>
+#include <boost/function.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Multidimensional integration on a precomputed Gauss-Hermite grid
+    /*! Integrates functions over \f$ R^n \f$ as a weighted sum over a
+        set of nodes calculated at construction, either the full
+        tensor product of a Gauss-Hermite rule (i.e., the same nodes
+        used by GaussianQuadMultidimIntegrator) or the Smolyak sparse
+        grid built from Gauss-Hermite rules with \f$ 2l-1 \f$ points,
+        \f$ l = 1, \dots, L \f$.  The sparse grid integrates exactly
+        polynomials (times the Hermite weight) of total degree up to
+        \f$ 2L-1 \f$ with far fewer nodes than the tensor product; its
+        weights can be negative.
+
+        Nodes are stored in blocks.  Integrands can be evaluated point
+        by point or, to avoid the overhead of a call per node, on a
+        whole block at a time; in the latter case, the blocks are
+        evaluated in parallel when OpenMP is enabled and the results
+        are summed in a fixed order.
+
+        \warning Integrands evaluated on blocks must be thread-safe.
+
+        \test the integrals of a few polynomials times gaussian
+              densities are checked against their known values.
+    */
+    class GaussianQuadGridIntegrator {
+      public:
+        enum Grid { TensorProduct, Smolyak };
+        typedef std::vector<std::vector<Real> > Block;
+        /*!
+            @param dimension Integration variable dimension.
+            @param order Number of points of the Gauss-Hermite rule for
+                   the tensor product, or of the finest rule used
+                   for the sparse grid.
+            @param grid Grid type.
+            @param blockSize Maximum number of nodes in each block.
+        */
+        GaussianQuadGridIntegrator(Size dimension,
+                                   Size order,
+                                   Grid grid = TensorProduct,
+                                   Size blockSize = 64);
+        //! \name Inspectors
+        //@{
+        Size dimension() const { return dimension_; }
+        //! total number of nodes
+        Size size() const { return size_; }
+        const std::vector<Block>& blocks() const { return blocks_; }
+        const std::vector<std::vector<Real> >& weights() const {
+            return weights_;
+        }
+        //@}
+        //! \name Integration
+        //@{
+        //! integral of a scalar function evaluated at each node
+        Real operator()(
+             const boost::function<Real (const std::vector<Real>&)>& f) const;
+        //! integral of a vector function evaluated at each node
+        Disposable<std::vector<Real> > integrateV(
+             const boost::function<Disposable<std::vector<Real> > (
+                                        const std::vector<Real>&)>& f) const;
+        /*! integral of a scalar function evaluated on a block of
+            nodes at a time; f must return its value at each node. */
+        Real integrateBlocks(
+             const boost::function<Disposable<std::vector<Real> > (
+                                                  const Block&)>& f) const;
+        //@}
+      private:
+        void addNode(const std::vector<Real>& node, Real weight);
+        Size dimension_, blockSize_, size_;
+        std::vector<Block> blocks_;
+        std::vector<std::vector<Real> > weights_;
+    };
+
+}
+
+#endif
@@ -22,6 +22,7 @@
 
 #include <ql/experimental/math/multidimquadrature.hpp>
 #include <ql/experimental/math/multidimintegrator.hpp>
+#include <ql/experimental/math/gaussianquadgridintegrator.hpp>
 #include <ql/math/integrals/trapezoidintegral.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 // for template spezs
@@ -56,6 +57,23 @@ namespace QuantLib {
                 return v;
             }
         };
+
+        //! evaluates a scalar function at each node of a block
+        class PointwiseOnBlock {
+          public:
+            explicit PointwiseOnBlock(
+                const boost::function<Real (const std::vector<Real>&)>& f)
+            : f_(f) {}
+            Disposable<std::vector<Real> > operator()(
+                        const std::vector<std::vector<Real> >& block) const {
+                std::vector<Real> values(block.size());
+                for (Size i=0; i<block.size(); ++i)
+                    values[i] = f_(block[i]);
+                return values;
+            }
+          private:
+            boost::function<Real (const std::vector<Real>&)> f_;
+        };
     }
 
     //! \name Latent model direct integration facility.
@@ -88,6 +106,15 @@ namespace QuantLib {
             const std::vector<Real>& arg)>& f) const {
             QL_FAIL("No vector integration provided");
         }
+        //! whether the integration evaluates blocks of nodes natively
+        virtual bool integratesBlocks() const { return false; }
+        /* integral of a scalar function evaluated on blocks of nodes;
+        the function returns its values at the nodes of the block. */
+        virtual Real integrateBlocks(
+            const boost::function<Disposable<std::vector<Real> > (
+            const std::vector<std::vector<Real> >& nodes)>& f) const {
+            QL_FAIL("No block integration provided");
+        }
         virtual ~LMIntegration() {}
     };
 
@@ -107,7 +134,11 @@ namespace QuantLib {
         typedef 
         enum LatentModelIntegrationType {
             GaussianQuadrature,
-            Trapezoid
+            Trapezoid,
+            GaussianQuadratureGrid,
+            /* sparse grids have negative weights; they converge slowly
+               for integrands which are not smooth in the factors */
+            SparseGaussianQuadrature
             // etc....
         } LatentModelIntegrationType;
     }
@@ -150,6 +181,31 @@ namespace QuantLib {
         const std::vector<Real> a_, b_;
     };
 
+    template<> class IntegrationBase<GaussianQuadGridIntegrator> :
+        public GaussianQuadGridIntegrator, public LMIntegration {
+    public:
+        IntegrationBase(Size dimension, Size order,
+                        GaussianQuadGridIntegrator::Grid grid)
+        : GaussianQuadGridIntegrator(dimension, order, grid) {}
+        Real integrate(const boost::function<Real (
+            const std::vector<Real>& arg)>& f) const {
+                return GaussianQuadGridIntegrator::operator()(f);
+        }
+        Disposable<std::vector<Real> > integrateV(
+            const boost::function<Disposable<std::vector<Real> >  (
+                const std::vector<Real>& arg)>& f) const {
+                return GaussianQuadGridIntegrator::integrateV(f);
+        }
+        bool integratesBlocks() const { return true; }
+        // blocks are evaluated in parallel
+        Real integrateBlocks(
+            const boost::function<Disposable<std::vector<Real> > (
+            const std::vector<std::vector<Real> >& nodes)>& f) const {
+                return GaussianQuadGridIntegrator::integrateBlocks(f);
+        }
+        virtual ~IntegrationBase() {}
+    };
+
     // Intended to replace OneFactorCopula
 
     /*!
@@ -485,6 +541,20 @@ namespace QuantLib {
                                (integrals, -35., 35.);
                         break;
                         }
+                    case LatentModelIntegrationType::GaussianQuadratureGrid:
+                        return
+                            boost::make_shared<
+                            IntegrationBase<GaussianQuadGridIntegrator> >(
+                                dimension, 25,
+                                GaussianQuadGridIntegrator::TensorProduct);
+                        break;
+                    case LatentModelIntegrationType::SparseGaussianQuadrature:
+                        return
+                            boost::make_shared<
+                            IntegrationBase<GaussianQuadGridIntegrator> >(
+                                dimension, 25,
+                                GaussianQuadGridIntegrator::Smolyak);
+                        break;
                     default:
                         QL_FAIL("Unknown latent model integration type.");
                 }
@@ -599,6 +669,57 @@ namespace QuantLib {
                         boost::bind(&copulaPolicyImpl::density, copula_, _1),
                         boost::bind(boost::cref(f), _1)));
         }
+        /*! Integrates an arbitrary scalar function evaluated on blocks of
+         values of the factors; the function returns its values at each
+         point of the block. Integrations supporting blocks evaluate
+         them in parallel, in which case the function must be
+         thread-safe; the others integrate the point-wise version of
+         the function directly.
+        */
+        Real integratedExpectedValueOnBlocks(
+            const boost::function<Disposable<std::vector<Real> >(
+                const std::vector<std::vector<Real> >& block)>& f,
+            const boost::function<Real(
+                const std::vector<Real>& v1)>& pointwise) const {
+            if (integration()->integratesBlocks())
+                return integration()->integrateBlocks(
+                    DensityOnBlock(copula_, f));
+            return integratedExpectedValue(pointwise);
+        }
+        /*! Same as above for a point-wise function, which is evaluated
+         node by node within each block when the integration supports
+         blocks.
+        */
+        Real integratedExpectedValueOnBlocks(
+            const boost::function<Real(
+                const std::vector<Real>& v1)>& f) const {
+            if (integration()->integratesBlocks())
+                return integration()->integrateBlocks(
+                    DensityOnBlock(copula_, detail::PointwiseOnBlock(f)));
+            return integratedExpectedValue(f);
+        }
+    private:
+        // composes a function on blocks with the density
+        class DensityOnBlock {
+          public:
+            DensityOnBlock(const copulaPolicyImpl& copula,
+                const boost::function<Disposable<std::vector<Real> >(
+                    const std::vector<std::vector<Real> >&)>& f)
+            : copula_(copula), f_(f) {}
+            Disposable<std::vector<Real> > operator()(
+                        const std::vector<std::vector<Real> >& block) const {
+                std::vector<Real> values = f_(block);
+                QL_REQUIRE(values.size() == block.size(),
+                    "wrong number of values returned on block");
+                for (Size i=0; i<block.size(); ++i)
+                    values[i] *= copula_.density(block[i]);
+                return values;
+            }
+          private:
+            const copulaPolicyImpl& copula_;
+            boost::function<Disposable<std::vector<Real> >(
+                const std::vector<std::vector<Real> >&)> f_;
+        };
     protected:
         // Integrable models must provide their integrator.
         // Arguable, not having the integration in the LM class saves that 
@@ -2,5 +2,8 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/experimental/risk/creditriskplus.hpp>
+#include <ql/experimental/risk/fftcreditriskplus.hpp>
+#include <ql/experimental/risk/hullwhiteexposuresimulator.hpp>
+#include <ql/experimental/risk/scenarioanalysis.hpp>
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
 
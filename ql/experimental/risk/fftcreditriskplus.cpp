@@ -0,0 +1,275 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+  This file is part of QuantLib, a free-software/open-source library
+  for financial quantitative analysts and developers - http://quantlib.org/
+
+  QuantLib is free software: you can redistribute it and/or modify it
+  under the terms of the QuantLib license.  You should have received a
+  copy of the license along with this program; if not, please email
+  <quantlib-dev@lists.sf.net>. The license is also available online at
+  <http://quantlib.org/license.shtml>.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/fftcreditriskplus.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+#include <ql/errors.hpp>
+#include <string>
+
+namespace QuantLib {
+
+    FFTCreditRiskPlus::FFTCreditRiskPlus(
+                        const std::vector<Real>& exposure,
+                        const std::vector<Real>& defaultProbability,
+                        const std::vector<Size>& sector,
+                        const std::vector<Real>& relativeDefaultVariance,
+                        Real unit,
+                        Size buckets)
+    : exposure_(exposure), pd_(defaultProbability), sector_(sector),
+      relativeDefaultVariance_(relativeDefaultVariance), unit_(unit) {
+
+        m_ = exposure_.size();
+        n_ = relativeDefaultVariance_.size();
+
+        QL_REQUIRE(m_ > 0, "no exposures given");
+        QL_REQUIRE(m_ == pd_.size(),
+                   "number of exposures (" << m_
+                   << ") must be equal to number of pds ("
+                   << pd_.size() << ")");
+        QL_REQUIRE(m_ == sector_.size(),
+                   "number of exposures (" << m_
+                   << ") must be equal to number of exposure sectors ("
+                   << sector_.size() << ")");
+        QL_REQUIRE(n_ > 0, "no sectors given");
+        QL_REQUIRE(unit_ > 0.0,
+                   "loss unit (" << unit_ << ") must be positive");
+        for (Size i=0; i<n_; ++i)
+            QL_REQUIRE(relativeDefaultVariance_[i] >= 0.0,
+                       "relative default variance #" << i
+                       << " is negative (" << relativeDefaultVariance_[i]
+                       << ")");
+
+        nu_.resize(m_);
+        pdAdj_.resize(m_);
+        sectorObligors_.resize(n_);
+        sectorPdSum_ = std::vector<Real>(n_, 0.0);
+        sectorExposure_ = std::vector<Real>(n_, 0.0);
+        sectorEl_ = std::vector<Real>(n_, 0.0);
+        sectorUl_ = std::vector<Real>(n_, 0.0);
+        exposureSum_ = el_ = 0.0;
+        Real el2 = 0.0;
+        Size maxNu = 0;
+        for (Size k=0; k<m_; ++k) {
+            QL_REQUIRE(exposure_[k] >= 0.0,
+                       "exposure #" << k << " is negative ("
+                       << exposure_[k] << ")");
+            QL_REQUIRE(pd_[k] >= 0.0,
+                       "pd #" << k << " is negative (" << pd_[k] << ")");
+            QL_REQUIRE(sector_[k] < n_,
+                       "sector #" << k << " (" << sector_[k]
+                       << ") is out of range 0..." << (n_ - 1));
+            // exposures are rounded to units, avoiding zero
+            // exposures, and pds adjusted to preserve the loss
+            nu_[k] = Size(std::floor(0.5 + exposure_[k]/unit_));
+            if (exposure_[k] > 0.0 && nu_[k] == 0)
+                nu_[k] = 1;
+            pdAdj_[k] = nu_[k] > 0 ?
+                exposure_[k] * pd_[k] / (nu_[k] * unit_) : 0.0;
+            maxNu = std::max(maxNu, nu_[k]);
+
+            Size s = sector_[k];
+            sectorObligors_[s].push_back(k);
+            sectorPdSum_[s] += pdAdj_[k];
+            sectorExposure_[s] += exposure_[k];
+            sectorEl_[s] += exposure_[k] * pd_[k];
+            sectorUl_[s] += pd_[k] * exposure_[k] * exposure_[k];
+            exposureSum_ += exposure_[k];
+            el_ += exposure_[k] * pd_[k];
+            el2 += pd_[k] * exposure_[k] * exposure_[k];
+        }
+
+        // with independent sectors, the variance is the sum of the
+        // systematic sector terms and of the Poisson terms
+        ul_ = el2;
+        for (Size s=0; s<n_; ++s) {
+            Real systematic =
+                relativeDefaultVariance_[s] * sectorEl_[s] * sectorEl_[s];
+            sectorUl_[s] = std::sqrt(sectorUl_[s] + systematic);
+            ul_ += systematic;
+        }
+        ul_ = std::sqrt(ul_);
+
+        if (buckets == 0)
+            buckets = Size(std::ceil((el_ + 40.0*ul_)/unit_)) + 1;
+        buckets = std::max(buckets, maxNu + 1);
+        order_ = std::max<Size>(FastFourierTransform::min_order(buckets), 1);
+        const Size M = Size(1) << order_;
+
+        // log G(z) is the sum of the sector terms; sectors are
+        // transformed in parallel by blocks and their terms are summed
+        // in order, so that the result doesn't depend on the number of
+        // threads.
+        std::vector<std::complex<Real> > logPgf(M, 0.0);
+        const Size blockSize = 8;
+        std::vector<std::vector<std::complex<Real> > > terms(blockSize);
+        std::vector<std::string> errors(blockSize);
+        for (Size first=0; first<n_; first+=blockSize) {
+            Size block = std::min(blockSize, n_-first);
+            #pragma omp parallel for
+            for (long i=0; i<long(block); ++i) {
+                try {
+                    Size s = first + i;
+                    std::vector<std::complex<Real> >& q = terms[i];
+                    q.resize(M);
+                    sectorTransform(s, q);
+                    Real v = relativeDefaultVariance_[s];
+                    Real mu = sectorPdSum_[s];
+                    // the real part of 1 - v(Q(z)-mu) is at least 1,
+                    // so that the principal logarithm is continuous
+                    for (Size j=0; j<M; ++j) {
+                        if (v > 0.0)
+                            q[j] = -std::log(1.0 - v*(q[j]-mu)) / v;
+                        else
+                            q[j] -= mu;
+                    }
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                }
+            }
+            for (Size i=0; i<block; ++i) {
+                QL_REQUIRE(errors[i].empty(), errors[i]);
+                for (Size j=0; j<M; ++j)
+                    logPgf[j] += terms[i][j];
+            }
+        }
+
+        pgf_.resize(M);
+        for (Size j=0; j<M; ++j)
+            pgf_[j] = std::exp(logPgf[j]);
+
+        std::vector<std::complex<Real> > density(M);
+        FastFourierTransform fft(order_);
+        fft.inverse_transform(pgf_.begin(), pgf_.end(), density.begin());
+        loss_.resize(M);
+        for (Size j=0; j<M; ++j)
+            loss_[j] = std::max(density[j].real()/M, 0.0);
+    }
+
+    void FFTCreditRiskPlus::sectorTransform(
+                           Size s, std::vector<std::complex<Real> >& q) const {
+        const Size M = Size(1) << order_;
+        std::vector<Real> polynomial(M, 0.0);
+        const std::vector<Size>& obligors = sectorObligors_[s];
+        for (Size i=0; i<obligors.size(); ++i)
+            polynomial[nu_[obligors[i]]] += pdAdj_[obligors[i]];
+        FastFourierTransform fft(order_);
+        fft.transform(polynomial.begin(), polynomial.end(), q.begin());
+    }
+
+    Size FFTCreditRiskPlus::quantileIndex(Real p) const {
+        QL_REQUIRE(p >= 0.0 && p <= 1.0,
+                   "probability (" << p << ") must be in [0,1]");
+        Real sum = 0.0;
+        for (Size n=0; n<loss_.size()-1; ++n) {
+            sum += loss_[n];
+            if (sum >= p)
+                return n;
+        }
+        return loss_.size()-1;
+    }
+
+    Real FFTCreditRiskPlus::tailProbability(Size n) const {
+        Real sum = 0.0;
+        for (Size j=loss_.size(); j>n; --j)
+            sum += loss_[j-1];
+        return sum;
+    }
+
+    Real FFTCreditRiskPlus::lossQuantile(Real p) const {
+        return quantileIndex(p) * unit_;
+    }
+
+    Real FFTCreditRiskPlus::expectedShortfall(Real p) const {
+        Size x = quantileIndex(p);
+        Real sum = 0.0;
+        for (Size j=loss_.size(); j>x; --j)
+            sum += (j-1) * loss_[j-1];
+        Real tail = tailProbability(x);
+        QL_REQUIRE(tail > 0.0, "null tail probability");
+        return sum / tail * unit_;
+    }
+
+    Disposable<std::vector<Real> >
+    FFTCreditRiskPlus::lossQuantileContributions(Real p) const {
+        return contributions(p, false);
+    }
+
+    Disposable<std::vector<Real> >
+    FFTCreditRiskPlus::expectedShortfallContributions(Real p) const {
+        return contributions(p, true);
+    }
+
+    Disposable<std::vector<Real> >
+    FFTCreditRiskPlus::contributions(Real p, bool shortfall) const {
+        const Size M = Size(1) << order_;
+        Size x = quantileIndex(p);
+        Real probability = shortfall ? tailProbability(x) : loss_[x];
+        QL_REQUIRE(probability > 0.0,
+                   "null probability for the " << p << " quantile");
+
+        // E[N_k z^L] = p_k z^nu_k H_s(z), with H_s the transform of
+        // the loss distribution where the shape of the gamma variable
+        // of the obligor sector s is increased by one, i.e.,
+        // H_s(z) = G(z) / (1 - v_s (Q_s(z) - mu_s)).
+        std::vector<Real> result(m_, 0.0);
+        std::vector<std::string> errors(n_);
+        #pragma omp parallel for
+        for (long s=0; s<long(n_); ++s) {
+            try {
+                const std::vector<Size>& obligors = sectorObligors_[s];
+                if (obligors.empty())
+                    continue;
+                std::vector<std::complex<Real> > h(M), density(M);
+                sectorTransform(s, h);
+                Real v = relativeDefaultVariance_[s];
+                Real mu = sectorPdSum_[s];
+                for (Size j=0; j<M; ++j)
+                    h[j] = pgf_[j] / (1.0 - v*(h[j]-mu));
+                FastFourierTransform fft(order_);
+                fft.inverse_transform(h.begin(), h.end(), density.begin());
+
+                // probabilities, or tail probabilities, up to x
+                std::vector<Real> g(x+1);
+                Real tail = 0.0;
+                for (Size j=M; j>0; --j) {
+                    Real d = density[j-1].real()/M;
+                    tail += d;
+                    if (j-1 <= x)
+                        g[j-1] = shortfall ? tail : d;
+                }
+                for (Size i=0; i<obligors.size(); ++i) {
+                    Size k = obligors[i];
+                    if (nu_[k] == 0)
+                        continue;
+                    Real term;
+                    if (nu_[k] <= x)
+                        term = g[x-nu_[k]];
+                    else
+                        term = shortfall ? g[0] : 0.0;
+                    result[k] = nu_[k] * unit_ * pdAdj_[k] * term
+                        / probability;
+                }
+            } catch (std::exception& e) {
+                errors[s] = e.what();
+            }
+        }
+        for (Size s=0; s<n_; ++s)
+            QL_REQUIRE(errors[s].empty(), errors[s]);
+        return result;
+    }
+
+}
@@ -0,0 +1,145 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+  This file is part of QuantLib, a free-software/open-source library
+  for financial quantitative analysts and developers - http://quantlib.org/
+
+  QuantLib is free software: you can redistribute it and/or modify it
+  under the terms of the QuantLib license.  You should have received a
+  copy of the license along with this program; if not, please email
+  <quantlib-dev@lists.sf.net>. The license is also available online at
+  <http://quantlib.org/license.shtml>.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fftcreditriskplus.hpp
+    \brief CreditRisk+ loss distribution and contributions by FFT
+*/
+
+#ifndef quantlib_fft_creditriskplus_hpp
+#define quantlib_fft_creditriskplus_hpp
+
+#include <ql/utilities/disposable.hpp>
+#include <ql/types.hpp>
+#include <complex>
+#include <vector>
+
+namespace QuantLib {
+
+    //! CreditRisk+ model with independent sectors, inverted by FFT
+    /*! The loss distribution of the standard CreditRisk+ model with
+        independent gamma-distributed sector variables (a sector with
+        null relative default variance is purely idiosyncratic) is
+        obtained by evaluating its probability generating function
+        \f[
+            G(z) = \prod_s \left(1 - v_s \sum_{k \in s} p_k
+                   (z^{\nu_k} - 1)\right)^{-1/v_s}
+        \f]
+        on the roots of unity and inverting it with a single FFT.  The
+        sector polynomials \f$ \sum_{k \in s} p_k z^{\nu_k} \f$ are
+        themselves transformed by FFT, so that the cost is
+        \f$ O(S\,M \log M) \f$ for \f$ S \f$ sectors and \f$ M \f$
+        loss buckets regardless of the number of obligors, against the
+        \f$ O(M\,\max_k \nu_k) \f$ of the Panjer recursion.  Sectors
+        are processed in parallel when OpenMP is enabled; results
+        don't depend on the number of threads.
+
+        Exposures are rounded to multiples \f$ \nu_k \f$ of the loss
+        unit and the default probabilities are adjusted so as to
+        preserve the expected losses, as in CreditRiskPlus.  With a
+        single sector, the two classes return the same distribution.
+
+        The contributions of the obligors to the loss quantile and to
+        the expected shortfall are the conditional expectations of
+        their losses given the total loss; they add up to the
+        corresponding portfolio figures.
+
+        \warning Losses beyond the last bucket are folded back onto
+                 the grid by the FFT.  By default, the grid covers the
+                 expected loss plus 40 unexpected losses; heavy-tailed
+                 portfolios might need more buckets.
+
+        \test the loss distribution is checked against the Panjer
+              recursion of CreditRiskPlus on a single-sector portfolio
+              and against the analytic moments on a multi-sector one;
+              the contributions are checked to add up to the
+              portfolio figures.
+    */
+    class FFTCreditRiskPlus {
+      public:
+        /*! @param buckets the minimum number of loss buckets, rounded
+                   up to a power of two; if null, it is chosen as
+                   described above.
+        */
+        FFTCreditRiskPlus(const std::vector<Real>& exposure,
+                          const std::vector<Real>& defaultProbability,
+                          const std::vector<Size>& sector,
+                          const std::vector<Real>& relativeDefaultVariance,
+                          Real unit,
+                          Size buckets = 0);
+
+        //! probabilities of the losses \f$ 0, u, 2u, \dots \f$
+        const std::vector<Real>& loss() const { return loss_; }
+        Real unit() const { return unit_; }
+
+        Real exposure() const { return exposureSum_; }
+        Real expectedLoss() const { return el_; }
+        Real unexpectedLoss() const { return ul_; }
+
+        const std::vector<Real>& sectorExposures() const {
+            return sectorExposure_;
+        }
+        const std::vector<Real>& sectorExpectedLoss() const {
+            return sectorEl_;
+        }
+        const std::vector<Real>& sectorUnexpectedLoss() const {
+            return sectorUl_;
+        }
+
+        //! lowest loss whose cumulative probability is at least p
+        Real lossQuantile(Real p) const;
+        //! expected loss, given that it is at least the p-quantile
+        Real expectedShortfall(Real p) const;
+        //! expected obligor losses, given the p-quantile loss
+        Disposable<std::vector<Real> >
+        lossQuantileContributions(Real p) const;
+        //! expected obligor losses, given a loss of at least the p-quantile
+        Disposable<std::vector<Real> >
+        expectedShortfallContributions(Real p) const;
+
+      private:
+        Size quantileIndex(Real p) const;
+        Real tailProbability(Size n) const;
+        // transform of the sector polynomial
+        void sectorTransform(Size s,
+                             std::vector<std::complex<Real> >& q) const;
+        Disposable<std::vector<Real> > contributions(Real p,
+                                                     bool shortfall) const;
+
+        std::vector<Real> exposure_, pd_;
+        std::vector<Size> sector_;
+        std::vector<Real> relativeDefaultVariance_;
+        Real unit_;
+        Size n_, m_; // number of sectors, exposures
+        Size order_;
+
+        // exposures in units and adjusted default probabilities
+        std::vector<Size> nu_;
+        std::vector<Real> pdAdj_;
+        std::vector<std::vector<Size> > sectorObligors_;
+        std::vector<Real> sectorPdSum_;
+
+        std::vector<Real> sectorExposure_, sectorEl_, sectorUl_;
+        Real exposureSum_, el_, ul_;
+
+        // transform of the loss distribution
+        std::vector<std::complex<Real> > pgf_;
+        std::vector<Real> loss_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,535 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/hullwhiteexposuresimulator.hpp>
+#include <ql/instruments/swap.hpp>
+#include <ql/instruments/capfloor.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+
+namespace QuantLib {
+
+    namespace {
+
+        // B(t,T) in P(t,T) = A(t,T) exp(-B(t,T) x(t))
+        Real bondB(Real a, Time t, Time T) {
+            return (1.0 - std::exp(-a*(T-t))) / a;
+        }
+
+        // V(t,T), variance of the integral of x from t to T
+        Real integralVariance(Real a, Real sigma, Time t, Time T) {
+            Time tau = T - t;
+            return sigma*sigma/(a*a) *
+                (tau + 2.0/a*std::exp(-a*tau)
+                 - 0.5/a*std::exp(-2.0*a*tau) - 1.5/a);
+        }
+
+        // index of the given maturity among those of a step
+        Size bondIndex(Time T, std::map<Time, Size>& index,
+                       std::vector<Time>& maturities) {
+            std::map<Time, Size>::const_iterator i = index.find(T);
+            if (i != index.end())
+                return i->second;
+            maturities.push_back(T);
+            return index[T] = maturities.size() - 1;
+        }
+
+    }
+
+    HullWhiteExposureSimulator::HullWhiteExposureSimulator(
+                            const boost::shared_ptr<HullWhite>& model,
+                            const std::vector<NettingSet>& nettingSets,
+                            const std::vector<Date>& exposureDates,
+                            Size samples,
+                            BigNatural seed,
+                            Size blockSize)
+    : model_(model), nettingSets_(nettingSets),
+      exposureDates_(exposureDates), samples_(samples), seed_(seed),
+      blockSize_(blockSize) {
+        QL_REQUIRE(model_, "null model");
+        QL_REQUIRE(!exposureDates_.empty(), "no exposure dates given");
+        for (Size i=1; i<exposureDates_.size(); ++i)
+            QL_REQUIRE(exposureDates_[i] > exposureDates_[i-1],
+                       "exposure dates must be increasing");
+        QL_REQUIRE(samples_ > 0, "null number of samples");
+        QL_REQUIRE(blockSize_ > 0, "null block size");
+        registerWith(model_);
+        registerWith(Settings::instance().evaluationDate());
+    }
+
+    const std::vector<Date>&
+    HullWhiteExposureSimulator::exposureDates() const {
+        return exposureDates_;
+    }
+
+    const std::vector<Time>&
+    HullWhiteExposureSimulator::exposureTimes() const {
+        calculate();
+        return exposureTimes_;
+    }
+
+    Real HullWhiteExposureSimulator::npv(Size nettingSet) const {
+        calculate();
+        QL_REQUIRE(nettingSet < nettingSets_.size(),
+                   "netting set #" << nettingSet << " doesn't exist");
+        return npv_[nettingSet];
+    }
+
+    const std::vector<Real>&
+    HullWhiteExposureSimulator::values(Size nettingSet) const {
+        calculate();
+        QL_REQUIRE(nettingSet < nettingSets_.size(),
+                   "netting set #" << nettingSet << " doesn't exist");
+        return values_[nettingSet];
+    }
+
+    void HullWhiteExposureSimulator::addTrade(
+                             const boost::shared_ptr<Instrument>& trade,
+                             Size nettingSet) const {
+        if (boost::shared_ptr<Swap> swap =
+                                boost::dynamic_pointer_cast<Swap>(trade)) {
+            for (Size j=0; j<swap->numberOfLegs(); ++j) {
+                Real sign = swap->payer(j) ? -1.0 : 1.0;
+                const Leg& leg = swap->leg(j);
+                for (Size i=0; i<leg.size(); ++i)
+                    addCoupon(leg[i], sign, nettingSet);
+            }
+        } else if (boost::shared_ptr<CapFloor> capFloor =
+                          boost::dynamic_pointer_cast<CapFloor>(trade)) {
+            CapFloor::Type type = capFloor->type();
+            const Leg& leg = capFloor->floatingLeg();
+            for (Size i=0; i<leg.size(); ++i) {
+                if (type != CapFloor::Floor)
+                    addCoupon(leg[i], 1.0, nettingSet,
+                              1, capFloor->capRates()[i]);
+                if (type != CapFloor::Cap)
+                    // a collar is long the cap and short the floor
+                    addCoupon(leg[i],
+                              type == CapFloor::Collar ? -1.0 : 1.0,
+                              nettingSet, -1, capFloor->floorRates()[i]);
+            }
+        } else {
+            QL_FAIL("only swaps and caps/floors are supported");
+        }
+    }
+
+    void HullWhiteExposureSimulator::addCoupon(
+                                const boost::shared_ptr<CashFlow>& cashflow,
+                                Real sign, Size nettingSet,
+                                Integer optionType, Rate strike) const {
+        if (cashflow->hasOccurred())
+            return;
+        const boost::shared_ptr<YieldTermStructure>& curve =
+            model_->termStructure().currentLink();
+        Time payment = curve->timeFromReference(cashflow->date());
+
+        boost::shared_ptr<IborCoupon> coupon =
+            boost::dynamic_pointer_cast<IborCoupon>(cashflow);
+        if (!coupon) {
+            QL_REQUIRE(!boost::dynamic_pointer_cast<FloatingRateCoupon>(
+                                                                  cashflow),
+                       "only Ibor floating-rate coupons are supported");
+            QL_REQUIRE(optionType == 0,
+                       "caps and floors must be on Ibor coupons");
+            FixedFlow flow = { nettingSet, payment,
+                               sign * cashflow->amount() };
+            fixedFlows_.push_back(flow);
+            return;
+        }
+
+        Real weight = sign * coupon->nominal() * coupon->accrualPeriod();
+        Real gearing = coupon->gearing();
+        Spread spread = coupon->spread();
+        if (optionType != 0) {
+            QL_REQUIRE(gearing > 0.0,
+                       "caps and floors require positive gearings");
+            // the optionlet on the coupon rate is one on the fixing
+            strike = (strike - spread) / gearing;
+        }
+
+        Date today = Settings::instance().evaluationDate();
+        Time fixing = curve->timeFromReference(coupon->fixingDate());
+        if (coupon->fixingDate() <= today || fixing <= 0.0) {
+            // known (or not stochastic) fixing
+            Rate L = coupon->indexFixing();
+            Real amount = optionType == 0 ?
+                weight * (gearing*L + spread) :
+                weight * gearing * std::max(optionType*(L-strike), 0.0);
+            FixedFlow flow = { nettingSet, payment, amount };
+            fixedFlows_.push_back(flow);
+            return;
+        }
+
+        FloatingFlow flow = {
+            nettingSet, fixing,
+            curve->timeFromReference(coupon->fixingValueDate()),
+            curve->timeFromReference(coupon->fixingEndDate()),
+            payment, weight, gearing, spread, coupon->spanningTime(),
+            optionType, strike };
+        floatingFlows_.push_back(flow);
+    }
+
+    HullWhiteExposureSimulator::Step HullWhiteExposureSimulator::step(
+                                         Time t, Time previous,
+                                         Time numeraireTime,
+                                         Size exposure) const {
+        Real a = model_->a(), sigma = model_->sigma();
+        Time T = numeraireTime, dt = t - previous;
+
+        Step s;
+        s.time = t;
+        // exact transition under the T-forward measure
+        s.decay = std::exp(-a*dt);
+        s.drift = -sigma*sigma/(a*a) * (1.0 - std::exp(-a*dt))
+            + 0.5*sigma*sigma/(a*a) *
+              (std::exp(-a*(T-t)) - std::exp(-a*(T+t-2.0*previous)));
+        s.stdDev = sigma * std::sqrt(0.5*(1.0-std::exp(-2.0*a*dt))/a);
+        s.exposure = exposure;
+        s.numeraire = Null<Size>();
+
+        std::map<Time, Size> index;
+        std::vector<Time> maturities;
+
+        for (Size i=0; i<floatingFlows_.size(); ++i) {
+            const FloatingFlow& f = floatingFlows_[i];
+            if (f.fixing == t) {
+                FloatingTerm term = {
+                    i, bondIndex(f.start, index, maturities),
+                    bondIndex(f.end, index, maturities),
+                    Null<Size>(), 0.0 };
+                s.fixings.push_back(term);
+            }
+        }
+
+        if (exposure != Null<Size>()) {
+            s.numeraire = bondIndex(T, index, maturities);
+            for (Size i=0; i<fixedFlows_.size(); ++i) {
+                if (fixedFlows_[i].payment > t) {
+                    FixedTerm term = {
+                        i, bondIndex(fixedFlows_[i].payment,
+                                     index, maturities) };
+                    s.fixedTerms.push_back(term);
+                }
+            }
+            for (Size i=0; i<floatingFlows_.size(); ++i) {
+                const FloatingFlow& f = floatingFlows_[i];
+                if (f.payment <= t)
+                    continue;
+                FloatingTerm term = {
+                    i, Null<Size>(), Null<Size>(),
+                    bondIndex(f.payment, index, maturities), 0.0 };
+                if (f.fixing > t) {
+                    term.start = bondIndex(f.start, index, maturities);
+                    term.end = bondIndex(f.end, index, maturities);
+                    if (f.optionType != 0)
+                        term.stdDev = sigma *
+                            std::sqrt(0.5*(1.0-std::exp(-2.0*a*(f.fixing-t)))
+                                      / a) *
+                            std::fabs(bondB(a, f.fixing, f.end) -
+                                      bondB(a, f.fixing, f.start));
+                }
+                s.floatingTerms.push_back(term);
+            }
+        }
+
+        const boost::shared_ptr<YieldTermStructure>& curve =
+            model_->termStructure().currentLink();
+        Real logDiscount = std::log(curve->discount(t));
+        Real v0t = integralVariance(a, sigma, 0.0, t);
+        s.logA.resize(maturities.size());
+        s.B.resize(maturities.size());
+        for (Size j=0; j<maturities.size(); ++j) {
+            Time m = maturities[j];
+            s.logA[j] = std::log(curve->discount(m)) - logDiscount
+                + 0.5*(integralVariance(a, sigma, t, m)
+                       - integralVariance(a, sigma, 0.0, m) + v0t);
+            s.B[j] = bondB(a, t, m);
+        }
+        return s;
+    }
+
+    void HullWhiteExposureSimulator::value(
+                                     const Step& step,
+                                     const std::vector<Real>& bonds,
+                                     const std::vector<Real>& fixings,
+                                     std::vector<Real>& values) const {
+        std::fill(values.begin(), values.end(), 0.0);
+        for (Size j=0; j<step.fixedTerms.size(); ++j) {
+            const FixedFlow& f = fixedFlows_[step.fixedTerms[j].flow];
+            values[f.nettingSet] +=
+                f.amount * bonds[step.fixedTerms[j].payment];
+        }
+        for (Size j=0; j<step.floatingTerms.size(); ++j) {
+            const FloatingTerm& term = step.floatingTerms[j];
+            const FloatingFlow& f = floatingFlows_[term.flow];
+            Real discount = bonds[term.payment], v;
+            if (term.start == Null<Size>()) {
+                // fixed on this path
+                Rate L = fixings[term.flow];
+                v = f.optionType == 0 ?
+                    f.gearing*L + f.spread :
+                    f.gearing * std::max(f.optionType*(L-f.strike), 0.0);
+            } else {
+                Real ratio = bonds[term.start] / bonds[term.end];
+                if (f.optionType == 0) {
+                    v = f.gearing*(ratio-1.0)/f.spanningTime + f.spread;
+                } else {
+                    // the ratio is lognormal under the forward measure
+                    // of the end of the index period
+                    Option::Type type =
+                        f.optionType > 0 ? Option::Call : Option::Put;
+                    v = f.gearing / f.spanningTime *
+                        blackFormula(type, 1.0 + f.spanningTime*f.strike,
+                                     ratio, term.stdDev);
+                }
+            }
+            values[f.nettingSet] += f.weight * v * discount;
+        }
+    }
+
+    void HullWhiteExposureSimulator::performCalculations() const {
+        QL_REQUIRE(model_->a() > 0.0,
+                   "positive mean reversion required, "
+                   << model_->a() << " given");
+        const boost::shared_ptr<YieldTermStructure>& curve =
+            model_->termStructure().currentLink();
+
+        Size nSets = nettingSets_.size(), nDates = exposureDates_.size();
+        exposureTimes_.resize(nDates);
+        for (Size k=0; k<nDates; ++k)
+            exposureTimes_[k] = curve->timeFromReference(exposureDates_[k]);
+        QL_REQUIRE(exposureTimes_.front() > 0.0,
+                   "exposure dates must be after the curve reference date");
+
+        fixedFlows_.clear();
+        floatingFlows_.clear();
+        for (Size i=0; i<nSets; ++i)
+            for (Size j=0; j<nettingSets_[i].size(); ++j)
+                addTrade(nettingSets_[i][j], i);
+
+        // the numeraire bond outlives all cash flows and exposure dates
+        Time numeraireTime = exposureTimes_.back();
+        for (Size i=0; i<fixedFlows_.size(); ++i)
+            numeraireTime = std::max(numeraireTime, fixedFlows_[i].payment);
+        for (Size i=0; i<floatingFlows_.size(); ++i)
+            numeraireTime = std::max(numeraireTime,
+                                     floatingFlows_[i].payment);
+
+        // simulation grid: exposure times and the fixing times
+        // affecting them
+        std::set<Time> times(exposureTimes_.begin(), exposureTimes_.end());
+        for (Size i=0; i<floatingFlows_.size(); ++i)
+            if (floatingFlows_[i].fixing < exposureTimes_.back())
+                times.insert(floatingFlows_[i].fixing);
+        steps_.clear();
+        Time previous = 0.0;
+        Size k = 0;
+        for (std::set<Time>::const_iterator t = times.begin();
+             t != times.end(); ++t) {
+            Size exposure = Null<Size>();
+            if (k < nDates && exposureTimes_[k] == *t)
+                exposure = k++;
+            steps_.push_back(step(*t, previous, numeraireTime, exposure));
+            previous = *t;
+        }
+
+        Size maxBonds = 0;
+        for (Size s=0; s<steps_.size(); ++s)
+            maxBonds = std::max(maxBonds, steps_[s].logA.size());
+
+        // values at the evaluation date
+        {
+            Step today = step(0.0, 0.0, numeraireTime, 0);
+            std::vector<Real> bonds(today.logA.size());
+            for (Size j=0; j<bonds.size(); ++j)
+                bonds[j] = std::exp(today.logA[j]);
+            npv_.resize(nSets);
+            value(today, bonds, std::vector<Real>(), npv_);
+        }
+
+        std::vector<DiscountFactor> deflation(nDates);
+        for (Size k=0; k<nDates; ++k)
+            deflation[k] = curve->discount(numeraireTime) /
+                curve->discount(exposureTimes_[k]);
+
+        values_.assign(nSets, std::vector<Real>(nDates*samples_));
+        deflators_.resize(nDates*samples_);
+
+        PseudoRandom::rsg_type rsg =
+            PseudoRandom::make_sequence_generator(steps_.size(), seed_);
+        std::vector<std::vector<Real> > normals(blockSize_);
+        std::vector<std::string> errors(blockSize_);
+        for (Size done=0; done<samples_; done+=blockSize_) {
+            // normals are drawn sequentially, so that the results do
+            // not depend on the number of threads
+            Size block = std::min(blockSize_, samples_-done);
+            for (Size i=0; i<block; ++i)
+                normals[i] = rsg.nextSequence().value;
+
+            // exceptions can't propagate out of the parallel loop
+            #pragma omp parallel for
+            for (long i=0; i<long(block); ++i) {
+                try {
+                    std::vector<Real> bonds(maxBonds);
+                    std::vector<Real> fixings(floatingFlows_.size());
+                    std::vector<Real> v(nSets);
+                    Size path = done + i;
+                    Real x = 0.0;
+                    for (Size s=0; s<steps_.size(); ++s) {
+                        const Step& st = steps_[s];
+                        x = x*st.decay + st.drift + st.stdDev*normals[i][s];
+                        for (Size j=0; j<st.logA.size(); ++j)
+                            bonds[j] = std::exp(st.logA[j] - st.B[j]*x);
+                        for (Size j=0; j<st.fixings.size(); ++j) {
+                            const FloatingTerm& term = st.fixings[j];
+                            fixings[term.flow] =
+                                (bonds[term.start]/bonds[term.end] - 1.0)
+                                / floatingFlows_[term.flow].spanningTime;
+                        }
+                        if (st.exposure == Null<Size>())
+                            continue;
+                        value(st, bonds, fixings, v);
+                        Size position = st.exposure*samples_ + path;
+                        for (Size n=0; n<nSets; ++n)
+                            values_[n][position] = v[n];
+                        deflators_[position] =
+                            deflation[st.exposure] / bonds[st.numeraire];
+                    }
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                }
+            }
+            for (Size i=0; i<block; ++i)
+                QL_REQUIRE(errors[i].empty(), errors[i]);
+        }
+    }
+
+    Real HullWhiteExposureSimulator::exposure(Size nettingSet, Size k,
+                                              Real sign) const {
+        const std::vector<Real>& v = values_[nettingSet];
+        Real sum = 0.0;
+        for (Size i=k*samples_; i<(k+1)*samples_; ++i)
+            sum += std::max(sign*v[i], 0.0) * deflators_[i];
+        return sum / samples_;
+    }
+
+    Disposable<std::vector<Real> >
+    HullWhiteExposureSimulator::expectedExposure(Size nettingSet) const {
+        calculate();
+        QL_REQUIRE(nettingSet < nettingSets_.size(),
+                   "netting set #" << nettingSet << " doesn't exist");
+        std::vector<Real> result(exposureDates_.size());
+        for (Size k=0; k<result.size(); ++k)
+            result[k] = exposure(nettingSet, k, 1.0);
+        return result;
+    }
+
+    Disposable<std::vector<Real> >
+    HullWhiteExposureSimulator::expectedNegativeExposure(
+                                                    Size nettingSet) const {
+        calculate();
+        QL_REQUIRE(nettingSet < nettingSets_.size(),
+                   "netting set #" << nettingSet << " doesn't exist");
+        std::vector<Real> result(exposureDates_.size());
+        for (Size k=0; k<result.size(); ++k)
+            result[k] = exposure(nettingSet, k, -1.0);
+        return result;
+    }
+
+    Disposable<std::vector<Real> >
+    HullWhiteExposureSimulator::potentialFutureExposure(
+                                    Size nettingSet, Real quantile) const {
+        calculate();
+        QL_REQUIRE(nettingSet < nettingSets_.size(),
+                   "netting set #" << nettingSet << " doesn't exist");
+        QL_REQUIRE(quantile >= 0.0 && quantile <= 1.0,
+                   "quantile (" << quantile << ") must be in [0,1]");
+        const std::vector<Real>& v = values_[nettingSet];
+        Size position = std::min<Size>(
+            static_cast<Size>(std::ceil(quantile*samples_)), samples_);
+        position = position > 0 ? position-1 : 0;
+        std::vector<Real> result(exposureDates_.size()), exposures(samples_);
+        for (Size k=0; k<result.size(); ++k) {
+            for (Size i=0; i<samples_; ++i)
+                exposures[i] = std::max(v[k*samples_+i], 0.0);
+            std::nth_element(exposures.begin(),
+                             exposures.begin() + position,
+                             exposures.end());
+            result[k] = exposures[position];
+        }
+        return result;
+    }
+
+    Real HullWhiteExposureSimulator::expectedPositiveExposure(
+                                                    Size nettingSet) const {
+        std::vector<Real> ee = expectedExposure(nettingSet);
+        Real sum = 0.0;
+        Time previous = 0.0;
+        for (Size k=0; k<ee.size(); ++k) {
+            sum += ee[k] * (exposureTimes_[k] - previous);
+            previous = exposureTimes_[k];
+        }
+        return sum / exposureTimes_.back();
+    }
+
+    Real HullWhiteExposureSimulator::adjustment(
+                       Size nettingSet, Real sign,
+                       const Handle<DefaultProbabilityTermStructure>& dts,
+                       Real recoveryRate) const {
+        calculate();
+        QL_REQUIRE(nettingSet < nettingSets_.size(),
+                   "netting set #" << nettingSet << " doesn't exist");
+        QL_REQUIRE(!dts.empty(), "no default curve given");
+        const boost::shared_ptr<YieldTermStructure>& curve =
+            model_->termStructure().currentLink();
+        Real previousExposure = std::max(sign*npv_[nettingSet], 0.0);
+        Probability previousSurvival = 1.0;
+        Real sum = 0.0;
+        for (Size k=0; k<exposureDates_.size(); ++k) {
+            Real discountedExposure = exposure(nettingSet, k, sign) *
+                curve->discount(exposureTimes_[k]);
+            Probability survival =
+                dts->survivalProbability(exposureDates_[k], true);
+            sum += 0.5*(previousExposure + discountedExposure) *
+                (previousSurvival - survival);
+            previousExposure = discountedExposure;
+            previousSurvival = survival;
+        }
+        return (1.0 - recoveryRate) * sum;
+    }
+
+    Real HullWhiteExposureSimulator::cva(
+                   Size nettingSet,
+                   const Handle<DefaultProbabilityTermStructure>& ctptyDTS,
+                   Real ctptyRecoveryRate) const {
+        return adjustment(nettingSet, 1.0, ctptyDTS, ctptyRecoveryRate);
+    }
+
+    Real HullWhiteExposureSimulator::dva(
+                   Size nettingSet,
+                   const Handle<DefaultProbabilityTermStructure>& invstDTS,
+                   Real invstRecoveryRate) const {
+        return adjustment(nettingSet, -1.0, invstDTS, invstRecoveryRate);
+    }
+
+}
@@ -0,0 +1,208 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file hullwhiteexposuresimulator.hpp
+    \brief Monte Carlo exposure profiles of netting sets under Hull-White
+*/
+
+#ifndef quantlib_hull_white_exposure_simulator_hpp
+#define quantlib_hull_white_exposure_simulator_hpp
+
+#include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/termstructures/defaulttermstructure.hpp>
+#include <ql/instrument.hpp>
+#include <ql/cashflow.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/utilities/disposable.hpp>
+
+namespace QuantLib {
+
+    //! Monte Carlo exposure of netting sets of interest-rate trades
+    /*! The state of the Hull-White model is simulated exactly on a grid
+        made of the exposure dates and of the fixing dates of the
+        floating coupons, under the forward measure associated with the
+        last payment of the netting sets.  On each path, all the trades
+        are revalued at each exposure date in closed form: cash flows
+        are discounted with the model zero-coupon bonds, floating
+        coupons are projected on the model curve (fixed ones use the
+        rate simulated at their fixing date) and caplets and floorlets
+        use the Hull-White bond-option formula.
+
+        Supported instruments are swaps whose legs are made of fixed
+        cash flows and Ibor coupons (FRAs can be entered as
+        single-period swaps) and caps, floors and collars on Ibor
+        coupons.  The netting-set values are stored for each path and
+        exposure date; the paths are drawn in blocks and, when OpenMP
+        is enabled, revalued in parallel.
+
+        Unless otherwise stated, expectations are taken under the
+        forward measure of the corresponding exposure date, so that
+        \f$ P(0,t_k)\,EE(t_k) \f$ is the discounted expected exposure.
+        Negative exposures are returned as positive amounts.
+
+        \warning Floating coupons are projected on the model curve,
+                 regardless of the forwarding curve of their index;
+                 coupons paid after the end of their index period are
+                 not convexity-adjusted.
+
+        \test the simulated values of swaps and caps at the
+              evaluation date are checked against analytic prices, and
+              the expected exposure of a swap is checked against the
+              corresponding swaption prices.
+    */
+    class HullWhiteExposureSimulator : public LazyObject {
+      public:
+        typedef std::vector<boost::shared_ptr<Instrument> > NettingSet;
+        HullWhiteExposureSimulator(
+                            const boost::shared_ptr<HullWhite>& model,
+                            const std::vector<NettingSet>& nettingSets,
+                            const std::vector<Date>& exposureDates,
+                            Size samples,
+                            BigNatural seed = 0,
+                            Size blockSize = 1024);
+        //! \name Inspectors
+        //@{
+        const std::vector<Date>& exposureDates() const;
+        const std::vector<Time>& exposureTimes() const;
+        Size samples() const { return samples_; }
+        //@}
+        //! \name Results
+        //@{
+        //! value of a netting set at the evaluation date
+        Real npv(Size nettingSet) const;
+        /*! simulated values of a netting set; the value on the i-th
+            path at the k-th exposure date is stored at the position
+            \f$ k\,n + i \f$, n being the number of samples.
+        */
+        const std::vector<Real>& values(Size nettingSet) const;
+        /*! expected positive exposure
+            \f$ EE(t_k) = E^{t_k}[\max(V(t_k),0)] \f$
+        */
+        Disposable<std::vector<Real> > expectedExposure(
+                                                    Size nettingSet) const;
+        /*! expected negative exposure
+            \f$ ENE(t_k) = E^{t_k}[\max(-V(t_k),0)] \f$
+        */
+        Disposable<std::vector<Real> > expectedNegativeExposure(
+                                                    Size nettingSet) const;
+        /*! potential future exposure, i.e., the given quantile of
+            \f$ \max(V(t_k),0) \f$ under the simulation measure.
+        */
+        Disposable<std::vector<Real> > potentialFutureExposure(
+                                  Size nettingSet, Real quantile) const;
+        /*! time average of the expected exposure from the evaluation
+            date to the last exposure date.
+        */
+        Real expectedPositiveExposure(Size nettingSet) const;
+        /*! unilateral credit value adjustment, i.e., the loss given
+            default times the discounted expected exposure integrated
+            over the counterparty default probability; the exposure
+            is interpolated linearly between exposure dates.
+        */
+        Real cva(Size nettingSet,
+                 const Handle<DefaultProbabilityTermStructure>& ctptyDTS,
+                 Real ctptyRecoveryRate) const;
+        /*! unilateral debit value adjustment, as above with the
+            negative exposure and the investor default probability.
+        */
+        Real dva(Size nettingSet,
+                 const Handle<DefaultProbabilityTermStructure>& invstDTS,
+                 Real invstRecoveryRate) const;
+        //@}
+      private:
+        // fixed amount paid at a given time
+        struct FixedFlow {
+            Size nettingSet;
+            Time payment;
+            Real amount;
+        };
+        // Ibor coupon, caplet or floorlet
+        struct FloatingFlow {
+            Size nettingSet;
+            Time fixing, start, end, payment;
+            // signed nominal times accrual period
+            Real weight;
+            Real gearing, spread, spanningTime;
+            // 0 for coupons, 1 for caplets, -1 for floorlets
+            Integer optionType;
+            // optionlet strike on the index fixing
+            Rate strike;
+        };
+        // flows alive at a simulation time, with the indices of the
+        // needed bonds among those of the time
+        struct FixedTerm {
+            Size flow, payment;
+        };
+        struct FloatingTerm {
+            // start and end are Null<Size>() once the flow is fixed
+            Size flow, start, end, payment;
+            // standard deviation of the log bond ratio up to fixing
+            Real stdDev;
+        };
+        struct Step {
+            Time time;
+            // transition of the state from the previous time
+            Real decay, drift, stdDev;
+            // P(t,T) = exp(logA - B x)
+            std::vector<Real> logA, B;
+            // exposure index, or Null<Size>()
+            Size exposure;
+            Size numeraire;
+            std::vector<FixedTerm> fixedTerms;
+            std::vector<FloatingTerm> floatingTerms;
+            // flows fixing at this time
+            std::vector<FloatingTerm> fixings;
+        };
+
+        void performCalculations() const;
+        void addTrade(const boost::shared_ptr<Instrument>& trade,
+                      Size nettingSet) const;
+        void addCoupon(const boost::shared_ptr<CashFlow>& cashflow,
+                       Real sign, Size nettingSet,
+                       Integer optionType = 0, Rate strike = 0.0) const;
+        Step step(Time t, Time previous, Time numeraireTime,
+                  Size exposure) const;
+        void value(const Step& step,
+                   const std::vector<Real>& bonds,
+                   const std::vector<Real>& fixings,
+                   std::vector<Real>& values) const;
+        Real exposure(Size nettingSet, Size k, Real sign) const;
+        Real adjustment(Size nettingSet, Real sign,
+                        const Handle<DefaultProbabilityTermStructure>& dts,
+                        Real recoveryRate) const;
+
+        boost::shared_ptr<HullWhite> model_;
+        std::vector<NettingSet> nettingSets_;
+        std::vector<Date> exposureDates_;
+        Size samples_;
+        BigNatural seed_;
+        Size blockSize_;
+        mutable std::vector<Time> exposureTimes_;
+        mutable std::vector<FixedFlow> fixedFlows_;
+        mutable std::vector<FloatingFlow> floatingFlows_;
+        mutable std::vector<Step> steps_;
+        mutable std::vector<Real> npv_;
+        mutable std::vector<std::vector<Real> > values_;
+        // P(0,T)/(P(0,t_k) P(t_k,T)) on each path, T being the
+        // maturity of the numeraire bond
+        mutable std::vector<Real> deflators_;
+    };
+
+}
+
+
+#endif
@@ -0,0 +1,192 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/scenarioanalysis.hpp>
+#include <string>
+
+using std::vector;
+using boost::shared_ptr;
+
+namespace QuantLib {
+
+    namespace {
+
+        // records whether the observed instrument was notified
+        class NotificationFlag : public Observer {
+          public:
+            NotificationFlag() : notified(false) {}
+            void update() { notified = true; }
+            bool notified;
+        };
+
+    }
+
+    ScenarioAnalysis::ScenarioAnalysis(const vector<Portfolio>& copies)
+    : copies_(copies) {
+        QL_REQUIRE(!copies_.empty(), "no portfolio given");
+        nQuotes_ = copies_[0].quotes.size();
+        nInstruments_ = copies_[0].instruments.size();
+        for (Size c=0; c<copies_.size(); ++c) {
+            QL_REQUIRE(copies_[c].quotes.size() == nQuotes_,
+                       "copy #" << c << " has " << copies_[c].quotes.size()
+                       << " quotes instead of " << nQuotes_);
+            QL_REQUIRE(copies_[c].instruments.size() == nInstruments_,
+                       "copy #" << c << " has "
+                       << copies_[c].instruments.size()
+                       << " instruments instead of " << nInstruments_);
+            for (Size i=0; i<nQuotes_; ++i)
+                QL_REQUIRE(!copies_[c].quotes[i].empty(),
+                           "empty handle for quote #" << i);
+        }
+
+        // Lazy objects only forward the notifications they receive
+        // when calculated, so the instruments are calculated before
+        // each quote notifies its observers.
+        const Portfolio& portfolio = copies_[0];
+        vector<shared_ptr<NotificationFlag> > flags(nInstruments_);
+        for (Size j=0; j<nInstruments_; ++j) {
+            flags[j] = shared_ptr<NotificationFlag>(new NotificationFlag);
+            flags[j]->registerWith(portfolio.instruments[j]);
+            portfolio.instruments[j]->NPV();
+        }
+        dependencies_.resize(nQuotes_);
+        for (Size i=0; i<nQuotes_; ++i) {
+            for (Size j=0; j<nInstruments_; ++j)
+                flags[j]->notified = false;
+            portfolio.quotes[i]->notifyObservers();
+            for (Size j=0; j<nInstruments_; ++j) {
+                if (flags[j]->notified) {
+                    dependencies_[i].push_back(j);
+                    portfolio.instruments[j]->NPV();
+                }
+            }
+        }
+    }
+
+    Disposable<vector<Real> > ScenarioAnalysis::npvs() const {
+        vector<Real> result(nInstruments_);
+        for (Size j=0; j<nInstruments_; ++j)
+            result[j] = copies_[0].instruments[j]->NPV();
+        return result;
+    }
+
+    void ScenarioAnalysis::evaluate(const Portfolio& portfolio,
+                                    const Matrix& shifts, Size scenario,
+                                    const vector<Real>& baseNPVs,
+                                    Matrix& result) const {
+        vector<Real> quoteValues(nQuotes_, Null<Real>());
+        vector<bool> affected(nInstruments_, false);
+        try {
+            for (Size i=0; i<nQuotes_; ++i) {
+                const Handle<SimpleQuote>& quote = portfolio.quotes[i];
+                Real shift = shifts[scenario][i];
+                if (shift == 0.0 || !quote->isValid())
+                    continue;
+                quoteValues[i] = quote->value();
+                quote->setValue(quoteValues[i]+shift);
+                for (Size k=0; k<dependencies_[i].size(); ++k)
+                    affected[dependencies_[i][k]] = true;
+            }
+            for (Size j=0; j<nInstruments_; ++j)
+                if (affected[j])
+                    result[scenario][j] =
+                        portfolio.instruments[j]->NPV() - baseNPVs[j];
+        } catch (...) {
+            for (Size i=0; i<nQuotes_; ++i)
+                if (quoteValues[i] != Null<Real>())
+                    portfolio.quotes[i]->setValue(quoteValues[i]);
+            throw;
+        }
+        for (Size i=0; i<nQuotes_; ++i)
+            if (quoteValues[i] != Null<Real>())
+                portfolio.quotes[i]->setValue(quoteValues[i]);
+    }
+
+    Disposable<Matrix> ScenarioAnalysis::scenarios(
+                                              const Matrix& shifts) const {
+        QL_REQUIRE(shifts.columns() == nQuotes_,
+                   "wrong number of shifts (" << shifts.columns()
+                   << ") for " << nQuotes_ << " quotes");
+        Size nScenarios = shifts.rows(), nCopies = copies_.size();
+        Matrix result(nScenarios, nInstruments_, 0.0);
+        vector<std::string> errors(nCopies);
+        // each copy evaluates every nCopies-th scenario; exceptions
+        // can't propagate out of the parallel loop
+        #pragma omp parallel for
+        for (long c=0; c<long(nCopies); ++c) {
+            try {
+                const Portfolio& portfolio = copies_[c];
+                vector<Real> baseNPVs(nInstruments_);
+                for (Size j=0; j<nInstruments_; ++j)
+                    baseNPVs[j] = portfolio.instruments[j]->NPV();
+                for (Size s=c; s<nScenarios; s+=nCopies)
+                    evaluate(portfolio, shifts, s, baseNPVs, result);
+            } catch (std::exception& e) {
+                errors[c] = e.what();
+            }
+        }
+        for (Size c=0; c<nCopies; ++c)
+            QL_REQUIRE(errors[c].empty(), errors[c]);
+        return result;
+    }
+
+    std::pair<Matrix, Matrix>
+    ScenarioAnalysis::bucketAnalysis(Real shift,
+                                     SensitivityAnalysis type) const {
+        QL_REQUIRE(shift != 0.0, "zero shift not allowed");
+        Size nShifts;
+        switch (type) {
+          case OneSide:
+            nShifts = 1;
+            break;
+          case Centered:
+            nShifts = 2;
+            break;
+          default:
+            QL_FAIL("unknown SensitivityAnalysis (" << Integer(type) << ")");
+        }
+
+        // up shifts first, then down shifts
+        Matrix shifts(nShifts*nQuotes_, nQuotes_, 0.0);
+        for (Size i=0; i<nQuotes_; ++i) {
+            shifts[i][i] = shift;
+            if (type == Centered)
+                shifts[nQuotes_+i][i] = -shift;
+        }
+        Matrix changes = scenarios(shifts);
+
+        std::pair<Matrix, Matrix> result;
+        result.first = Matrix(nQuotes_, nInstruments_);
+        if (type == OneSide) {
+            result.second = Matrix(nQuotes_, nInstruments_, Null<Real>());
+            for (Size i=0; i<nQuotes_; ++i)
+                for (Size j=0; j<nInstruments_; ++j)
+                    result.first[i][j] = changes[i][j]/shift;
+        } else {
+            result.second = Matrix(nQuotes_, nInstruments_);
+            for (Size i=0; i<nQuotes_; ++i) {
+                for (Size j=0; j<nInstruments_; ++j) {
+                    Real up = changes[i][j], down = changes[nQuotes_+i][j];
+                    result.first[i][j] = (up-down)/(2.0*shift);
+                    result.second[i][j] = (up+down)/(shift*shift);
+                }
+            }
+        }
+        return result;
+    }
+
+}
@@ -0,0 +1,107 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file scenarioanalysis.hpp
+    \brief scenario and bucket sensitivity analysis on portfolio copies
+*/
+
+#ifndef quantlib_scenario_analysis_hpp
+#define quantlib_scenario_analysis_hpp
+
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/instrument.hpp>
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! scenario analysis of a set of instruments
+    /*! Scenarios are given as a matrix of absolute shifts, with a
+        row for each scenario and a column for each quote; the result
+        is the matrix of the changes in the NPV of each instrument.
+
+        At construction, each quote is made to notify its observers
+        once to find out which instruments depend on it; afterwards,
+        only the instruments depending on at least one of the shifted
+        quotes of a scenario are revalued.
+
+        The quotes and instruments can be passed in several
+        independent copies, i.e., copies not sharing any observable
+        (quotes, term structures, indexes or pricing engines).  In
+        this case the scenarios are distributed among the copies
+        and, when OpenMP is enabled, evaluated in parallel with one
+        thread per copy; the results don't depend on the number of
+        copies.
+
+        \warning The copies can still share singletons such as the
+                 global evaluation date and the index fixings, which
+                 must not be changed during the analysis; pricing
+                 engines must not modify shared data either.
+
+        \warning The dependencies are calculated once: if the
+                 instruments are relinked to different market objects,
+                 a new analysis must be created.
+    */
+    class ScenarioAnalysis {
+      public:
+        struct Portfolio {
+            std::vector<Handle<SimpleQuote> > quotes;
+            std::vector<boost::shared_ptr<Instrument> > instruments;
+        };
+        explicit ScenarioAnalysis(const std::vector<Portfolio>& copies);
+        //! \name Inspectors
+        //@{
+        Size numberOfQuotes() const { return nQuotes_; }
+        Size numberOfInstruments() const { return nInstruments_; }
+        Size numberOfCopies() const { return copies_.size(); }
+        //! indices of the instruments depending on each quote
+        const std::vector<std::vector<Size> >& dependencies() const {
+            return dependencies_;
+        }
+        //@}
+        //! \name Analysis
+        //@{
+        //! NPVs of the instruments with the current quote values
+        Disposable<std::vector<Real> > npvs() const;
+        /*! returns the change of the NPV of each instrument (columns)
+            under each scenario (rows); the quotes are restored to
+            their current values afterwards.
+        */
+        Disposable<Matrix> scenarios(const Matrix& shifts) const;
+        /*! bucket sensitivities of each instrument (columns) to each
+            quote (rows), calculated as prescribed by
+            SensitivityAnalysis. The second derivatives are null in
+            the one-sided case.  The sensitivities to invalid quotes
+            are zero.
+        */
+        std::pair<Matrix, Matrix> bucketAnalysis(
+                                    Real shift = 0.0001,
+                                    SensitivityAnalysis type = Centered) const;
+        //@}
+      private:
+        void evaluate(const Portfolio& copy,
+                      const Matrix& shifts, Size scenario,
+                      const std::vector<Real>& baseNPVs,
+                      Matrix& result) const;
+        std::vector<Portfolio> copies_;
+        Size nQuotes_, nInstruments_;
+        std::vector<std::vector<Size> > dependencies_;
+    };
+
+}
+
+#endif
@@ -92,10 +92,15 @@ namespace QuantLib {
             QL_REQUIRE(npvDateDiscount_ != Null<Real>(), "result not available");
             return npvDateDiscount_;
         }
+        Size numberOfLegs() const { return legs_.size(); }
         const Leg& leg(Size j) const {
             QL_REQUIRE(j<legs_.size(), "leg #" << j << " doesn't exist!");
             return legs_[j];
         }
+        bool payer(Size j) const {
+            QL_REQUIRE(j<legs_.size(), "leg #" << j << " doesn't exist!");
+            return payer_[j] < 0.0;
+        }
         //@}
       protected:
         //! \name Constructors
@@ -24,6 +24,7 @@
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fdbermudanengine.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/exercise.hpp>
 #include <boost/scoped_ptr.hpp>
 
@@ -50,6 +51,33 @@ namespace QuantLib {
         boost::shared_ptr<GeneralizedBlackScholesProcess> newProcess =
             detail::ImpliedVolatilityHelper::clone(process, volQuote);
 
+        // European plain-vanilla options can be inverted in closed
+        // form; if that fails, e.g. because the target value is out
+        // of range, we fall back on the solver below, which also
+        // takes care of reporting the error.
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(payoff_);
+        if (exercise_->type() == Exercise::European && payoff) {
+            try {
+                Date maturity = exercise_->lastDate();
+                Time t = newProcess->blackVolatility()->timeFromReference(
+                                                                  maturity);
+                DiscountFactor riskFreeDiscount =
+                    newProcess->riskFreeRate()->discount(maturity);
+                DiscountFactor dividendDiscount =
+                    newProcess->dividendYield()->discount(maturity);
+                Real forward = newProcess->stateVariable()->value() *
+                    dividendDiscount / riskFreeDiscount;
+                if (t > 0.0) {
+                    Volatility vol = blackFormulaImpliedStdDevHouseholder(
+                        payoff, forward, targetValue, riskFreeDiscount)
+                        / std::sqrt(t);
+                    if (vol >= minVol && vol <= maxVol)
+                        return vol;
+                }
+            } catch (std::exception&) {}
+        }
+
         // engines are built-in for the time being
         boost::scoped_ptr<PricingEngine> engine;
         switch (exercise_->type()) {
@@ -14,6 +14,7 @@
 #include <ql/math/fastfouriertransform.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
 #include <ql/math/kernelfunctions.hpp>
 #include <ql/math/incompletegamma.hpp>
 #include <ql/math/interpolation.hpp>
@@ -29,6 +29,7 @@
 #endif
 
 #include <boost/math/distributions/normal.hpp>
+#include <algorithm>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic pop
@@ -126,6 +127,57 @@ namespace QuantLib {
         return z;
     }
 
+    namespace {
+
+        // number of values processed together by the bulk transforms;
+        // small enough to keep the working set in the L1 cache
+        const Size blockSize = 64;
+
+    }
+
+    void InverseCumulativeNormal::standard_values(const Real* begin,
+                                                  const Real* end,
+                                                  Real* out) {
+        Real x[blockSize];
+        while (begin != end) {
+            Size n = std::min<Size>(end-begin, blockSize);
+            std::copy(begin, begin+n, x);
+            // central region for all values, without branches
+            for (Size i=0; i<n; ++i) {
+                Real z = x[i] - 0.5;
+                Real r = z*z;
+                out[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                    (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+            }
+            // tails for the few values that need them
+            for (Size i=0; i<n; ++i) {
+                if (x[i] < x_low_ || x_high_ < x[i])
+                    out[i] = tail_value(x[i]);
+            }
+            #ifdef REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+            for (Size i=0; i<n; ++i) {
+                Real z = out[i];
+                const Real r =
+                    (f_(z) - x[i]) * M_SQRT2 * M_SQRTPI * exp(0.5 * z*z);
+                out[i] = z - r/(1+0.5*z*r);
+            }
+            #endif
+            begin += n;
+            out += n;
+        }
+    }
+
+    void InverseCumulativeNormal::transform(const Real* begin,
+                                            const Real* end,
+                                            Real* out) const {
+        standard_values(begin, end, out);
+        if (average_ != 0.0 || sigma_ != 1.0) {
+            Size n = end-begin;
+            for (Size i=0; i<n; ++i)
+                out[i] = average_ + sigma_*out[i];
+        }
+    }
+
     const Real MoroInverseCumulativeNormal::a0_ =  2.50662823884;
     const Real MoroInverseCumulativeNormal::a1_ =-18.61500062529;
     const Real MoroInverseCumulativeNormal::a2_ = 41.39119773534;
@@ -177,6 +229,33 @@ namespace QuantLib {
         return average_ + result*sigma_;
     }
 
+    void MoroInverseCumulativeNormal::transform(const Real* begin,
+                                                const Real* end,
+                                                Real* out) const {
+        Real x[blockSize];
+        while (begin != end) {
+            Size n = std::min<Size>(end-begin, blockSize);
+            std::copy(begin, begin+n, x);
+            // Beasley and Springer for all values, without branches
+            for (Size i=0; i<n; ++i) {
+                Real temp = x[i]-0.5;
+                Real r = temp*temp;
+                out[i] = temp*
+                    (((a3_*r+a2_)*r+a1_)*r+a0_) /
+                    ((((b3_*r+b2_)*r+b1_)*r+b0_)*r+1.0);
+            }
+            // tails and checks for the values that need them
+            for (Size i=0; i<n; ++i) {
+                if (!(std::fabs(x[i]-0.5) < 0.42))
+                    out[i] = (*this)(x[i]);
+                else
+                    out[i] = average_ + out[i]*sigma_;
+            }
+            begin += n;
+            out += n;
+        }
+    }
+
     MaddockInverseCumulativeNormal::MaddockInverseCumulativeNormal(
         Real average, Real sigma)
     : average_(average), sigma_(sigma) {}
@@ -136,6 +136,21 @@ namespace QuantLib {
 
             return z;
         }
+        /*! applies the transform to the values in [begin,end) and
+            writes the results starting at out, which can coincide
+            with begin.
+
+            The values are processed in blocks; the central-region
+            approximation is applied to the whole block in a loop
+            without branches, which compilers can vectorize, and only
+            the values in the tails (about 5% for uniform deviates)
+            are then corrected. The results are the same as those of
+            operator().
+        */
+        void transform(const Real* begin, const Real* end, Real* out) const;
+        //! as above, for average=0 and sigma=1
+        static void standard_values(const Real* begin, const Real* end,
+                                    Real* out);
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
@@ -204,6 +219,11 @@ namespace QuantLib {
                                     Real sigma   = 1.0);
         // function
         Real operator()(Real x) const;
+        /*! applies the transform to the values in [begin,end) and
+            writes the results starting at out, which can coincide
+            with begin; see InverseCumulativeNormal::transform.
+        */
+        void transform(const Real* begin, const Real* end, Real* out) const;
       private:
         Real average_, sigma_;
         static const Real a0_;
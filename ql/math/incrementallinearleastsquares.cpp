@@ -0,0 +1,104 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/incrementallinearleastsquares.hpp>
+
+namespace QuantLib {
+
+    IncrementalLinearLeastSquares::IncrementalLinearLeastSquares(
+                                                            Size dimension) {
+        reset(dimension);
+    }
+
+    Disposable<Array> IncrementalLinearLeastSquares::coefficients() const {
+        const Size m = dimension();
+        Array a(m, 0.0);
+
+        Real maxDiagonal = 0.0;
+        for (Size i=0; i<m; ++i)
+            maxDiagonal = std::max(maxDiagonal, std::fabs(r_[i][i]));
+        const Real threshold = n_ * QL_EPSILON * maxDiagonal;
+
+        // back substitution, skipping negligible pivots
+        for (Size i=m; i>0; --i) {
+            const Size k = i-1;
+            if (std::fabs(r_[k][k]) > threshold) {
+                Real sum = z_[k];
+                for (Size j=k+1; j<m; ++j)
+                    sum -= r_[k][j]*a[j];
+                a[k] = sum/r_[k][k];
+            }
+        }
+        return a;
+    }
+
+    void IncrementalLinearLeastSquares::merge(
+                                  const IncrementalLinearLeastSquares& other) {
+        QL_REQUIRE(other.dimension() == dimension(),
+                   "dimension mismatch: " << dimension() << " required, "
+                   << other.dimension() << " provided");
+        // stacking the two triangular factors gives the same
+        // normal equations as stacking the two design matrices
+        const Size m = dimension();
+        for (Size i=0; i<m; ++i) {
+            for (Size j=0; j<i; ++j)
+                row_[j] = 0.0;
+            for (Size j=i; j<m; ++j)
+                row_[j] = other.r_[i][j];
+            rotate(i, other.z_[i]);
+        }
+        n_ += other.n_;
+    }
+
+    void IncrementalLinearLeastSquares::reset(Size dimension) {
+        n_ = 0;
+        r_ = Matrix(dimension, dimension, 0.0);
+        z_ = Array(dimension, 0.0);
+        row_ = Array(dimension, 0.0);
+    }
+
+    void IncrementalLinearLeastSquares::rotate(Size first, Real y) {
+        // Givens rotations annihilating row_ against the rows of R
+        const Size m = dimension();
+        for (Size i=first; i<m; ++i) {
+            const Real x = row_[i];
+            if (x == 0.0)
+                continue;
+            const Real d = r_[i][i];
+            if (d == 0.0) {
+                // empty row in R: the observation takes its place
+                for (Size j=i; j<m; ++j) {
+                    r_[i][j] = row_[j];
+                    row_[j] = 0.0;
+                }
+                z_[i] = y;
+                return;
+            }
+            const Real h = std::sqrt(d*d + x*x);
+            const Real c = d/h, s = x/h;
+            for (Size j=i; j<m; ++j) {
+                const Real t = r_[i][j];
+                r_[i][j] = c*t + s*row_[j];
+                row_[j] = c*row_[j] - s*t;
+            }
+            const Real t = z_[i];
+            z_[i] = c*t + s*y;
+            y = c*y - s*t;
+        }
+    }
+
+}
@@ -0,0 +1,94 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file incrementallinearleastsquares.hpp
+    \brief linear least squares regression with incremental updates
+*/
+
+#ifndef quantlib_incremental_linear_least_squares_hpp
+#define quantlib_incremental_linear_least_squares_hpp
+
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! linear least squares regression with incremental updates
+    /*! Observations are added one at a time as the values
+        \f$ (v_1(x), \dots, v_m(x)) \f$ of the basis functions
+        together with the corresponding target \f$ y \f$.  The
+        triangular factor \f$ R \f$ of the QR decomposition of the
+        design matrix and the transformed targets \f$ Q^T y \f$ are
+        updated by means of Givens rotations; therefore, memory
+        requirements are \f$ O(m^2) \f$ regardless of the number of
+        observations, and the accuracy is that of a QR solution since
+        normal equations are never formed.
+
+        Two instances can be merged, so that the observations can be
+        split among several threads.
+
+        Coefficients corresponding to diagonal elements of \f$ R \f$
+        below \f$ n \epsilon \max_i |R_{ii}| \f$ (with \f$ n \f$ the
+        number of observations) are set to zero, which gives a basic
+        solution when the basis functions are linearly dependent on
+        the sample.
+    */
+    class IncrementalLinearLeastSquares {
+      public:
+        explicit IncrementalLinearLeastSquares(Size dimension = 0);
+        //! \name Inspectors
+        //@{
+        //! number of basis functions
+        Size dimension() const { return z_.size(); }
+        //! number of observations
+        Size size() const { return n_; }
+        //! regression coefficients
+        Disposable<Array> coefficients() const;
+        //@}
+        //! \name Modifiers
+        //@{
+        //! adds an observation, possibly with a weight
+        /*! \pre weight must be positive or null */
+        template <class Iterator>
+        void add(Iterator vBegin, Iterator vEnd,
+                 Real y, Real weight = 1.0) {
+            QL_REQUIRE(Size(std::distance(vBegin, vEnd)) == dimension(),
+                       "wrong number of basis values: " << dimension()
+                       << " required, " << std::distance(vBegin, vEnd)
+                       << " provided");
+            QL_REQUIRE(weight >= 0.0, "negative weight not allowed");
+            Real sw = std::sqrt(weight);
+            for (Size i=0; vBegin!=vEnd; ++vBegin, ++i)
+                row_[i] = sw * (*vBegin);
+            ++n_;
+            rotate(0, sw * y);
+        }
+        //! adds the observations collected by another instance
+        void merge(const IncrementalLinearLeastSquares& other);
+        //! removes all observations
+        void reset(Size dimension);
+        //@}
+      private:
+        void rotate(Size first, Real y);
+        Size n_;
+        Matrix r_;
+        Array z_, row_;
+    };
+
+}
+
+
+#endif
@@ -30,6 +30,7 @@
 #include <ql/math/randomnumbers/haltonrsg.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/primenumbers.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -74,5 +75,20 @@ namespace QuantLib {
         return sequence_;
     }
 
+    void HaltonRsg::nextSequences(Size samples,
+                                  std::vector<Real>& values) const {
+        values.resize(samples*dimensionality_);
+        std::vector<Real>::iterator out = values.begin();
+        for (Size i=0; i<samples; ++i) {
+            const std::vector<Real>& v = nextSequence().value;
+            out = std::copy(v.begin(), v.end(), out);
+        }
+    }
+
+    void HaltonRsg::skipTo(unsigned long n) {
+        // each sample only depends on the counter
+        sequenceCounter_ = n;
+    }
+
 }
 
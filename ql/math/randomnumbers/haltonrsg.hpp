@@ -48,6 +48,11 @@ namespace QuantLib {
                   bool randomStart = true,
                   bool randomShift = false);
         const sample_type& nextSequence() const;
+        /*! fills the buffer with the next \f$ n \f$ samples, stored
+            one after the other; see SobolRsg::nextSequences() */
+        void nextSequences(Size samples, std::vector<Real>& values) const;
+        /*! skip to the n-th sample in the low-discrepancy sequence */
+        void skipTo(unsigned long n);
         const sample_type& lastSequence() const {
             return sequence_;
         }
@@ -26,10 +26,43 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <vector>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // applies the inverse cumulative distribution to a range;
+        // the overloads below use the bulk transforms when available
+        template <class IC>
+        inline void inverseCumulativeTransform(const IC& ic,
+                                               const Real* begin,
+                                               const Real* end,
+                                               Real* out) {
+            for (; begin != end; ++begin, ++out)
+                *out = ic(*begin);
+        }
+
+        inline void inverseCumulativeTransform(
+                                       const InverseCumulativeNormal& ic,
+                                       const Real* begin,
+                                       const Real* end,
+                                       Real* out) {
+            ic.transform(begin, end, out);
+        }
+
+        inline void inverseCumulativeTransform(
+                                   const MoroInverseCumulativeNormal& ic,
+                                   const Real* begin,
+                                   const Real* end,
+                                   Real* out) {
+            ic.transform(begin, end, out);
+        }
+
+    }
+
     //! Inverse cumulative random sequence generator
     /*! It uses a sequence of uniform deviate in (0, 1) as the
         source of cumulative distribution values.
@@ -44,6 +77,9 @@ namespace QuantLib {
             Size USG::dimension() const;
         \endcode
 
+        The skipTo() and nextSequences() methods are only available
+        if USG provides them with the same signature.
+
         The inverse cumulative distribution is supplied by IC.
 
         Class IC must implement the following interface:
@@ -61,6 +97,19 @@ namespace QuantLib {
                              const IC& inverseCumulative);
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
+        /*! fills the buffer with the next \f$ n \f$ samples, stored
+            one after the other; the uniform samples are generated
+            as a block and converted in place.
+
+            \warning sample weights are not returned; this is meant
+                     for uniform generators with unit weights, such
+                     as low-discrepancy sequences.
+        */
+        void nextSequences(Size samples, std::vector<Real>& values) const;
+        //! skips to the n-th sample of the underlying sequence
+        void skipTo(unsigned long n) {
+            uniformSequenceGenerator_.skipTo(n);
+        }
         const sample_type& lastSequence() const { return x_; }
         Size dimension() const { return dimension_; }
       private:
@@ -87,15 +136,28 @@ namespace QuantLib {
     template <class USG, class IC>
     inline const typename InverseCumulativeRsg<USG, IC>::sample_type&
     InverseCumulativeRsg<USG, IC>::nextSequence() const {
-        typename USG::sample_type sample =
+        const typename USG::sample_type& sample =
             uniformSequenceGenerator_.nextSequence();
         x_.weight = sample.weight;
-        for (Size i = 0; i < dimension_; i++) {
-            x_.value[i] = ICD_(sample.value[i]);
-        }
+        const Real* u = &sample.value[0];
+        detail::inverseCumulativeTransform(ICD_, u, u+dimension_,
+                                           &x_.value[0]);
         return x_;
     }
 
+    template <class USG, class IC>
+    inline void InverseCumulativeRsg<USG, IC>::nextSequences(
+                             Size samples, std::vector<Real>& values) const {
+        uniformSequenceGenerator_.nextSequences(samples, values);
+        if (samples > 0) {
+            Real* u = &values[0];
+            detail::inverseCumulativeTransform(ICD_, u, u+values.size(), u);
+            std::copy(values.end()-dimension_, values.end(),
+                      x_.value.begin());
+            x_.weight = 1.0;
+        }
+    }
+
 }
 
 
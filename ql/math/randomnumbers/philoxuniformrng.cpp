@@ -0,0 +1,95 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/randomnumbers/philoxuniformrng.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        const boost::uint32_t multiplier0 = 0xD2511F53UL;
+        const boost::uint32_t multiplier1 = 0xCD9E8D57UL;
+        // Weyl sequence increments for the key schedule
+        const boost::uint32_t increment0 = 0x9E3779B9UL;
+        const boost::uint32_t increment1 = 0xBB67AE85UL;
+        const Size rounds = 10;
+
+        inline boost::uint32_t low(boost::uint64_t x) {
+            return boost::uint32_t(x & 0xFFFFFFFFUL);
+        }
+
+        inline boost::uint32_t high(boost::uint64_t x) {
+            return boost::uint32_t(x >> 32);
+        }
+
+    }
+
+    PhiloxUniformRng::PhiloxUniformRng(BigNatural seed, BigNatural stream)
+    : stream_(stream), counter_(0), index_(0) {
+        boost::uint64_t s =
+            (seed != 0 ? seed : SeedGenerator::instance().get());
+        key_[0] = low(s);
+        key_[1] = high(s);
+        refill();
+    }
+
+    void PhiloxUniformRng::block(const boost::uint32_t key[2],
+                                 const boost::uint32_t counter[4],
+                                 boost::uint32_t result[4]) {
+        boost::uint32_t k0 = key[0], k1 = key[1];
+        boost::uint32_t c0 = counter[0], c1 = counter[1],
+                        c2 = counter[2], c3 = counter[3];
+        for (Size i=0; i<rounds; ++i) {
+            boost::uint64_t p0 = boost::uint64_t(multiplier0)*c0;
+            boost::uint64_t p1 = boost::uint64_t(multiplier1)*c2;
+            c0 = high(p1) ^ c1 ^ k0;
+            c1 = low(p1);
+            c2 = high(p0) ^ c3 ^ k1;
+            c3 = low(p0);
+            k0 += increment0;
+            k1 += increment1;
+        }
+        result[0] = c0;
+        result[1] = c1;
+        result[2] = c2;
+        result[3] = c3;
+    }
+
+    void PhiloxUniformRng::refill() const {
+        boost::uint64_t s = stream_;
+        boost::uint32_t counter[4] = {
+            low(counter_), high(counter_), low(s), high(s)
+        };
+        block(key_, counter, buffer_);
+        index_ = 0;
+    }
+
+    void PhiloxUniformRng::nextReals(Size n,
+                                     std::vector<Real>& values) const {
+        values.resize(n);
+        for (Size i=0; i<n; ++i)
+            values[i] = nextReal();
+    }
+
+    void PhiloxUniformRng::skipTo(BigNatural n) {
+        counter_ = n/4;
+        refill();
+        index_ = n%4;
+    }
+
+}
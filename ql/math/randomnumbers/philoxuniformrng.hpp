@@ -0,0 +1,96 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file philoxuniformrng.hpp
+    \brief Philox counter-based uniform random number generator
+*/
+
+#ifndef quantlib_philox_uniform_rng_hpp
+#define quantlib_philox_uniform_rng_hpp
+
+#include <ql/methods/montecarlo/sample.hpp>
+#include <boost/cstdint.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Counter-based uniform random number generator
+    /*! Philox-4x32-10 generator by J. K. Salmon, M. A. Moraes,
+        R. O. Dror and D. E. Shaw, "Parallel random numbers: as easy
+        as 1, 2, 3", Proceedings of the International Conference for
+        High Performance Computing (2011).
+
+        The n-th number of a stream is obtained by encrypting the
+        counter n/4 together with the stream number under a key given
+        by the seed, and taking the (n mod 4)-th of the resulting four
+        words. Therefore, any number can be accessed in constant time
+        and different streams are independent; this makes it possible
+        to assign a stream to each path of a Monte Carlo simulation
+        and to obtain the same results regardless of the order in
+        which the paths are generated, e.g., by different threads.
+
+        \test the correctness of the returned values is tested by
+              checking them against the known-answer values published
+              by the authors.
+    */
+    class PhiloxUniformRng {
+      public:
+        typedef Sample<Real> sample_type;
+        /*! if the given seed is 0, a random seed will be chosen
+            by the SeedGenerator */
+        explicit PhiloxUniformRng(BigNatural seed = 0,
+                                  BigNatural stream = 0);
+        /*! returns a sample with weight 1.0 containing a random number
+            in the (0.0, 1.0) interval  */
+        sample_type next() const { return sample_type(nextReal(),1.0); }
+        //! return a random number in the (0.0, 1.0)-interval
+        Real nextReal() const {
+            return (Real(nextInt32()) + 0.5)/4294967296.0;
+        }
+        //! return a random integer in the [0,0xffffffff]-interval
+        unsigned long nextInt32() const {
+            if (index_ == 4) {
+                ++counter_;
+                refill();
+            }
+            return buffer_[index_++];
+        }
+        //! fills the buffer with the next \f$ n \f$ random numbers
+        void nextReals(Size n, std::vector<Real>& values) const;
+        //! positions the generator on the n-th number of its stream
+        void skipTo(BigNatural n);
+        //! returns the stream used by the generator
+        BigNatural stream() const { return stream_; }
+
+        /*! returns the four words obtained by encrypting the given
+            counter under the given key */
+        static void block(const boost::uint32_t key[2],
+                          const boost::uint32_t counter[4],
+                          boost::uint32_t result[4]);
+      private:
+        void refill() const;
+        boost::uint32_t key_[2];
+        BigNatural stream_;
+        mutable boost::uint64_t counter_;
+        mutable boost::uint32_t buffer_[4];
+        mutable Size index_;
+    };
+
+}
+
+
+#endif
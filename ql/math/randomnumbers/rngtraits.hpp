@@ -28,6 +28,7 @@
 
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/philoxuniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
@@ -78,6 +79,39 @@ namespace QuantLib {
                                 InverseCumulativePoisson> PoissonPseudoRandom;
 
 
+    /*! traits for counter-based generators, which can also build
+        independent sequence generators for different streams, e.g.,
+        one for each path of a Monte Carlo simulation.
+    */
+    template <class URNG, class IC>
+    struct GenericCounterBasedRandom : public GenericPseudoRandom<URNG,IC> {
+        // typedefs
+        typedef typename GenericPseudoRandom<URNG,IC>::urng_type urng_type;
+        typedef typename GenericPseudoRandom<URNG,IC>::ursg_type ursg_type;
+        typedef typename GenericPseudoRandom<URNG,IC>::rsg_type rsg_type;
+        // factories
+        using GenericPseudoRandom<URNG,IC>::make_sequence_generator;
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                BigNatural stream) {
+            QL_REQUIRE(seed != 0,
+                       "a non-null seed is required to reproduce streams");
+            ursg_type g(dimension, urng_type(seed, stream));
+            const boost::shared_ptr<IC>& ic =
+                GenericPseudoRandom<URNG,IC>::icInstance;
+            return (ic ? rsg_type(g, *ic) : rsg_type(g));
+        }
+    };
+
+    //! traits for counter-based pseudo-random number generation
+    /*! \test sequence generators for different streams are tested
+              for reproducibility.
+    */
+    typedef GenericCounterBasedRandom<PhiloxUniformRng,
+                                      InverseCumulativeNormal>
+                                                    CounterBasedPseudoRandom;
+
+
     template <class URSG, class IC>
     struct GenericLowDiscrepancy {
         // typedefs
@@ -48,6 +48,20 @@ namespace QuantLib {
         return seq_;
     }
 
+    void SobolBrownianBridgeRsg::nextSequences(
+                             Size samples, std::vector<Real>& values) const {
+        values.resize(samples*dim_);
+        std::vector<Real>::iterator out = values.begin();
+        for (Size i=0; i<samples; ++i) {
+            const std::vector<Real>& v = nextSequence().value;
+            out = std::copy(v.begin(), v.end(), out);
+        }
+    }
+
+    void SobolBrownianBridgeRsg::skipTo(unsigned long n) {
+        gen_.skipTo(n);
+    }
+
     const SobolBrownianBridgeRsg::sample_type&
     SobolBrownianBridgeRsg::lastSequence() const {
         return seq_;
@@ -41,6 +41,11 @@ namespace QuantLib {
                                    = SobolRsg::JoeKuoD7);
 
         const sample_type& nextSequence() const;
+        /*! fills the buffer with the next \f$ n \f$ samples, stored
+            one after the other; see SobolRsg::nextSequences() */
+        void nextSequences(Size samples, std::vector<Real>& values) const;
+        /*! skip to the n-th sample of the underlying Sobol sequence */
+        void skipTo(unsigned long n);
         const sample_type& lastSequence() const;
         Size dimension() const;
 
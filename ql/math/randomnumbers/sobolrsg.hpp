@@ -28,6 +28,7 @@
 
 #include <ql/methods/montecarlo/sample.hpp>
 #include <vector>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -127,6 +128,16 @@ namespace QuantLib {
                 sequence_.value[k] = v[k] * normalizationFactor_;
             return sequence_;
         }
+        /*! fills the buffer with the next \f$ n \f$ samples, stored
+            one after the other, i.e., the \f$ k \f$-th coordinate of
+            the \f$ i \f$-th sample is found at index \f$ i d + k \f$.
+            The buffer is resized to \f$ n d \f$ values and the last
+            sample is also available from lastSequence().
+
+            Together with skipTo(), this allows to split the sequence
+            in contiguous blocks to be generated independently.
+        */
+        void nextSequences(Size samples, std::vector<Real>& values) const;
         const sample_type& lastSequence() const { return sequence_; }
         Size dimension() const { return dimensionality_; }
       private:
@@ -140,6 +151,22 @@ namespace QuantLib {
         std::vector<std::vector<unsigned long> > directionIntegers_;
     };
 
+
+    // inline definitions
+
+    inline void SobolRsg::nextSequences(Size samples,
+                                        std::vector<Real>& values) const {
+        values.resize(samples*dimensionality_);
+        std::vector<Real>::iterator out = values.begin();
+        for (Size i=0; i<samples; ++i) {
+            const std::vector<unsigned long>& v = nextInt32Sequence();
+            for (Size k=0; k<dimensionality_; ++k)
+                *out++ = v[k] * normalizationFactor_;
+        }
+        if (samples > 0)
+            std::copy(out-dimensionality_, out, sequence_.value.begin());
+    }
+
 }
 
 #endif
@@ -168,6 +168,9 @@ namespace QuantLib {
                 add(*begin, *wbegin);
         }
 
+        //! adds the data collected by another instance
+        void merge(const GeneralStatistics& other);
+
         //! resets the data to a null set
         void reset();
 
@@ -225,6 +228,19 @@ namespace QuantLib {
         sorted_ = false;
     }
 
+    inline void GeneralStatistics::merge(const GeneralStatistics& other) {
+        if (&other == this) {
+            GeneralStatistics copy(other);
+            merge(copy);
+            return;
+        }
+        if (other.samples_.empty())
+            return;
+        samples_.insert(samples_.end(),
+                        other.samples_.begin(), other.samples_.end());
+        sorted_ = false;
+    }
+
     inline void GeneralStatistics::reset() {
         samples_ = std::vector<std::pair<Real,Real> >();
         sorted_ = true;
@@ -22,6 +22,8 @@
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <iomanip>
 
+#include <algorithm>
+
 namespace QuantLib {
 
     IncrementalStatistics::IncrementalStatistics() {
@@ -30,27 +32,26 @@ namespace QuantLib {
 
     Size IncrementalStatistics::samples() const {
         return boost::accumulators::extract_result<
-            boost::accumulators::tag::count>(acc_);
+            boost::accumulators::tag::count>(acc_) + merged_.samples;
     }
 
     Real IncrementalStatistics::weightSum() const {
         return boost::accumulators::extract_result<
-            boost::accumulators::tag::sum_of_weights>(acc_);
+            boost::accumulators::tag::sum_of_weights>(acc_)
+            + merged_.weightSum;
     }
 
     Real IncrementalStatistics::mean() const {
         QL_REQUIRE(weightSum() > 0.0, "sampleWeight_= 0, unsufficient");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::weighted_mean>(acc_);
+        return moments().mean;
     }
 
     Real IncrementalStatistics::variance() const {
         QL_REQUIRE(weightSum() > 0.0, "sampleWeight_= 0, unsufficient");
         QL_REQUIRE(samples() > 1, "sample number <= 1, unsufficient");
-        Real n = static_cast<Real>(samples());
-        return n / (n - 1.0) *
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::weighted_variance>(acc_);
+        Moments m = moments();
+        Real n = static_cast<Real>(m.samples);
+        return n / (n - 1.0) * (m.m2 / m.weightSum);
     }
 
     Real IncrementalStatistics::standardDeviation() const {
@@ -63,50 +64,59 @@ namespace QuantLib {
 
     Real IncrementalStatistics::skewness() const {
         QL_REQUIRE(samples() > 2, "sample number <= 2, unsufficient");
-        Real n = static_cast<Real>(samples());
+        Moments m = moments();
+        Real n = static_cast<Real>(m.samples);
         Real r1 = n / (n - 2.0);
         Real r2 = (n - 1.0) / (n - 2.0);
-        return std::sqrt(r1 * r2) * 
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::weighted_skewness>(acc_);
+        Real m2 = m.m2 / m.weightSum;
+        return std::sqrt(r1 * r2) *
+               (m.m3 / m.weightSum) / (m2 * std::sqrt(m2));
     }
 
     Real IncrementalStatistics::kurtosis() const {
         QL_REQUIRE(samples() > 3,
                    "sample number <= 3, unsufficient");
-        boost::accumulators::extract_result<
-            boost::accumulators::tag::weighted_kurtosis>(acc_);
-        Real n = static_cast<Real>(samples());
+        Moments m = moments();
+        Real n = static_cast<Real>(m.samples);
         Real r1 = (n - 1.0) / (n - 2.0);
         Real r2 = (n + 1.0) / (n - 3.0);
         Real r3 = (n - 1.0) / (n - 3.0);
-        return ((3.0 + boost::accumulators::extract_result<
-                           boost::accumulators::tag::weighted_kurtosis>(acc_)) *
-                    r2 -
-                3.0 * r3) *
-               r1;
+        Real m2 = m.m2 / m.weightSum;
+        return ((m.m4 / m.weightSum) / (m2 * m2) * r2 - 3.0 * r3) * r1;
     }
 
     Real IncrementalStatistics::min() const {
         QL_REQUIRE(samples() > 0, "empty sample set");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::min>(acc_);
+        Real result = mergedMin_;
+        if (boost::accumulators::extract_result<
+                boost::accumulators::tag::count>(acc_) > 0)
+            result = std::min(result,
+                              boost::accumulators::extract_result<
+                                  boost::accumulators::tag::min>(acc_));
+        return result;
     }
 
     Real IncrementalStatistics::max() const {
         QL_REQUIRE(samples() > 0, "empty sample set");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::max>(acc_);
+        Real result = mergedMax_;
+        if (boost::accumulators::extract_result<
+                boost::accumulators::tag::count>(acc_) > 0)
+            result = std::max(result,
+                              boost::accumulators::extract_result<
+                                  boost::accumulators::tag::max>(acc_));
+        return result;
     }
 
     Size IncrementalStatistics::downsideSamples() const {
         return boost::accumulators::extract_result<
-            boost::accumulators::tag::count>(downsideAcc_);
+            boost::accumulators::tag::count>(downsideAcc_)
+            + mergedDownsideSamples_;
     }
 
     Real IncrementalStatistics::downsideWeightSum() const {
         return boost::accumulators::extract_result<
-            boost::accumulators::tag::sum_of_weights>(downsideAcc_);
+            boost::accumulators::tag::sum_of_weights>(downsideAcc_)
+            + mergedDownsideWeightSum_;
     }
 
     Real IncrementalStatistics::downsideVariance() const {
@@ -114,9 +124,15 @@ namespace QuantLib {
         QL_REQUIRE(downsideSamples() > 1, "sample number <= 1, unsufficient");
         Real n = static_cast<Real>(downsideSamples());
         Real r1 = n / (n - 1.0);
-        return r1 *
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::moment<2> >(downsideAcc_);
+        Real moment2 = boost::accumulators::extract_result<
+            boost::accumulators::tag::moment<2> >(downsideAcc_);
+        if (mergedDownsideSamples_ > 0) {
+            Real w = boost::accumulators::extract_result<
+                boost::accumulators::tag::sum_of_weights>(downsideAcc_);
+            Real m = w > 0.0 ? moment2 * w : 0.0;
+            moment2 = (m + mergedDownsideMoment2_) / downsideWeightSum();
+        }
+        return r1 * moment2;
     }
 
     Real IncrementalStatistics::downsideDeviation() const {
@@ -131,9 +147,92 @@ namespace QuantLib {
             downsideAcc_(value, boost::accumulators::weight = valueWeight);
     }
 
+    void IncrementalStatistics::merge(const IncrementalStatistics& other) {
+        if (other.samples() == 0)
+            return;
+        merged_.add(other.moments());
+        mergedMin_ = std::min(mergedMin_, other.min());
+        mergedMax_ = std::max(mergedMax_, other.max());
+        Size n = other.downsideSamples();
+        if (n > 0) {
+            Real w = other.downsideWeightSum();
+            mergedDownsideMoment2_ += n > 1 ?
+                other.downsideVariance() * (n - 1.0) / n * w :
+                w * other.min() * other.min();
+            mergedDownsideSamples_ += n;
+            mergedDownsideWeightSum_ += w;
+        }
+    }
+
     void IncrementalStatistics::reset() {
         acc_ = accumulator_set();
         downsideAcc_ = downside_accumulator_set();
+        merged_ = Moments();
+        mergedMin_ = QL_MAX_REAL;
+        mergedMax_ = QL_MIN_REAL;
+        mergedDownsideSamples_ = 0;
+        mergedDownsideWeightSum_ = mergedDownsideMoment2_ = 0.0;
+    }
+
+    IncrementalStatistics::Moments
+    IncrementalStatistics::moments() const {
+        Moments result;
+        result.samples = boost::accumulators::extract_result<
+            boost::accumulators::tag::count>(acc_);
+        result.weightSum = boost::accumulators::extract_result<
+            boost::accumulators::tag::sum_of_weights>(acc_);
+        if (result.weightSum > 0.0) {
+            result.mean = boost::accumulators::extract_result<
+                boost::accumulators::tag::weighted_mean>(acc_);
+            Real m2 = boost::accumulators::extract_result<
+                boost::accumulators::tag::weighted_variance>(acc_);
+            result.m2 = m2 * result.weightSum;
+            if (m2 > 0.0) {
+                result.m3 = boost::accumulators::extract_result<
+                    boost::accumulators::tag::weighted_skewness>(acc_)
+                    * m2 * std::sqrt(m2) * result.weightSum;
+                result.m4 = (boost::accumulators::extract_result<
+                    boost::accumulators::tag::weighted_kurtosis>(acc_) + 3.0)
+                    * m2 * m2 * result.weightSum;
+            }
+        }
+        result.add(merged_);
+        return result;
+    }
+
+    IncrementalStatistics::Moments::Moments()
+    : samples(0), weightSum(0.0), mean(0.0), m2(0.0), m3(0.0), m4(0.0) {}
+
+    void IncrementalStatistics::Moments::add(const Moments& other) {
+        // pairwise update of the central moments; see P. Pebay,
+        // "Formulas for robust, one-pass parallel computation of
+        // covariances and arbitrary-order statistical moments",
+        // Sandia Report SAND2008-6212 (2008)
+        samples += other.samples;
+        Real wa = weightSum, wb = other.weightSum, w = wa + wb;
+        if (wb == 0.0)
+            return;
+        if (wa == 0.0) {
+            weightSum = wb;
+            mean = other.mean;
+            m2 = other.m2;
+            m3 = other.m3;
+            m4 = other.m4;
+            return;
+        }
+        Real delta = other.mean - mean, d = delta / w;
+        Real m4new = m4 + other.m4
+            + delta * d * d * d * wa * wb * (wa * wa - wa * wb + wb * wb)
+            + 6.0 * d * d * (wa * wa * other.m2 + wb * wb * m2)
+            + 4.0 * d * (wa * other.m3 - wb * m3);
+        Real m3new = m3 + other.m3
+            + delta * d * d * wa * wb * (wa - wb)
+            + 3.0 * d * (wa * other.m2 - wb * m2);
+        m2 += other.m2 + delta * d * wa * wb;
+        m3 = m3new;
+        m4 = m4new;
+        mean += wb * d;
+        weightSum = w;
     }
 
 }
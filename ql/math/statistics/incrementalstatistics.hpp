@@ -56,6 +56,13 @@ namespace QuantLib {
     /*! It can accumulate a set of data and return statistics (e.g: mean,
         variance, skewness, kurtosis, error estimation, etc.).
         This class is a wrapper to the boost accumulator library.
+
+        Two instances can be merged, e.g., after collecting samples
+        in parallel.  The central moments of the merged data are
+        combined with the pairwise formulas by Chan, Golub and
+        LeVeque and by Pebay, which are numerically stable; the
+        result is the same, up to rounding, as if all samples had
+        been added to a single instance.
     */
 
     class IncrementalStatistics {
@@ -153,6 +160,8 @@ namespace QuantLib {
             for (;begin!=end;++begin,++wbegin)
                 add(*begin, *wbegin);
         }
+        //! adds the data collected by another instance
+        void merge(const IncrementalStatistics& other);
         //! resets the data to a null set
         void reset();
         //@}
@@ -176,6 +185,20 @@ namespace QuantLib {
                       boost::accumulators::tag::sum_of_weights>,
             Real> downside_accumulator_set;
         downside_accumulator_set downsideAcc_;
+
+        // sums of w(x-mean)^k for k=2,3,4
+        struct Moments {
+            Moments();
+            void add(const Moments& other);
+            Size samples;
+            Real weightSum, mean, m2, m3, m4;
+        };
+        Moments moments() const;
+        // data of merged instances
+        Moments merged_;
+        Real mergedMin_, mergedMax_;
+        Size mergedDownsideSamples_;
+        Real mergedDownsideWeightSum_, mergedDownsideMoment2_;
     };
 
 }
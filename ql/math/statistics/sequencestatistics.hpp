@@ -27,6 +27,7 @@
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/math/matrix.hpp>
+#include <numeric>
 
 namespace QuantLib {
 
@@ -132,19 +133,56 @@ namespace QuantLib {
                        " required, " << std::distance(begin, end) <<
                        " provided");
 
-            quadraticSum_ += weight * outerProduct(begin, end,
-                                                   begin, end);
-
-            for (Size i=0; i<dimension_; ++begin, ++i)
-                stats_[i].add(*begin, weight);
-
+            Iterator it = begin;
+            for (Size i=0; i<dimension_; ++it, ++i)
+                stats_[i].add(*it, weight);
+
+            // update of the mean and of the centered quadratic sum
+            Real w = runningWeight_ + weight;
+            if (weight > 0.0) {
+                Real f = weight/w, g = weight*(runningWeight_/w);
+                for (Size i=0; i<dimension_; ++begin, ++i) {
+                    delta_[i] = *begin - runningMean_[i];
+                    runningMean_[i] += f*delta_[i];
+                }
+                for (Size i=0; i<dimension_; ++i) {
+                    Real gi = g*delta_[i];
+                    for (Size j=i; j<dimension_; ++j)
+                        quadraticSum_[i][j] += gi*delta_[j];
+                }
+                runningWeight_ = w;
+            }
         }
+        //! adds the rows of the given matrix as samples, each with its weight
+        /*! The contribution of the whole block to the covariance
+            matrix is computed as a single rank-k update, which is
+            considerably faster than adding the samples one by one.
+        */
+        void addSamples(const Matrix& samples,
+                        const std::vector<Real>& weights);
+        //! adds the rows of the given matrix as samples, with default weight
+        void addSamples(const Matrix& samples);
+        //! adds the data collected by another instance
+        /*! The covariance matrices are combined with the pairwise
+            formulas by Chan, Golub and LeVeque, which are
+            numerically stable.
+
+            \pre the underlying statistics class must provide a
+                 merge method.
+        */
+        void merge(const GenericSequenceStatistics& other);
         //@}
       protected:
         Size dimension_;
         std::vector<statistics_type> stats_;
         mutable std::vector<Real> results_;
+        // sum of w (x-mean)(x-mean)^T; only the upper triangle is used
         Matrix quadraticSum_;
+        std::vector<Real> runningMean_, delta_;
+        Real runningWeight_;
+      private:
+        void addMoments(Real weight, const std::vector<Real>& mean,
+                        const Matrix& quadraticSum);
     };
 
     //! default multi-dimensional statistics tool
@@ -158,7 +196,7 @@ namespace QuantLib {
 
     template <class Stat>
     inline GenericSequenceStatistics<Stat>::GenericSequenceStatistics(Size dimension)
-    : dimension_(0) {
+    : dimension_(0), runningWeight_(0.0) {
         reset(dimension);
     }
 
@@ -239,6 +277,9 @@ namespace QuantLib {
                 results_ = std::vector<Real>(dimension);
             }
             quadraticSum_ = Matrix(dimension_, dimension_, 0.0);
+            runningMean_ = std::vector<Real>(dimension_, 0.0);
+            delta_ = std::vector<Real>(dimension_, 0.0);
+            runningWeight_ = 0.0;
         } else {
             dimension_ = dimension;
         }
@@ -246,26 +287,130 @@ namespace QuantLib {
 
     template <class Stat>
     Disposable<Matrix> GenericSequenceStatistics<Stat>::covariance() const {
-        Real sampleWeight = weightSum();
-        QL_REQUIRE(sampleWeight > 0.0,
+        QL_REQUIRE(runningWeight_ > 0.0,
                    "sampleWeight=0, unsufficient");
 
         Real sampleNumber = static_cast<Real>(samples());
         QL_REQUIRE(sampleNumber > 1.0,
                    "sample number <=1, unsufficient");
 
-        std::vector<Real> m = mean();
-        Real inv = 1.0/sampleWeight;
-
-        Matrix result = inv*quadraticSum_;
-        result -= outerProduct(m.begin(), m.end(),
-                               m.begin(), m.end());
+        Real inv = (sampleNumber/(sampleNumber-1.0))/runningWeight_;
 
-        result *= (sampleNumber/(sampleNumber-1.0));
+        Matrix result(dimension_, dimension_);
+        for (Size i=0; i<dimension_; ++i)
+            for (Size j=i; j<dimension_; ++j)
+                result[i][j] = result[j][i] = inv*quadraticSum_[i][j];
         return result;
     }
 
 
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::addSamples(
+                                         const Matrix& samples,
+                                         const std::vector<Real>& weights) {
+        Size n = samples.rows();
+        QL_REQUIRE(weights.size() == n,
+                   "mismatch between samples (" << n
+                   << ") and weights (" << weights.size() << ")");
+        if (n == 0)
+            return;
+        if (dimension_ == 0)
+            reset(samples.columns());
+        QL_REQUIRE(samples.columns() == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << samples.columns() << " provided");
+        Real blockWeight = 0.0;
+        for (Size k=0; k<n; ++k) {
+            QL_REQUIRE(weights[k] >= 0.0,
+                       "negative weight (" << weights[k] << ") not allowed");
+            blockWeight += weights[k];
+        }
+
+        for (Size i=0; i<dimension_; ++i)
+            for (Size k=0; k<n; ++k)
+                stats_[i].add(samples[k][i], weights[k]);
+
+        if (blockWeight == 0.0)
+            return;
+
+        std::vector<Real> blockMean(dimension_, 0.0);
+        for (Size k=0; k<n; ++k)
+            for (Size i=0; i<dimension_; ++i)
+                blockMean[i] += weights[k]*samples[k][i];
+        for (Size i=0; i<dimension_; ++i)
+            blockMean[i] /= blockWeight;
+
+        // centered samples (and their weighted version) are stored
+        // by dimension, so that the rank-k update of the quadratic
+        // sum only needs inner products of contiguous rows
+        Matrix centered(dimension_, n), weighted(dimension_, n);
+        for (Size k=0; k<n; ++k) {
+            for (Size i=0; i<dimension_; ++i) {
+                Real c = samples[k][i] - blockMean[i];
+                centered[i][k] = c;
+                weighted[i][k] = weights[k]*c;
+            }
+        }
+        Matrix blockQuadraticSum(dimension_, dimension_, 0.0);
+        for (Size i=0; i<dimension_; ++i)
+            for (Size j=i; j<dimension_; ++j)
+                blockQuadraticSum[i][j] =
+                    std::inner_product(weighted.row_begin(i),
+                                       weighted.row_end(i),
+                                       centered.row_begin(j), 0.0);
+
+        addMoments(blockWeight, blockMean, blockQuadraticSum);
+    }
+
+    template <class Stat>
+    inline void GenericSequenceStatistics<Stat>::addSamples(
+                                                    const Matrix& samples) {
+        addSamples(samples, std::vector<Real>(samples.rows(), 1.0));
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                                     const GenericSequenceStatistics& other) {
+        if (&other == this) {
+            GenericSequenceStatistics copy(other);
+            merge(copy);
+            return;
+        }
+        if (other.dimension_ == 0)
+            return;
+        if (dimension_ == 0)
+            reset(other.dimension_);
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
+        if (other.runningWeight_ > 0.0)
+            addMoments(other.runningWeight_, other.runningMean_,
+                       other.quadraticSum_);
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::addMoments(
+                                         Real weight,
+                                         const std::vector<Real>& mean,
+                                         const Matrix& quadraticSum) {
+        Real w = runningWeight_ + weight;
+        Real f = weight/w, g = weight*(runningWeight_/w);
+        for (Size i=0; i<dimension_; ++i) {
+            delta_[i] = mean[i] - runningMean_[i];
+            runningMean_[i] += f*delta_[i];
+        }
+        for (Size i=0; i<dimension_; ++i) {
+            Real gi = g*delta_[i];
+            for (Size j=i; j<dimension_; ++j)
+                quadraticSum_[i][j] += quadraticSum[i][j] + gi*delta_[j];
+        }
+        runningWeight_ = w;
+    }
+
+
     template <class Stat>
     Disposable<Matrix> GenericSequenceStatistics<Stat>::correlation() const {
         Matrix correlation = covariance();
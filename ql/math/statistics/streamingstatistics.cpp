@@ -0,0 +1,297 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+#include <functional>
+
+namespace QuantLib {
+
+    namespace {
+
+        typedef std::pair<Real,Real> sample;
+
+        Real interpolate(Real t, Real t0, Real x0, Real t1, Real x1) {
+            if (t1 <= t0)
+                return x1;
+            return x0 + (x1-x0)*(t-t0)/(t1-t0);
+        }
+
+    }
+
+    StreamingStatistics::StreamingStatistics(Size tailSize,
+                                             Real compression)
+    : tailSize_(tailSize), compression_(compression) {
+        QL_REQUIRE(tailSize_ > 0, "tail size must be positive");
+        QL_REQUIRE(compression_ >= 1.0,
+                   "compression (" << compression_
+                   << ") must be at least 1.0");
+        bufferSize_ = static_cast<Size>(5.0*compression_);
+        reset();
+    }
+
+    Real StreamingStatistics::percentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+
+        Real sampleWeight = weightSum();
+        QL_REQUIRE(sampleWeight>0.0,
+                   "empty sample set");
+
+        sortTails();
+        compress();
+
+        Real integral = 0.0, target = percent*sampleWeight;
+        std::vector<sample>::const_iterator k;
+        for (k=lowerTail_.begin(); k!=lowerTail_.end(); ++k) {
+            integral += k->second;
+            if (integral >= target)
+                return k->first;
+        }
+        if (!centroids_.empty()) {
+            if (integral + digestWeight_ >= target)
+                return digestPercentile(target - integral);
+            integral += digestWeight_;
+        }
+        for (k=upperTail_.begin(); k!=upperTail_.end(); ++k) {
+            integral += k->second;
+            if (integral >= target)
+                return k->first;
+        }
+        return max();
+    }
+
+    Real StreamingStatistics::topPercentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+
+        Real sampleWeight = weightSum();
+        QL_REQUIRE(sampleWeight > 0.0,
+                   "empty sample set");
+
+        sortTails();
+        compress();
+
+        Real integral = 0.0, target = percent*sampleWeight;
+        std::vector<sample>::const_reverse_iterator k;
+        for (k=upperTail_.rbegin(); k!=upperTail_.rend(); ++k) {
+            integral += k->second;
+            if (integral >= target)
+                return k->first;
+        }
+        if (!centroids_.empty()) {
+            if (integral + digestWeight_ >= target)
+                return digestPercentile(digestWeight_
+                                        - (target - integral));
+            integral += digestWeight_;
+        }
+        for (k=lowerTail_.rbegin(); k!=lowerTail_.rend(); ++k) {
+            integral += k->second;
+            if (integral >= target)
+                return k->first;
+        }
+        return min();
+    }
+
+    Real StreamingStatistics::digestPercentile(Real target) const {
+        // Each centroid is assumed to be centered at the midpoint of
+        // its weight; the percentile is interpolated linearly
+        // between adjacent midpoints, or between the outermost
+        // midpoints and the innermost tail samples.
+        Real integral = 0.0;
+        Size n = centroids_.size();
+        for (Size i=0; i<n; ++i) {
+            const Centroid& c = centroids_[i];
+            if (integral + c.weight >= target || i == n-1) {
+                if (c.count == 1)
+                    return c.mean;
+                Real mid = integral + 0.5*c.weight;
+                if (target < mid) {
+                    if (i == 0)
+                        return interpolate(target, 0.0,
+                                           lowerTail_.back().first,
+                                           mid, c.mean);
+                    const Centroid& p = centroids_[i-1];
+                    return interpolate(target, integral - 0.5*p.weight,
+                                       p.mean, mid, c.mean);
+                } else {
+                    if (i == n-1)
+                        return interpolate(target, mid, c.mean,
+                                           digestWeight_,
+                                           upperTail_.front().first);
+                    const Centroid& q = centroids_[i+1];
+                    return interpolate(target, mid, c.mean,
+                                       integral + c.weight + 0.5*q.weight,
+                                       q.mean);
+                }
+            }
+            integral += c.weight;
+        }
+        QL_FAIL("empty digest");
+    }
+
+    void StreamingStatistics::add(Real value, Real weight) {
+        moments_.add(value, weight);
+        insert(value, weight);
+    }
+
+    void StreamingStatistics::merge(const StreamingStatistics& other) {
+        if (&other == this) {
+            StreamingStatistics copy(other);
+            merge(copy);
+            return;
+        }
+        QL_REQUIRE(other.tailSize_ == tailSize_,
+                   "tail sizes (" << tailSize_ << ", " << other.tailSize_
+                   << ") differ");
+        if (other.samples() == 0)
+            return;
+
+        moments_.merge(other.moments_);
+
+        // The smallest (largest) samples of the union are among those
+        // in the two lower (upper) tails, so the tails of the other
+        // instance can be added as samples while its centroids can
+        // go directly into the digest.
+        std::vector<sample>::const_iterator k;
+        for (k=other.lowerTail_.begin(); k!=other.lowerTail_.end(); ++k)
+            insert(k->first, k->second);
+        for (k=other.upperTail_.begin(); k!=other.upperTail_.end(); ++k)
+            insert(k->first, k->second);
+
+        other.compress();
+        buffer_.insert(buffer_.end(),
+                       other.centroids_.begin(), other.centroids_.end());
+        digestWeight_ += other.digestWeight_;
+        if (buffer_.size() >= bufferSize_)
+            compress();
+    }
+
+    void StreamingStatistics::reset() {
+        moments_.reset();
+        lowerTail_ = std::vector<sample>();
+        upperTail_ = std::vector<sample>();
+        tailsSorted_ = true;
+        centroids_ = std::vector<Centroid>();
+        buffer_ = std::vector<Centroid>();
+        digestWeight_ = 0.0;
+    }
+
+    void StreamingStatistics::insert(Real value, Real weight) {
+        if (tailsSorted_) {
+            std::make_heap(lowerTail_.begin(), lowerTail_.end());
+            std::make_heap(upperTail_.begin(), upperTail_.end(),
+                           std::greater<sample>());
+            tailsSorted_ = false;
+        }
+
+        // the lower tail is a max-heap of the smallest samples...
+        sample s(value, weight);
+        if (lowerTail_.size() < tailSize_) {
+            lowerTail_.push_back(s);
+            std::push_heap(lowerTail_.begin(), lowerTail_.end());
+            return;
+        }
+        if (s < lowerTail_.front()) {
+            std::pop_heap(lowerTail_.begin(), lowerTail_.end());
+            std::swap(s, lowerTail_.back());
+            std::push_heap(lowerTail_.begin(), lowerTail_.end());
+        }
+
+        // ...the upper tail is a min-heap of the largest ones...
+        if (upperTail_.size() < tailSize_) {
+            upperTail_.push_back(s);
+            std::push_heap(upperTail_.begin(), upperTail_.end(),
+                           std::greater<sample>());
+            return;
+        }
+        if (upperTail_.front() < s) {
+            std::pop_heap(upperTail_.begin(), upperTail_.end(),
+                          std::greater<sample>());
+            std::swap(s, upperTail_.back());
+            std::push_heap(upperTail_.begin(), upperTail_.end(),
+                           std::greater<sample>());
+        }
+
+        // ...and whatever is left goes into the digest.
+        buffer_.push_back(Centroid(s.first, s.second, 1));
+        digestWeight_ += s.second;
+        if (buffer_.size() >= bufferSize_)
+            compress();
+    }
+
+    void StreamingStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end());
+        centroids_.clear();
+
+        // scale function k(q) = delta/(2 pi) asin(2q-1); adjacent
+        // points are merged as long as the resulting centroid spans
+        // at most a unit interval in k.
+        Real normalization = compression_/(2.0*M_PI);
+        Real kMax = 0.25*compression_;
+        Real total = digestWeight_;
+        bool mergeAll = (total <= 0.0);
+
+        Centroid current = buffer_.front();
+        Real weightSoFar = 0.0;
+        Real kLimit = 1.0 - kMax;
+        Real qLimit = kLimit >= kMax ? 1.0 :
+            0.5*(std::sin(kLimit/normalization) + 1.0);
+        for (Size i=1; i<buffer_.size(); ++i) {
+            const Centroid& next = buffer_[i];
+            Real q = (weightSoFar + current.weight + next.weight)/total;
+            if (mergeAll || q <= qLimit) {
+                Size count = current.count + next.count;
+                Real weight = current.weight + next.weight;
+                if (weight > 0.0)
+                    current.mean += (next.mean-current.mean)
+                                   *(next.weight/weight);
+                else
+                    current.mean += (next.mean-current.mean)
+                                   *(Real(next.count)/count);
+                current.weight = weight;
+                current.count = count;
+            } else {
+                weightSoFar += current.weight;
+                centroids_.push_back(current);
+                current = next;
+                Real q0 = std::min(weightSoFar/total, 1.0);
+                kLimit = normalization*std::asin(2.0*q0-1.0) + 1.0;
+                qLimit = kLimit >= kMax ? 1.0 :
+                    0.5*(std::sin(kLimit/normalization) + 1.0);
+            }
+        }
+        centroids_.push_back(current);
+        buffer_.clear();
+    }
+
+    void StreamingStatistics::sortTails() const {
+        if (!tailsSorted_) {
+            std::sort(lowerTail_.begin(), lowerTail_.end());
+            std::sort(upperTail_.begin(), upperTail_.end());
+            tailsSorted_ = true;
+        }
+    }
+
+}
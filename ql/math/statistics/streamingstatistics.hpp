@@ -0,0 +1,312 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file streamingstatistics.hpp
+    \brief bounded-memory statistics tool
+*/
+
+#ifndef quantlib_streaming_statistics_hpp
+#define quantlib_streaming_statistics_hpp
+
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <ql/math/statistics/incrementalstatistics.hpp>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Statistics tool with bounded memory requirements
+    /*! This class provides the same interface as GeneralStatistics
+        and can replace it as the underlying tool of
+        GenericRiskStatistics or of the Monte Carlo framework when
+        the number of samples makes storing all of them impractical.
+
+        Moments are accumulated by an IncrementalStatistics instance
+        and are exact up to rounding.  The empirical distribution is
+        represented by
+        - the \f$ m \f$ lowest and the \f$ m \f$ highest samples,
+          which are stored exactly (\f$ m \f$ is the tail size
+          passed to the constructor);
+        - a merging t-digest (see T. Dunning, "The t-digest:
+          efficient estimates of distributions", 2019) with
+          compression \f$ \delta \f$ for the samples in between.
+
+        As long as no more than \f$ 2m \f$ samples are collected,
+        the results are the same as those of GeneralStatistics.
+        Afterwards, percentiles whose target weight falls within
+        either tail buffer (e.g., the 1% percentile of one million
+        equally-weighted samples with \f$ m \ge 10000 \f$) and the
+        expected shortfall at the corresponding levels are still
+        exact.  Inside the digest, a centroid at quantile \f$ q \f$
+        holds at most a fraction
+        \f$ (2\pi/\delta)\sqrt{q(1-q)} \f$ of the weight; the rank
+        error of the interpolated percentiles is about half that,
+        i.e., below \f$ 0.8\% \f$ at the median and much smaller
+        near the tails for the default \f$ \delta = 200 \f$.
+        Other expectation values are evaluated by replacing each
+        centroid with its mean and are therefore approximated to a
+        similar degree.
+
+        Memory usage is \f$ O(m + \delta) \f$ regardless of the
+        number of samples, and two instances can be merged, e.g.,
+        after collecting samples in parallel.
+    */
+    class StreamingStatistics {
+      public:
+        typedef Real value_type;
+        explicit StreamingStatistics(Size tailSize = 10000,
+                                     Real compression = 200.0);
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const;
+
+        //! sum of data weights
+        Real weightSum() const;
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \sigma^2 = \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate on the mean value, defined as
+            \f$ \epsilon = \sigma/\sqrt{N}. \f$
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        /*! Expectation value of a function \f$ f \f$ on a given
+            range \f$ \mathcal{R} \f$; see
+            GeneralStatistics::expectationValue.
+
+            Samples in the tail buffers are used exactly; each
+            centroid of the digest is used as a single point at its
+            mean with its total weight, and contributes its number
+            of samples to the returned count.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            compress();
+            Real num = 0.0, den = 0.0;
+            Size N = 0;
+            std::vector<std::pair<Real,Real> >::const_iterator i;
+            for (i=lowerTail_.begin(); i!=lowerTail_.end(); ++i) {
+                Real x = i->first, w = i->second;
+                if (inRange(x)) {
+                    num += f(x)*w;
+                    den += w;
+                    N += 1;
+                }
+            }
+            std::vector<Centroid>::const_iterator c;
+            for (c=centroids_.begin(); c!=centroids_.end(); ++c) {
+                if (inRange(c->mean)) {
+                    num += f(c->mean)*c->weight;
+                    den += c->weight;
+                    N += c->count;
+                }
+            }
+            for (i=upperTail_.begin(); i!=upperTail_.end(); ++i) {
+                Real x = i->first, w = i->second;
+                if (inRange(x)) {
+                    num += f(x)*w;
+                    den += w;
+                    N += 1;
+                }
+            }
+            if (N == 0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den,N);
+        }
+
+        /*! \f$ y \f$-th percentile; see GeneralStatistics::percentile.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! \f$ y \f$-th top percentile; see
+            GeneralStatistics::topPercentile.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+
+        //! number of samples stored exactly in each tail
+        Size tailSize() const;
+        //! compression parameter of the digest
+        Real compression() const;
+        //! number of centroids currently used by the digest
+        Size centroids() const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weight must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+
+        //! adds the data collected by another instance
+        /*! The result is the same (up to the approximation of the
+            digest) as if all samples had been added to this instance.
+        */
+        void merge(const StreamingStatistics& other);
+
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Centroid() {}
+            Centroid(Real mean, Real weight, Size count)
+            : mean(mean), weight(weight), count(count) {}
+            bool operator<(const Centroid& c) const {
+                return mean < c.mean;
+            }
+            Real mean, weight;
+            Size count;
+        };
+        void insert(Real value, Real weight);
+        void compress() const;
+        void sortTails() const;
+        Real digestPercentile(Real target) const;
+
+        Size tailSize_;
+        Real compression_;
+        Size bufferSize_;
+        IncrementalStatistics moments_;
+        // exact tails; kept as heaps while adding and sorted
+        // before being used
+        mutable std::vector<std::pair<Real,Real> > lowerTail_, upperTail_;
+        mutable bool tailsSorted_;
+        // digest
+        mutable std::vector<Centroid> centroids_, buffer_;
+        mutable Real digestWeight_;
+    };
+
+
+    //! risk statistics with bounded memory requirements
+    typedef GenericRiskStatistics<
+                     GenericGaussianStatistics<StreamingStatistics> >
+                                                   StreamingRiskStatistics;
+
+
+    // inline definitions
+
+    inline Size StreamingStatistics::samples() const {
+        return moments_.samples();
+    }
+
+    inline Real StreamingStatistics::weightSum() const {
+        return moments_.weightSum();
+    }
+
+    inline Real StreamingStatistics::mean() const {
+        return moments_.mean();
+    }
+
+    inline Real StreamingStatistics::variance() const {
+        return moments_.variance();
+    }
+
+    inline Real StreamingStatistics::standardDeviation() const {
+        return moments_.standardDeviation();
+    }
+
+    inline Real StreamingStatistics::errorEstimate() const {
+        return moments_.errorEstimate();
+    }
+
+    inline Real StreamingStatistics::skewness() const {
+        return moments_.skewness();
+    }
+
+    inline Real StreamingStatistics::kurtosis() const {
+        return moments_.kurtosis();
+    }
+
+    inline Real StreamingStatistics::min() const {
+        return moments_.min();
+    }
+
+    inline Real StreamingStatistics::max() const {
+        return moments_.max();
+    }
+
+    inline Size StreamingStatistics::tailSize() const {
+        return tailSize_;
+    }
+
+    inline Real StreamingStatistics::compression() const {
+        return compression_;
+    }
+
+    inline Size StreamingStatistics::centroids() const {
+        compress();
+        return centroids_.size();
+    }
+
+}
+
+
+#endif
@@ -51,6 +51,11 @@ namespace QuantLib {
                         Array& newValues) const;
         \endcode
 
+        The default stepback() calls the above methods for each node
+        and branch.  Derived classes with contiguous branching data
+        can replace it with a loop over the nodes of a step, possibly
+        using the discount factors returned by discounts().
+
         \ingroup lattices
     */
     template <class Impl>
@@ -59,7 +64,7 @@ namespace QuantLib {
       public:
         TreeLattice(const TimeGrid& timeGrid,
                     Size n)
-        : Lattice(timeGrid), n_(n) {
+        : Lattice(timeGrid), n_(n), discounts_(timeGrid.size()) {
             QL_REQUIRE(n>0, "there is no zeronomial lattice!");
             statePrices_ = std::vector<Array>(1, Array(1, 1.0));
             statePricesLimit_ = 0;
@@ -83,12 +88,21 @@ namespace QuantLib {
       protected:
         void computeStatePrices(Size until) const;
 
+        /*! discount factors at the nodes of the i-th step.  They are
+            calculated when first requested and cached afterwards;
+            therefore, they should only be used after the tree is
+            completely built (e.g., after it is fitted to a term
+            structure.)
+        */
+        const Array& discounts(Size i) const;
+
         // Arrow-Debrew state prices
         mutable std::vector<Array> statePrices_;
 
       private:
         Size n_;
         mutable Size statePricesLimit_;
+        mutable std::vector<Array> discounts_;
     };
 
 
@@ -117,6 +131,17 @@ namespace QuantLib {
         return statePrices_[i];
     }
 
+    template <class Impl>
+    const Array& TreeLattice<Impl>::discounts(Size i) const {
+        if (discounts_[i].empty()) {
+            Array discounts(this->impl().size(i));
+            for (Size j=0; j<discounts.size(); j++)
+                discounts[j] = this->impl().discount(i,j);
+            discounts_[i].swap(discounts);
+        }
+        return discounts_[i];
+    }
+
     template <class Impl>
     inline Real TreeLattice<Impl>::presentValue(DiscretizedAsset& asset) const {
         Size i = t_.index(asset.time());
@@ -35,6 +35,11 @@ namespace QuantLib {
     /*! This lattice is based on two trinomial trees and primarily used
         for the G2 short-rate model.
 
+        The rollback runs over the contiguous branching data of the
+        two trees (see TrinomialTree::descendants and
+        TrinomialTree::probabilities) and on the cached discount
+        factors at each step.
+
         \ingroup lattices
     */
     template <class Impl, class T = TrinomialTree>
@@ -47,6 +52,7 @@ namespace QuantLib {
         Size size(Size i) const;
         Size descendant(Size i, Size index, Size branch) const;
         Real probability(Size i, Size index, Size branch) const;
+        void stepback(Size i, const Array& values, Array& newValues) const;
       protected:
         boost::shared_ptr<T> tree1_, tree2_;
         // smelly
@@ -131,6 +137,46 @@ namespace QuantLib {
         return prob1*prob2 + rho_*(m_[branch1][branch2])/36.0;
     }
 
+    template <class Impl, class T>
+    void TreeLattice2D<Impl,T>::stepback(Size i, const Array& values,
+                                         Array& newValues) const {
+        const Size n1 = tree1_->size(i), n2 = tree2_->size(i);
+        const Size modulo = tree1_->size(i+1);
+        const std::vector<Size>& k1 = tree1_->descendants(i);
+        const std::vector<Size>& k2 = tree2_->descendants(i);
+        const Array& discounts = this->discounts(i);
+
+        // correlation terms, as in probability()
+        Matrix correlation(T::branches, T::branches);
+        for (Size b1=0; b1<T::branches; b1++)
+            for (Size b2=0; b2<T::branches; b2++)
+                correlation[b1][b2] = rho_*(m_[b1][b2])/36.0;
+
+        // The nodes are processed by rows of the second tree; along
+        // each row, the descendants and probabilities of the first
+        // tree are contiguous.  Branches are added in the same order
+        // as in the generic implementation.
+        #pragma omp parallel for
+        for (long j2=0; j2<long(n2); j2++) {
+            Array row(n1, 0.0);
+            for (Size b2=0; b2<T::branches; b2++) {
+                Real prob2 = tree2_->probabilities(i, b2)[j2];
+                const Real* v = values.begin() + (k2[j2]+b2)*modulo;
+                for (Size b1=0; b1<T::branches; b1++) {
+                    const std::vector<Real>& prob1 =
+                        tree1_->probabilities(i, b1);
+                    Real c = correlation[b1][b2];
+                    for (Size j1=0; j1<n1; j1++)
+                        row[j1] += (prob1[j1]*prob2 + c) * v[k1[j1]+b1];
+                }
+            }
+            Real* result = newValues.begin() + j2*n1;
+            const Real* d = discounts.begin() + j2*n1;
+            for (Size j1=0; j1<n1; j1++)
+                result[j1] = row[j1]*d[j1];
+        }
+    }
+
 }
 
 
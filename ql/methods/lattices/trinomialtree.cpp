@@ -67,6 +67,11 @@ namespace QuantLib {
             }
             branchings_.push_back(branching);
 
+            std::vector<Size> descendants(jMax-jMin+1);
+            for (Size j=0; j<descendants.size(); j++)
+                descendants[j] = branching.descendant(j, 0);
+            descendants_.push_back(descendants);
+
             jMin = branching.jMin();
             jMax = branching.jMax();
         }
@@ -53,8 +53,24 @@ namespace QuantLib {
         Size descendant(Size i, Size index, Size branch) const;
         Real probability(Size i, Size index, Size branch) const;
 
+        /*! \name Contiguous access
+            These methods return the branching data of all the nodes
+            at a given step, so that rollback loops can be written
+            without per-node calls.
+        */
+        //@{
+        /*! lowest descendant of each node at step \f$ i \f$; the
+            descendant along branch \f$ b \f$ is the lowest plus
+            \f$ b \f$.
+        */
+        const std::vector<Size>& descendants(Size i) const;
+        //! probability of the given branch for each node at step i
+        const std::vector<Real>& probabilities(Size i, Size branch) const;
+        //@}
+
       protected:
         std::vector<Branching> branchings_;
+        std::vector<std::vector<Size> > descendants_;
         Real x0_;
         std::vector<Real> dx_;
         TimeGrid timeGrid_;
@@ -68,6 +84,7 @@ namespace QuantLib {
             Branching();
             Size descendant(Size index, Size branch) const;
             Real probability(Size index, Size branch) const;
+            const std::vector<Real>& probabilities(Size branch) const;
             Size size() const;
             Integer jMin() const;
             Integer jMax() const;
@@ -102,6 +119,15 @@ namespace QuantLib {
         return branchings_[i].probability(j, b);
     }
 
+    inline const std::vector<Size>& TrinomialTree::descendants(Size i) const {
+        return descendants_[i];
+    }
+
+    inline const std::vector<Real>&
+    TrinomialTree::probabilities(Size i, Size branch) const {
+        return branchings_[i].probabilities(branch);
+    }
+
     inline TrinomialTree::Branching::Branching()
     : probs_(3), kMin_(QL_MAX_INTEGER), jMin_(QL_MAX_INTEGER),
                  kMax_(QL_MIN_INTEGER), jMax_(QL_MIN_INTEGER) {}
@@ -116,6 +142,11 @@ namespace QuantLib {
         return probs_[branch][index];
     }
 
+    inline const std::vector<Real>&
+    TrinomialTree::Branching::probabilities(Size branch) const {
+        return probs_[branch];
+    }
+
     inline Size TrinomialTree::Branching::size() const {
         return jMax_ - jMin_ + 1;
     }
@@ -29,6 +29,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
@@ -95,6 +96,52 @@ namespace QuantLib {
         const Size len_;
     };
 
+    //! Longstaff-Schwarz path pricer with reduced memory requirements
+    /*! This pricer gives the same results as
+        LongstaffSchwartzPathPricer (up to rounding in the regression)
+        but doesn't store the calibration paths.  Instead, for each
+        exercise date it stores the exercise value of every path and,
+        for in-the-money paths only, the values of the basis
+        functions; memory requirements are therefore
+        \f$ O(N (1 + m)) \f$ per exercise date for \f$ N \f$ paths
+        and \f$ m \f$ basis functions, without the overhead of
+        copying the paths and their time grids.  Stored values are
+        released as soon as the backward induction is done with the
+        corresponding date.
+
+        The regression on each date is performed by accumulating the
+        observations into an IncrementalLinearLeastSquares instance.
+        When OpenMP is enabled, the paths are split into blocks that
+        are regressed and rolled back in parallel; partial
+        regressions are merged in a fixed order, so that results
+        don't depend on the number of threads.
+
+        \warning Since no state is available after the calibration,
+                 post_processing is not called by this class.
+
+        \ingroup mcarlo
+    */
+    template <class PathType>
+    class CompactLongstaffSchwartzPathPricer
+        : public LongstaffSchwartzPathPricer<PathType> {
+      public:
+        typedef typename LongstaffSchwartzPathPricer<PathType>::StateType
+                                                                  StateType;
+
+        CompactLongstaffSchwartzPathPricer(
+            const TimeGrid& times,
+            const boost::shared_ptr<EarlyExercisePathPricer<PathType> >& ,
+            const boost::shared_ptr<YieldTermStructure>& termStructure);
+
+        Real operator()(const PathType& path) const;
+        void calibrate();
+
+      private:
+        // exercise values for all paths and basis values for
+        // in-the-money paths, indexed by exercise date
+        mutable std::vector<std::vector<Real> > exercise_, basis_;
+    };
+
     template <class PathType> inline
     LongstaffSchwartzPathPricer<PathType>::LongstaffSchwartzPathPricer(
         const TimeGrid& times,
@@ -226,6 +273,121 @@ namespace QuantLib {
         return exerciseProbability_.mean();
     }
 
+    template <class PathType> inline
+    CompactLongstaffSchwartzPathPricer<PathType>::
+    CompactLongstaffSchwartzPathPricer(
+        const TimeGrid& times,
+        const boost::shared_ptr<EarlyExercisePathPricer<PathType> >&
+            pathPricer,
+        const boost::shared_ptr<YieldTermStructure>& termStructure)
+    : LongstaffSchwartzPathPricer<PathType>(times, pathPricer, termStructure),
+      exercise_(times.size()-1), basis_(times.size()-1) {}
+
+    template <class PathType> inline
+    Real CompactLongstaffSchwartzPathPricer<PathType>::operator()
+        (const PathType& path) const {
+        if (!this->calibrationPhase_)
+            return LongstaffSchwartzPathPricer<PathType>::operator()(path);
+
+        // store what the regression needs, not the path itself
+        const Size len = this->len_;
+        const std::vector<boost::function1<Real, StateType> >& v = this->v_;
+        for (Size i=1; i<len; ++i) {
+            const Real exercise = (*this->pathPricer_)(path, i);
+            exercise_[i-1].push_back(exercise);
+            if (exercise > 0.0 && i < len-1) {
+                const StateType regValue = this->pathPricer_->state(path, i);
+                for (Size l=0; l<v.size(); ++l)
+                    basis_[i-1].push_back(v[l](regValue));
+            }
+        }
+        // result doesn't matter
+        return 0.0;
+    }
+
+    template <class PathType> inline
+    void CompactLongstaffSchwartzPathPricer<PathType>::calibrate() {
+        const Size len = this->len_;
+        const Size m = this->v_.size();
+        const Size n = exercise_.back().size();
+        const Size blockSize = 1024;
+        const Size nBlocks = (n + blockSize - 1)/blockSize;
+
+        std::vector<Real> prices(exercise_.back());
+        std::vector<Real>().swap(exercise_.back());
+
+        std::vector<IncrementalLinearLeastSquares> regressions(nBlocks);
+        std::vector<Size> offsets(nBlocks);
+        for (Size i=len-2; i>0; --i) {
+            const std::vector<Real>& exercise = exercise_[i-1];
+            const std::vector<Real>& basis = basis_[i-1];
+            const DiscountFactor dF = this->dF_[i];
+
+            // position of the first basis value of each block
+            for (Size b=0, k=0; b<nBlocks; ++b) {
+                offsets[b] = k;
+                const Size end = std::min(n, (b+1)*blockSize);
+                for (Size j=b*blockSize; j<end; ++j)
+                    if (exercise[j] > 0.0)
+                        k += m;
+            }
+
+            // regression of the discounted prices on the basis values
+            // of the in-the-money paths...
+            #pragma omp parallel for
+            for (long b=0; b<long(nBlocks); ++b) {
+                IncrementalLinearLeastSquares& regression = regressions[b];
+                regression.reset(m);
+                const Size end = std::min(n, Size(b+1)*blockSize);
+                for (Size j=Size(b)*blockSize, k=offsets[b]; j<end; ++j) {
+                    if (exercise[j] > 0.0) {
+                        regression.add(basis.begin()+k, basis.begin()+k+m,
+                                       dF*prices[j]);
+                        k += m;
+                    }
+                }
+            }
+
+            IncrementalLinearLeastSquares regression(m);
+            for (Size b=0; b<nBlocks; ++b)
+                regression.merge(regressions[b]);
+
+            if (m <= regression.size()) {
+                this->coeff_[i-1] = regression.coefficients();
+            } else {
+            // if number of itm paths is smaller then the number of
+            // calibration functions then early exercise if exerciseValue > 0
+                this->coeff_[i-1] = Array(m, 0.0);
+            }
+
+            // ...and roll back step
+            const Array& coeff = this->coeff_[i-1];
+            #pragma omp parallel for
+            for (long b=0; b<long(nBlocks); ++b) {
+                const Size end = std::min(n, Size(b+1)*blockSize);
+                for (Size j=Size(b)*blockSize, k=offsets[b]; j<end; ++j) {
+                    prices[j] *= dF;
+                    if (exercise[j] > 0.0) {
+                        Real continuationValue = 0.0;
+                        for (Size l=0; l<m; ++l)
+                            continuationValue += coeff[l] * basis[k+l];
+                        if (continuationValue < exercise[j])
+                            prices[j] = exercise[j];
+                        k += m;
+                    }
+                }
+            }
+
+            // release memory
+            std::vector<Real>().swap(exercise_[i-1]);
+            std::vector<Real>().swap(basis_[i-1]);
+        }
+
+        // entering the calculation phase
+        this->calibrationPhase_ = false;
+    }
+
+
 
 }
 
@@ -22,6 +22,7 @@
 #include <ql/models/marketmodels/evolver.hpp>
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
+#include <ql/utilities/dataformatters.hpp>
 #include <algorithm>
 
 namespace QuantLib {
@@ -122,4 +123,59 @@ namespace QuantLib {
         }
     }
 
+
+    namespace detail {
+
+        PathBlockScheduler::PathBlockScheduler(
+                const std::vector<boost::shared_ptr<MarketModelEvolver> >&
+                                                                  evolvers,
+                Size pathsPerBlock)
+        : evolvers_(evolvers), pathsPerBlock_(pathsPerBlock),
+          pathsDone_(0), nextPath_(evolvers.size(), 0) {
+            QL_REQUIRE(!evolvers_.empty(), "no evolvers given");
+            QL_REQUIRE(pathsPerBlock_ > 0, "null number of paths per block");
+            for (Size i=0; i<evolvers_.size(); ++i) {
+                QL_REQUIRE(evolvers_[i], "null evolver given");
+                for (Size j=0; j<i; ++j)
+                    QL_REQUIRE(evolvers_[j] != evolvers_[i],
+                               "evolver " << io::ordinal(i+1)
+                               << " is the same as evolver "
+                               << io::ordinal(j+1));
+            }
+        }
+
+    }
+
+
+    ParallelAccountingEngine::ParallelAccountingEngine(
+                const std::vector<boost::shared_ptr<MarketModelEvolver> >&
+                                                                  evolvers,
+                const Clone<MarketModelMultiProduct>& product,
+                Real initialNumeraireValue,
+                Size pathsPerBlock)
+    : evolvers_(evolvers), initialNumeraireValue_(initialNumeraireValue),
+      scheduler_(evolvers, pathsPerBlock) {
+        setProduct(product);
+    }
+
+    void ParallelAccountingEngine::setProduct(
+                               const Clone<MarketModelMultiProduct>& product) {
+        numberProducts_ = product->numberOfProducts();
+        workers_.clear();
+        workers_.reserve(evolvers_.size());
+        // each worker clones the product
+        for (Size i=0; i<evolvers_.size(); ++i)
+            workers_.push_back(AccountingEngine(evolvers_[i], product,
+                                                initialNumeraireValue_));
+    }
+
+    void ParallelAccountingEngine::multiplePathValues(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths) {
+        scheduler_.simulate(workers_,
+                            &AccountingEngine::multiplePathValues,
+                            SequenceStatisticsInc(numberProducts_),
+                            stats, numberOfPaths);
+    }
+
 }
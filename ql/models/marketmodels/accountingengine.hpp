@@ -25,16 +25,17 @@
 // to be removed using forward declaration
 #include <ql/models/marketmodels/multiproduct.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
+#include <ql/models/marketmodels/evolver.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 
 #include <ql/utilities/clone.hpp>
 #include <ql/types.hpp>
+#include <algorithm>
 #include <vector>
+#include <string>
 
 namespace QuantLib {
 
-    class MarketModelEvolver;
-
     //class MarketModelDiscounter;
     //class SequenceStatistics;
     //class MarketModelMultiProduct;
@@ -66,6 +67,156 @@ namespace QuantLib {
 
     };
 
+    namespace detail {
+
+        //! Distribution of blocks of market-model paths among workers
+        /*! Paths are divided into blocks of fixed size which are
+            distributed among a number of workers, each driven by its
+            own evolver; when OpenMP is enabled, workers run in
+            parallel.  Each evolver reaches the first path of its
+            blocks through MarketModelEvolver::skipPaths(), which
+            jumps ahead in constant time when the underlying Brownian
+            generator allows it.  The results collected for each block
+            are merged in block order, so that they don't depend on
+            the number of workers or threads.
+
+            \pre The evolvers must be built from the same market
+                 model, Brownian-generator factory, numeraires and
+                 initial step, so that they generate the same sequence
+                 of paths; they must not share any mutable state.
+        */
+        class PathBlockScheduler {
+          public:
+            PathBlockScheduler(
+                const std::vector<boost::shared_ptr<MarketModelEvolver> >&
+                                                                  evolvers,
+                Size pathsPerBlock);
+            /*! simulates the next \c numberOfPaths paths by calling
+                the given method of the workers on each block.  The
+                values of each block are collected into a copy of
+                \c empty and merged into \c result.
+            */
+            template <class Worker, class Accumulator>
+            void simulate(std::vector<Worker>& workers,
+                          void (Worker::*method)(Accumulator&, Size),
+                          const Accumulator& empty,
+                          Accumulator& result,
+                          Size numberOfPaths);
+          private:
+            std::vector<boost::shared_ptr<MarketModelEvolver> > evolvers_;
+            Size pathsPerBlock_;
+            // index of the next path to be generated, overall and by
+            // each evolver
+            Size pathsDone_;
+            std::vector<Size> nextPath_;
+        };
+
+    }
+
+    //! Engine collecting cash flows along a market-model simulation in parallel
+    /*! Paths are divided into blocks of fixed size which are
+        distributed among a number of workers, each with its own
+        evolver and its own copy of the product; see
+        detail::PathBlockScheduler for details.  Results equal the
+        ones of AccountingEngine up to rounding.
+
+        Successive calls to multiplePathValues() simulate successive
+        paths.  The product can be replaced between calls, e.g., to
+        run a new batch of inner paths in a nested simulation, while
+        the evolvers keep their position in the sequence of paths.
+
+        \pre The evolvers must be built from the same market model,
+             Brownian-generator factory, numeraires and initial step,
+             so that they generate the same sequence of paths; they
+             must not share any mutable state.
+    */
+    class ParallelAccountingEngine {
+      public:
+        ParallelAccountingEngine(
+                const std::vector<boost::shared_ptr<MarketModelEvolver> >&
+                                                                  evolvers,
+                const Clone<MarketModelMultiProduct>& product,
+                Real initialNumeraireValue,
+                Size pathsPerBlock = 1024);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+        //! gives each worker a fresh copy of the given product
+        void setProduct(const Clone<MarketModelMultiProduct>& product);
+      private:
+        std::vector<boost::shared_ptr<MarketModelEvolver> > evolvers_;
+        Real initialNumeraireValue_;
+        std::vector<AccountingEngine> workers_;
+        Size numberProducts_;
+        detail::PathBlockScheduler scheduler_;
+    };
+
+
+    // template definitions
+
+    namespace detail {
+
+        template <class Worker, class Accumulator>
+        void PathBlockScheduler::simulate(
+                                 std::vector<Worker>& workers,
+                                 void (Worker::*method)(Accumulator&, Size),
+                                 const Accumulator& empty,
+                                 Accumulator& result,
+                                 Size numberOfPaths) {
+            const Size numberWorkers = evolvers_.size();
+            QL_REQUIRE(workers.size() == numberWorkers,
+                       workers.size() << " workers given, "
+                       << numberWorkers << " required");
+            const Size numberBlocks =
+                (numberOfPaths + pathsPerBlock_ - 1)/pathsPerBlock_;
+
+            // blocks are processed in rounds so that the number of
+            // partial results kept in memory is bounded
+            const Size blocksPerRound = 4*numberWorkers;
+            std::vector<Accumulator> blockResults(
+                                 std::min(numberBlocks, blocksPerRound),
+                                 empty);
+            std::vector<std::string> errors(numberWorkers);
+
+            for (Size first=0; first<numberBlocks; first+=blocksPerRound) {
+                const Size last = std::min(numberBlocks,
+                                           first+blocksPerRound);
+
+                // each worker takes a contiguous range of blocks
+                #pragma omp parallel for
+                for (long w=0; w<long(numberWorkers); ++w) {
+                    try {
+                        const Size begin =
+                            first + (last-first)*Size(w)/numberWorkers;
+                        const Size end =
+                            first + (last-first)*Size(w+1)/numberWorkers;
+                        for (Size b=begin; b<end; ++b) {
+                            const Size start =
+                                pathsDone_ + b*pathsPerBlock_;
+                            const Size n =
+                                std::min(pathsPerBlock_,
+                                         numberOfPaths - b*pathsPerBlock_);
+                            evolvers_[w]->skipPaths(start - nextPath_[w]);
+                            Accumulator& partial = blockResults[b-first];
+                            partial = empty;
+                            (workers[w].*method)(partial, n);
+                            nextPath_[w] = start + n;
+                        }
+                    } catch (std::exception& e) {
+                        errors[w] = e.what();
+                    }
+                }
+
+                for (Size w=0; w<numberWorkers; ++w)
+                    QL_REQUIRE(errors[w].empty(), errors[w]);
+                for (Size b=first; b<last; ++b)
+                    result.merge(blockResults[b-first]);
+            }
+
+            pathsDone_ += numberOfPaths;
+        }
+
+    }
+
 }
 
 #endif
@@ -34,6 +34,15 @@ namespace QuantLib {
 
         virtual Real nextStep(std::vector<Real>&) = 0;
         virtual Real nextPath() = 0;
+        //! skips the next n paths
+        /*! The default implementation draws and discards them;
+            generators that can jump ahead in their sequence should
+            override it.
+        */
+        virtual void skipPaths(Size n) {
+            for (Size i=0; i<n; ++i)
+                nextPath();
+        }
 
         virtual Size numberOfFactors() const = 0;
         virtual Size numberOfSteps() const = 0;
@@ -25,20 +25,17 @@ namespace QuantLib {
                                              Size steps,
                                              unsigned long seed)
     : factors_(factors), steps_(steps), lastStep_(0),
-      generator_(factors*steps, MersenneTwisterUniformRng(seed)) {}
+      generator_(factors*steps, MersenneTwisterUniformRng(seed)),
+      variates_(factors*steps) {}
 
     Real MTBrownianGenerator::nextStep(std::vector<Real>& output) {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(output.size() == factors_, "size mismatch");
         QL_REQUIRE(lastStep_<steps_, "uniform sequence exhausted");
         #endif
-        // no copying, just fetching a reference
-        const std::vector<Real>& currentSequence = generator_.lastSequence().value;
         Size start = lastStep_*factors_, end = (lastStep_+1)*factors_;
-        std::transform(currentSequence.begin()+start,
-                       currentSequence.begin()+end,
-                       output.begin(),
-                       inverseCumulative_);
+        std::copy(variates_.begin()+start, variates_.begin()+end,
+                  output.begin());
         ++lastStep_;
         return 1.0;
     }
@@ -48,10 +45,21 @@ namespace QuantLib {
             sample_type;
 
         const sample_type& sample = generator_.nextSequence();
+        // the whole path is transformed at once
+        inverseCumulative_.transform(&sample.value[0],
+                                     &sample.value[0]+sample.value.size(),
+                                     &variates_[0]);
         lastStep_ = 0;
         return sample.weight;
     }
 
+    void MTBrownianGenerator::skipPaths(Size n) {
+        // the Mersenne twister can't jump ahead
+        for (Size i=0; i<n; ++i)
+            generator_.nextSequence();
+        lastStep_ = steps_;
+    }
+
     Size MTBrownianGenerator::numberOfFactors() const { return factors_; }
 
     Size MTBrownianGenerator::numberOfSteps() const { return steps_; }
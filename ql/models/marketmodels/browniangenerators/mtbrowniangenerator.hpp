@@ -48,6 +48,8 @@ namespace QuantLib {
 
         Real nextStep(std::vector<Real>&);
         Real nextPath();
+        //! draws the uniforms of the skipped paths, but doesn't transform them
+        void skipPaths(Size n);
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
@@ -56,6 +58,7 @@ namespace QuantLib {
         Size lastStep_;
         RandomSequenceGenerator<MersenneTwisterUniformRng> generator_;
         InverseCumulativeNormal inverseCumulative_;
+        std::vector<Real> variates_;
     };
 
     class MTBrownianGeneratorFactory : public BrownianGeneratorFactory {
@@ -0,0 +1,76 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/models/marketmodels/browniangenerators/philoxbrowniangenerator.hpp>
+
+namespace QuantLib {
+
+    PhiloxBrownianGenerator::PhiloxBrownianGenerator(Size factors,
+                                                     Size steps,
+                                                     unsigned long seed)
+    : factors_(factors), steps_(steps), lastStep_(steps), nextPath_(0),
+      generator_(seed), uniforms_(factors*steps),
+      variates_(factors*steps) {}
+
+    Real PhiloxBrownianGenerator::nextStep(std::vector<Real>& output) {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+        QL_REQUIRE(output.size() == factors_, "size mismatch");
+        QL_REQUIRE(lastStep_<steps_, "uniform sequence exhausted");
+        #endif
+        Size start = lastStep_*factors_, end = (lastStep_+1)*factors_;
+        std::copy(variates_.begin()+start, variates_.begin()+end,
+                  output.begin());
+        ++lastStep_;
+        return 1.0;
+    }
+
+    Real PhiloxBrownianGenerator::nextPath() {
+        Size dimension = factors_*steps_;
+        generator_.skipTo(nextPath_*dimension);
+        generator_.nextReals(dimension, uniforms_);
+        // the whole path is transformed at once
+        inverseCumulative_.transform(&uniforms_[0],
+                                     &uniforms_[0]+dimension,
+                                     &variates_[0]);
+        ++nextPath_;
+        lastStep_ = 0;
+        return 1.0;
+    }
+
+    void PhiloxBrownianGenerator::skipPaths(Size n) {
+        nextPath_ += n;
+        lastStep_ = steps_;
+    }
+
+    Size PhiloxBrownianGenerator::numberOfFactors() const { return factors_; }
+
+    Size PhiloxBrownianGenerator::numberOfSteps() const { return steps_; }
+
+
+    PhiloxBrownianGeneratorFactory::PhiloxBrownianGeneratorFactory(
+                                                          unsigned long seed)
+    : seed_(seed) {}
+
+    boost::shared_ptr<BrownianGenerator>
+    PhiloxBrownianGeneratorFactory::create(Size factors, Size steps) const {
+        return boost::shared_ptr<BrownianGenerator>(
+                          new PhiloxBrownianGenerator(factors, steps, seed_));
+    }
+
+}
+
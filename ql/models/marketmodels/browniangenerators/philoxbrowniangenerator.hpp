@@ -0,0 +1,75 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file philoxbrowniangenerator.hpp
+    \brief Philox-based Brownian generator for market-model simulations
+*/
+
+#ifndef quantlib_philox_brownian_generator_hpp
+#define quantlib_philox_brownian_generator_hpp
+
+#include <ql/models/marketmodels/browniangenerator.hpp>
+#include <ql/math/randomnumbers/philoxuniformrng.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+
+namespace QuantLib {
+
+    //! Philox Brownian generator for market-model simulations
+    /*! Incremental Brownian generator using a Philox counter-based
+        uniform generator and inverse-cumulative Gaussian method.
+
+        The uniforms of the n-th path are the numbers at positions
+        \f$ n d \f$ to \f$ (n+1) d - 1 \f$ of the Philox stream,
+        \f$ d \f$ being the number of factors times the number of
+        steps; therefore, paths can be skipped in constant time.
+    */
+    class PhiloxBrownianGenerator : public BrownianGenerator {
+      public:
+        PhiloxBrownianGenerator(Size factors,
+                                Size steps,
+                                unsigned long seed = 0);
+
+        Real nextStep(std::vector<Real>&);
+        Real nextPath();
+        //! skips the next n paths in constant time
+        void skipPaths(Size n);
+
+        Size numberOfFactors() const;
+        Size numberOfSteps() const;
+      private:
+        Size factors_, steps_;
+        Size lastStep_;
+        BigNatural nextPath_;
+        PhiloxUniformRng generator_;
+        InverseCumulativeNormal inverseCumulative_;
+        std::vector<Real> uniforms_, variates_;
+    };
+
+    class PhiloxBrownianGeneratorFactory : public BrownianGeneratorFactory {
+      public:
+        PhiloxBrownianGeneratorFactory(unsigned long seed = 0);
+        boost::shared_ptr<BrownianGenerator> create(Size factors,
+                                                    Size steps) const;
+      private:
+        unsigned long seed_;
+    };
+
+}
+
+
+#endif
@@ -116,7 +116,7 @@ namespace QuantLib {
     : factors_(factors), steps_(steps), ordering_(ordering),
       generator_(SobolRsg(factors*steps, seed, integers),
                  InverseCumulativeNormal()),
-      bridge_(steps), lastStep_(0),
+      bridge_(steps), lastStep_(0), nextPath_(0), drawn_(false),
       orderedIndices_(factors, std::vector<Size>(steps)),
       bridgedVariates_(factors, std::vector<Real>(steps)) {
 
@@ -153,6 +153,8 @@ namespace QuantLib {
                               bridgedVariates_[i].begin());
         }
         lastStep_ = 0;
+        ++nextPath_;
+        drawn_ = true;
         return sample.weight;
     }
     
@@ -204,6 +206,24 @@ namespace QuantLib {
         return 1.0;
     }
 
+    void SobolBrownianGenerator::skipTo(unsigned long n) {
+        generator_.skipTo(n);
+        lastStep_ = steps_;
+        nextPath_ = drawn_ ? n+1 : n;
+    }
+
+    void SobolBrownianGenerator::skipPaths(Size n) {
+        if (n == 0)
+            return;
+        // SobolRsg::skipTo(k) positions the sequence so that the next
+        // draw returns the k-th point if no point was drawn yet, and
+        // the (k+1)-th one otherwise
+        unsigned long path = nextPath_ + n;
+        generator_.skipTo(drawn_ ? path-1 : path);
+        lastStep_ = steps_;
+        nextPath_ = path;
+    }
+
     Size SobolBrownianGenerator::numberOfFactors() const { return factors_; }
 
     Size SobolBrownianGenerator::numberOfSteps() const { return steps_; }
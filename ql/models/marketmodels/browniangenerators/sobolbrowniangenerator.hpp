@@ -57,6 +57,11 @@ namespace QuantLib {
         Real nextPath();
         Real nextStep(std::vector<Real>&);
 
+        //! skips to the n-th path of the underlying Sobol sequence
+        void skipTo(unsigned long n);
+        //! skips the next n paths in constant time
+        void skipPaths(Size n);
+
         Size numberOfFactors() const;
         Size numberOfSteps() const;
         
@@ -72,6 +77,9 @@ namespace QuantLib {
         BrownianBridge bridge_;
         // work variables
         Size lastStep_;
+        // index of the next path, and whether any was drawn
+        unsigned long nextPath_;
+        bool drawn_;
         std::vector<std::vector<Size> > orderedIndices_;
         std::vector<std::vector<Real> > bridgedVariates_;
     };
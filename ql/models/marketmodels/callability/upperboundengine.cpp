@@ -28,7 +28,10 @@
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/evolver.hpp>
 #include <ql/models/marketmodels/callability/exercisevalue.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <ql/utilities/null.hpp>
 #include <algorithm>
+#include <numeric>
 
 namespace QuantLib {
 
@@ -103,6 +106,31 @@ namespace QuantLib {
             std::vector<std::vector<CashFlow> > cashFlowsGenerated_;
         };
 
+        // runs the given paths, then adds more until the error on
+        // the sum of the values is within tolerance
+        template <class Engine>
+        void simulate(Engine& engine,
+                      SequenceStatisticsInc& stats,
+                      Size minPaths,
+                      Real tolerance,
+                      Size maxPaths) {
+            engine.multiplePathValues(stats, minPaths);
+            if (tolerance == Null<Real>())
+                return;
+            for (;;) {
+                Size n = stats.samples();
+                if (n < 2 || n >= maxPaths)
+                    return;
+                Matrix covariance = stats.covariance();
+                Real variance = std::accumulate(covariance.begin(),
+                                                covariance.end(), Real(0.0));
+                if (std::sqrt(std::max(variance, 0.0)/n) <= tolerance)
+                    return;
+                engine.multiplePathValues(stats,
+                                          std::min(n, maxPaths-n));
+            }
+        }
+
     }
 
 
@@ -117,9 +145,44 @@ namespace QuantLib {
                    const MarketModelExerciseValue& hedgeRebate,
                    const ExerciseStrategy<CurveState>& hedgeStrategy,
                    Real initialNumeraireValue)
+    : evolver_(evolver), innerEvolvers_(innerEvolvers.size()),
+      innerPathsPerBlock_(1),
+      composite_(MultiProductComposite()),
+      initialNumeraireValue_(initialNumeraireValue) {
+        for (Size i=0; i<innerEvolvers.size(); ++i)
+            innerEvolvers_[i].push_back(innerEvolvers[i]);
+        initialize(underlying, rebate, hedge, hedgeRebate, hedgeStrategy);
+    }
+
+    UpperBoundEngine::UpperBoundEngine(
+                   const boost::shared_ptr<MarketModelEvolver>& evolver,
+                   const std::vector<std::vector<
+                       boost::shared_ptr<MarketModelEvolver> > >&
+                                                                 innerEvolvers,
+                   const MarketModelMultiProduct& underlying,
+                   const MarketModelExerciseValue& rebate,
+                   const MarketModelMultiProduct& hedge,
+                   const MarketModelExerciseValue& hedgeRebate,
+                   const ExerciseStrategy<CurveState>& hedgeStrategy,
+                   Real initialNumeraireValue,
+                   Size innerPathsPerBlock)
     : evolver_(evolver), innerEvolvers_(innerEvolvers),
+      innerPathsPerBlock_(innerPathsPerBlock),
       composite_(MultiProductComposite()),
       initialNumeraireValue_(initialNumeraireValue) {
+        for (Size i=0; i<innerEvolvers_.size(); ++i)
+            QL_REQUIRE(!innerEvolvers_[i].empty(),
+                       "no inner evolvers given for "
+                       << io::ordinal(i+1) << " exercise time");
+        initialize(underlying, rebate, hedge, hedgeRebate, hedgeStrategy);
+    }
+
+    void UpperBoundEngine::initialize(
+                   const MarketModelMultiProduct& underlying,
+                   const MarketModelExerciseValue& rebate,
+                   const MarketModelMultiProduct& hedge,
+                   const MarketModelExerciseValue& hedgeRebate,
+                   const ExerciseStrategy<CurveState>& hedgeStrategy) {
 
         composite_.add(underlying);
         composite_.add(ExerciseAdapter(rebate));
@@ -155,6 +218,17 @@ namespace QuantLib {
             cashFlowsGenerated_[i].resize(
                           composite_.maxNumberOfCashFlowsPerProductPerStep());
 
+        // the inner engines are kept between inner simulations; the
+        // product is replaced each time by the current callable hedge
+        const MarketModelMultiProduct& callable = composite_.item(4);
+        innerEngines_.resize(innerEvolvers_.size());
+        for (Size i=0; i<innerEvolvers_.size(); ++i) {
+            if (innerEvolvers_[i].size() > 1)
+                innerEngines_[i] = boost::shared_ptr<ParallelAccountingEngine>(
+                    new ParallelAccountingEngine(innerEvolvers_[i], callable,
+                                                 1.0, innerPathsPerBlock_));
+        }
+
         const std::vector<Time>& cashFlowTimes =
             composite_.possibleCashFlowTimes();
         const std::vector<Rate>& rateTimes =
@@ -170,14 +244,34 @@ namespace QuantLib {
     void UpperBoundEngine::multiplePathValues(Statistics& stats,
                                               Size outerPaths,
                                               Size innerPaths) {
+        multiplePathValues(stats, outerPaths,
+                           innerPaths, Null<Real>(), innerPaths);
+    }
+
+    void UpperBoundEngine::multiplePathValues(Statistics& stats,
+                                              Size outerPaths,
+                                              Size minInnerPaths,
+                                              Real innerTolerance,
+                                              Size maxInnerPaths) {
         for (Size i=0; i<outerPaths; ++i) {
-            std::pair<Real,Real> result = singlePathValue(innerPaths);
+            std::pair<Real,Real> result =
+                singlePathValue(minInnerPaths, innerTolerance, maxInnerPaths);
             stats.add(result.first, result.second);
         }
     }
 
 
     std::pair<Real,Real> UpperBoundEngine::singlePathValue(Size innerPaths) {
+        return singlePathValue(innerPaths, Null<Real>(), innerPaths);
+    }
+
+    std::pair<Real,Real> UpperBoundEngine::singlePathValue(
+                                                       Size minInnerPaths,
+                                                       Real innerTolerance,
+                                                       Size maxInnerPaths) {
+        QL_REQUIRE(maxInnerPaths >= minInnerPaths,
+                   "maximum number of inner paths (" << maxInnerPaths
+                   << ") less than minimum (" << minInnerPaths << ")");
 
         DecoratedHedge& callable =
             dynamic_cast<DecoratedHedge&>(composite_.item(4));
@@ -245,20 +339,40 @@ namespace QuantLib {
                     // reset() method brings them to the current point
                     // rather than the beginning of the path.
 
-                    boost::shared_ptr<MarketModelEvolver> currentEvolver =
-                        innerEvolvers_[exercise++];
-                    currentEvolver->setInitialState(evolver_->currentState());
+                    const std::vector<boost::shared_ptr<MarketModelEvolver> >&
+                        currentEvolvers = innerEvolvers_[exercise];
+                    for (Size i=0; i<currentEvolvers.size(); ++i)
+                        currentEvolvers[i]->setInitialState(
+                                                   evolver_->currentState());
 
                     callable.stopRecording();
                     callable.enableCallability();
                     callable.save();
 
+                    // the inner tolerance is given in currency units,
+                    // while the inner results are in numeraire units
+                    Real tolerance = innerTolerance == Null<Real>() ?
+                        Null<Real>() :
+                        innerTolerance * principalInNumerairePortfolio
+                                       / initialNumeraireValue_;
+
                     // This allows us to write:
-                    AccountingEngine engine(currentEvolver, callable,
-                                            1.0); // this causes the result
-                                                  // to be in numeraire units
                     SequenceStatisticsInc innerStats(callable.numberOfProducts());
-                    engine.multiplePathValues(innerStats, innerPaths);
+                    if (currentEvolvers.size() == 1) {
+                        AccountingEngine engine(currentEvolvers.front(),
+                                                callable,
+                                                1.0); // this causes the result
+                                                      // to be in numeraire units
+                        simulate(engine, innerStats, minInnerPaths,
+                                 tolerance, maxInnerPaths);
+                    } else {
+                        ParallelAccountingEngine& engine =
+                            *innerEngines_[exercise];
+                        engine.setProduct(callable);
+                        simulate(engine, innerStats, minInnerPaths,
+                                 tolerance, maxInnerPaths);
+                    }
+                    ++exercise;
 
                     const std::vector<Real>& values = innerStats.mean();
                     unexercisedHedgeValue =
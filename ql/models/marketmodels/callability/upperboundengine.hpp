@@ -35,9 +35,23 @@ namespace QuantLib {
     class MarketModelDiscounter;
     class MarketModelMultiProduct;
     class MarketModelExerciseValue;
+    class ParallelAccountingEngine;
 
     //! Market-model %engine for upper-bound estimation
-    /*! \pre product and hedge must have the same rate times
+    /*! The inner simulations can be run by several workers, each
+        with its own inner evolver for each exercise time; in this
+        case, they are run by a ParallelAccountingEngine and their
+        results don't depend on the number of workers.  A single
+        engine is used for each exercise time, so that successive
+        inner simulations continue the sequence of paths of the
+        inner evolvers instead of restarting it.
+
+        The number of inner paths can also be increased adaptively
+        until the error estimate on the value of the unexercised
+        hedge (i.e., on the martingale increment) falls below a
+        given tolerance.
+
+        \pre product and hedge must have the same rate times
              and exercise times
     */
     class UpperBoundEngine {
@@ -52,19 +66,60 @@ namespace QuantLib {
                    const MarketModelExerciseValue& hedgeRebate,
                    const ExerciseStrategy<CurveState>& hedgeStrategy,
                    Real initialNumeraireValue);
+        /*! \param innerEvolvers for each exercise time, the inner
+                                 evolvers to be used by the different
+                                 workers; see ParallelAccountingEngine
+                                 for their requirements.
+            \param innerPathsPerBlock number of inner paths in each
+                                      block assigned to a worker.
+        */
+        UpperBoundEngine(
+                   const boost::shared_ptr<MarketModelEvolver>& evolver,
+                   const std::vector<std::vector<
+                       boost::shared_ptr<MarketModelEvolver> > >&
+                                                                 innerEvolvers,
+                   const MarketModelMultiProduct& underlying,
+                   const MarketModelExerciseValue& rebate,
+                   const MarketModelMultiProduct& hedge,
+                   const MarketModelExerciseValue& hedgeRebate,
+                   const ExerciseStrategy<CurveState>& hedgeStrategy,
+                   Real initialNumeraireValue,
+                   Size innerPathsPerBlock = 64);
         void multiplePathValues(Statistics& stats,
                                 Size outerPaths,
                                 Size innerPaths);
+        /*! Each inner simulation starts with minInnerPaths paths;
+            while the error estimate on the unexercised hedge value
+            exceeds innerTolerance, the number of paths is doubled
+            up to maxInnerPaths.
+        */
+        void multiplePathValues(Statistics& stats,
+                                Size outerPaths,
+                                Size minInnerPaths,
+                                Real innerTolerance,
+                                Size maxInnerPaths);
         std::pair<Real,Real> singlePathValue(Size innerPaths);
+        std::pair<Real,Real> singlePathValue(Size minInnerPaths,
+                                             Real innerTolerance,
+                                             Size maxInnerPaths);
       private:
+        void initialize(const MarketModelMultiProduct& underlying,
+                        const MarketModelExerciseValue& rebate,
+                        const MarketModelMultiProduct& hedge,
+                        const MarketModelExerciseValue& hedgeRebate,
+                        const ExerciseStrategy<CurveState>& hedgeStrategy);
         Real collectCashFlows(Size currentStep,
                               Real principalInNumerairePortfolio,
                               Size beginProduct,
                               Size endProduct) const;
 
         boost::shared_ptr<MarketModelEvolver> evolver_;
-        std::vector<boost::shared_ptr<MarketModelEvolver> > innerEvolvers_;
+        std::vector<std::vector<boost::shared_ptr<MarketModelEvolver> > >
+                                                              innerEvolvers_;
+        Size innerPathsPerBlock_;
         MultiProductComposite composite_;
+        std::vector<boost::shared_ptr<ParallelAccountingEngine> >
+                                                               innerEngines_;
 
         Real initialNumeraireValue_;
         Size underlyingSize_, rebateSize_, hedgeSize_, hedgeRebateSize_;
@@ -181,4 +181,85 @@ namespace QuantLib {
         }
     }
 
+    void LMMDriftCalculator::compute(const Matrix& forwards,
+                                     Matrix& drifts) const {
+        const Size paths = forwards.columns();
+        QL_REQUIRE(forwards.rows()==numberOfRates_,
+                   "forwards.rows() <> dim");
+        QL_REQUIRE(drifts.rows()==numberOfRates_ && drifts.columns()==paths,
+                   "drifts size not consistent with forwards");
+
+        if (blockTmp_.rows()!=numberOfRates_ || blockTmp_.columns()!=paths) {
+            blockTmp_ = Matrix(numberOfRates_, paths);
+            blockE_ = Matrix(numberOfFactors_, paths);
+        }
+
+        // Precompute forwards factor
+        Size i, p;
+        for (i=alive_; i<numberOfRates_; ++i) {
+            const Real d = displacements_[i], t = oneOverTaus_[i];
+            const Real* f = forwards.row_begin(i);
+            Real* x = blockTmp_.row_begin(i);
+            for (p=0; p<paths; ++p)
+                x[p] = (f[p]+d)/(t+f[p]);
+        }
+
+        if (isFullFactor_) {
+            // same as computePlain, path by path
+            for (i=alive_; i<numberOfRates_; ++i) {
+                Real* mu = drifts.row_begin(i);
+                std::fill(mu, mu+paths, 0.0);
+                for (Size k=downs_[i]; k<ups_[i]; ++k) {
+                    const Real c = C_[i][k];
+                    const Real* x = blockTmp_.row_begin(k);
+                    for (p=0; p<paths; ++p)
+                        mu[p] += x[p]*c;
+                }
+                if (numeraire_>i+1) {
+                    for (p=0; p<paths; ++p)
+                        mu[p] = -mu[p];
+                }
+            }
+            return;
+        }
+
+        // same as computeReduced, path by path; only the current
+        // partial sums e_r are kept for each factor.
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        std::fill(blockE_.begin(), blockE_.end(), 0.0);
+        for (Integer n=static_cast<Integer>(numeraire_)-2;
+             n>=static_cast<Integer>(alive_); --n) {
+            i = n;
+            Real* mu = drifts.row_begin(i);
+            std::fill(mu, mu+paths, 0.0);
+            const Real* x = blockTmp_.row_begin(i+1);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                const Real a = pseudo_[i+1][r], b = pseudo_[i][r];
+                Real* e = blockE_.row_begin(r);
+                for (p=0; p<paths; ++p) {
+                    e[p] += x[p]*a;
+                    mu[p] -= e[p]*b;
+                }
+            }
+        }
+
+        std::fill(blockE_.begin(), blockE_.end(), 0.0);
+        for (i=numeraire_; i<numberOfRates_; ++i) {
+            Real* mu = drifts.row_begin(i);
+            std::fill(mu, mu+paths, 0.0);
+            const Real* x = blockTmp_.row_begin(i);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                const Real a = pseudo_[i][r];
+                Real* e = blockE_.row_begin(r);
+                for (p=0; p<paths; ++p) {
+                    e[p] += x[p]*a;
+                    mu[p] += e[p]*a;
+                }
+            }
+        }
+    }
+
 }
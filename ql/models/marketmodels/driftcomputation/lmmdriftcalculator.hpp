@@ -64,6 +64,13 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        /*! Computes the drifts for a block of paths.  Both matrices
+            have a row for each rate and a column for each path, so
+            that the innermost loops run over contiguous paths and
+            can be vectorized; the results are the same as those of
+            compute() for each path. */
+        void compute(const Matrix& fwds, Matrix& drifts) const;
+
       private:
         Size numberOfRates_, numberOfFactors_;
         bool isFullFactor_;
@@ -74,6 +81,7 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        mutable Matrix blockTmp_, blockE_;
         std::vector<Size> downs_, ups_;
     };
 
@@ -38,6 +38,15 @@ namespace QuantLib {
 
         virtual const std::vector<Size>& numeraires() const = 0;
         virtual Real startNewPath() = 0;
+        //! skips the next n paths
+        /*! The default implementation starts and discards them;
+            evolvers whose paths only depend on their Brownian
+            generator should forward the call to it.
+        */
+        virtual void skipPaths(Size n) {
+            for (Size i=0; i<n; ++i)
+                startNewPath();
+        }
         virtual Real advanceStep() = 0;
         virtual Size currentStep() const = 0;
         virtual const CurveState& currentState() const = 0;
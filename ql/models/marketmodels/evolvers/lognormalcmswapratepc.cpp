@@ -106,6 +106,10 @@ namespace QuantLib {
         return generator_->nextPath();
     }
 
+    void LogNormalCmSwapRatePc::skipPaths(Size n) {
+        generator_->skipPaths(n);
+    }
+
     Real LogNormalCmSwapRatePc::advanceStep()
     {
         // we're going from T1 to T2
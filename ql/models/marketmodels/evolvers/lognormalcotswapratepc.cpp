@@ -104,6 +104,10 @@ namespace QuantLib {
         return generator_->nextPath();
     }
 
+    void LogNormalCotSwapRatePc::skipPaths(Size n) {
+        generator_->skipPaths(n);
+    }
+
     Real LogNormalCotSwapRatePc::advanceStep()
     {
          //we're going from T1 to T2
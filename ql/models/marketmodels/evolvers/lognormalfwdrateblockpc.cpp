@@ -0,0 +1,247 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateblockpc.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+
+namespace QuantLib {
+
+    LogNormalFwdRateBlockPc::LogNormalFwdRateBlockPc(
+                           const boost::shared_ptr<MarketModel>& marketModel,
+                           const BrownianGeneratorFactory& factory,
+                           const std::vector<Size>& numeraires,
+                           Size initialStep,
+                           Size blockSize)
+    : marketModel_(marketModel),
+      numeraires_(numeraires),
+      initialStep_(initialStep), blockSize_(blockSize),
+      numberOfRates_(marketModel->numberOfRates()),
+      numberOfFactors_(marketModel_->numberOfFactors()),
+      numberOfSteps_(marketModel->evolution().numberOfSteps()-initialStep),
+      curveState_(marketModel->evolution().rateTimes()),
+      currentPath_(blockSize),
+      forwards_(marketModel->initialRates()),
+      displacements_(marketModel->displacements()),
+      initialLogForwards_(numberOfRates_),
+      currentForwards_(numberOfRates_),
+      initialDrifts_(numberOfRates_), brownians_(numberOfFactors_),
+      alive_(marketModel->evolution().firstAliveRate()),
+      logForwards_(numberOfRates_, blockSize),
+      blockForwards_(numberOfRates_, blockSize),
+      drifts1_(numberOfRates_, blockSize),
+      drifts2_(numberOfRates_, blockSize),
+      blockBrownians_(numberOfSteps_, Matrix(numberOfFactors_, blockSize)),
+      evolvedForwards_(numberOfSteps_, Matrix(blockSize, numberOfRates_)),
+      pathWeights_(blockSize),
+      stepWeights_(numberOfSteps_, blockSize)
+    {
+        checkCompatibility(marketModel->evolution(), numeraires);
+        QL_REQUIRE(blockSize_ > 0, "null block size");
+
+        Size steps = marketModel->evolution().numberOfSteps();
+
+        generator_ = factory.create(numberOfFactors_, numberOfSteps_);
+
+        currentStep_ = initialStep_;
+
+        calculators_.reserve(steps);
+        fixedDrifts_.reserve(steps);
+        for (Size j=0; j<steps; ++j) {
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            calculators_.push_back(
+                LMMDriftCalculator(A,
+                                   displacements_,
+                                   marketModel->evolution().rateTaus(),
+                                   numeraires[j],
+                                   alive_[j]));
+            std::vector<Real> fixed(numberOfRates_);
+            for (Size k=0; k<numberOfRates_; ++k) {
+                Real variance =
+                    std::inner_product(A.row_begin(k), A.row_end(k),
+                                       A.row_begin(k), 0.0);
+                fixed[k] = -0.5*variance;
+            }
+            fixedDrifts_.push_back(fixed);
+        }
+
+        setForwards(marketModel_->initialRates());
+    }
+
+    const std::vector<Size>& LogNormalFwdRateBlockPc::numeraires() const {
+        return numeraires_;
+    }
+
+    void LogNormalFwdRateBlockPc::setForwards(
+                                          const std::vector<Real>& forwards) {
+        QL_REQUIRE(forwards.size()==numberOfRates_,
+                   "mismatch between forwards and rateTimes");
+        for (Size i=0; i<numberOfRates_; ++i)
+             initialLogForwards_[i] = std::log(forwards[i] +
+                                               displacements_[i]);
+        calculators_[initialStep_].compute(forwards, initialDrifts_);
+        // the current block, if any, must be evolved again
+        if (currentPath_ < blockSize_)
+            evolveBlock();
+    }
+
+    void LogNormalFwdRateBlockPc::setInitialState(const CurveState& cs) {
+        setForwards(cs.forwardRates());
+    }
+
+    Real LogNormalFwdRateBlockPc::startNewPath() {
+        if (currentPath_+1 >= blockSize_) {
+            generateBlock();
+            currentPath_ = 0;
+            evolveBlock();
+        } else {
+            ++currentPath_;
+        }
+        currentStep_ = initialStep_;
+        return pathWeights_[currentPath_];
+    }
+
+    void LogNormalFwdRateBlockPc::skipPaths(Size n) {
+        // first, the paths already evolved in the current block...
+        Size left =
+            currentPath_+1 < blockSize_ ? blockSize_-1-currentPath_ : 0;
+        if (n <= left) {
+            currentPath_ += n;
+            return;
+        }
+        n -= left;
+        // ...then whole blocks, which are never evolved...
+        generator_->skipPaths((n/blockSize_)*blockSize_);
+        Size rest = n % blockSize_;
+        if (rest == 0) {
+            currentPath_ = blockSize_-1;
+        } else {
+            // ...and the first paths of a block that will be used
+            generateBlock();
+            evolveBlock();
+            currentPath_ = rest-1;
+        }
+    }
+
+    Real LogNormalFwdRateBlockPc::advanceStep() {
+        Size s = currentStep_-initialStep_;
+        const Matrix& forwards = evolvedForwards_[s];
+        std::copy(forwards.row_begin(currentPath_),
+                  forwards.row_end(currentPath_),
+                  currentForwards_.begin());
+        curveState_.setOnForwardRates(currentForwards_);
+        ++currentStep_;
+        return stepWeights_[s][currentPath_];
+    }
+
+    Size LogNormalFwdRateBlockPc::currentStep() const {
+        return currentStep_;
+    }
+
+    const CurveState& LogNormalFwdRateBlockPc::currentState() const {
+        return curveState_;
+    }
+
+    void LogNormalFwdRateBlockPc::generateBlock() {
+        // same order as drawing the variates path by path
+        for (Size p=0; p<blockSize_; ++p) {
+            pathWeights_[p] = generator_->nextPath();
+            for (Size s=0; s<numberOfSteps_; ++s) {
+                stepWeights_[s][p] = generator_->nextStep(brownians_);
+                for (Size r=0; r<numberOfFactors_; ++r)
+                    blockBrownians_[s][r][p] = brownians_[r];
+            }
+        }
+    }
+
+    void LogNormalFwdRateBlockPc::evolveBlock() {
+        const Size paths = blockSize_;
+        Size i, p;
+        for (i=0; i<numberOfRates_; ++i) {
+            std::fill(logForwards_.row_begin(i), logForwards_.row_end(i),
+                      initialLogForwards_[i]);
+            std::fill(blockForwards_.row_begin(i), blockForwards_.row_end(i),
+                      forwards_[i]);
+        }
+
+        for (Size s=0; s<numberOfSteps_; ++s) {
+            // we're going from T1 to T2
+            const Size j = initialStep_+s;
+            const Size alive = alive_[j];
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            const Matrix& W = blockBrownians_[s];
+            const std::vector<Real>& fixedDrift = fixedDrifts_[j];
+
+            // a) compute drifts D1 at T1;
+            if (s > 0) {
+                calculators_[j].compute(blockForwards_, drifts1_);
+            } else {
+                for (i=alive; i<numberOfRates_; ++i)
+                    std::fill(drifts1_.row_begin(i), drifts1_.row_end(i),
+                              initialDrifts_[i]);
+            }
+
+            // b) evolve forwards up to T2 using D1 (the rows of D2
+            //    are used as workspace for the diffusion terms);
+            for (i=alive; i<numberOfRates_; ++i) {
+                Real* x = logForwards_.row_begin(i);
+                Real* f = blockForwards_.row_begin(i);
+                Real* z = drifts2_.row_begin(i);
+                const Real* d1 = drifts1_.row_begin(i);
+                const Real c = fixedDrift[i], d = displacements_[i];
+                std::fill(z, z+paths, 0.0);
+                for (Size r=0; r<numberOfFactors_; ++r) {
+                    const Real a = A[i][r];
+                    const Real* w = W.row_begin(r);
+                    for (p=0; p<paths; ++p)
+                        z[p] += a*w[p];
+                }
+                for (p=0; p<paths; ++p) {
+                    x[p] += d1[p] + c;
+                    x[p] += z[p];
+                    f[p] = std::exp(x[p]) - d;
+                }
+            }
+
+            // c) recompute drifts D2 using the predicted forwards;
+            calculators_[j].compute(blockForwards_, drifts2_);
+
+            // d) correct forwards using both drifts
+            for (i=alive; i<numberOfRates_; ++i) {
+                Real* x = logForwards_.row_begin(i);
+                Real* f = blockForwards_.row_begin(i);
+                const Real* d1 = drifts1_.row_begin(i);
+                const Real* d2 = drifts2_.row_begin(i);
+                const Real d = displacements_[i];
+                for (p=0; p<paths; ++p) {
+                    x[p] += (d2[p]-d1[p])/2.0;
+                    f[p] = std::exp(x[p]) - d;
+                }
+            }
+
+            // e) store the results path by path
+            Matrix& evolved = evolvedForwards_[s];
+            for (i=0; i<numberOfRates_; ++i) {
+                const Real* f = blockForwards_.row_begin(i);
+                for (p=0; p<paths; ++p)
+                    evolved[p][i] = f[p];
+            }
+        }
+    }
+
+}
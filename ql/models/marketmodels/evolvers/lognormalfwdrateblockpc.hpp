@@ -0,0 +1,102 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lognormalfwdrateblockpc.hpp
+    \brief Predictor-corrector evolver working on blocks of paths
+*/
+
+#ifndef quantlib_forward_rate_block_pc_evolver_hpp
+#define quantlib_forward_rate_block_pc_evolver_hpp
+
+#include <ql/models/marketmodels/evolver.hpp>
+#include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+
+namespace QuantLib {
+
+    class MarketModel;
+    class BrownianGenerator;
+    class BrownianGeneratorFactory;
+
+    //! Predictor-Corrector working on blocks of paths
+    /*! This evolver gives the same paths as LogNormalFwdRatePc, but
+        evolves a whole block of paths at a time when the first of
+        them is started; the following calls to startNewPath() and
+        advanceStep() only return the stored results.
+
+        During the evolution, forward rates, drifts and Brownian
+        variates are stored with a row for each rate (or factor) and
+        a column for each path; this way, the drift computation
+        (see LMMDriftCalculator::compute) and the exponentiation of
+        the log-forwards run over contiguous arrays of paths and can
+        be vectorized by the compiler.
+
+        The variates of each block are drawn from the Brownian
+        generator in the same order as LogNormalFwdRatePc does, and
+        they are stored so that the block can be evolved again if
+        the initial state is changed.
+    */
+    class LogNormalFwdRateBlockPc : public MarketModelEvolver {
+      public:
+        LogNormalFwdRateBlockPc(const boost::shared_ptr<MarketModel>&,
+                                const BrownianGeneratorFactory&,
+                                const std::vector<Size>& numeraires,
+                                Size initialStep = 0,
+                                Size blockSize = 64);
+        //! \name MarketModel interface
+        //@{
+        const std::vector<Size>& numeraires() const;
+        Real startNewPath();
+        void skipPaths(Size n);
+        Real advanceStep();
+        Size currentStep() const;
+        const CurveState& currentState() const;
+        void setInitialState(const CurveState&);
+        //@}
+      private:
+        void setForwards(const std::vector<Real>& forwards);
+        void generateBlock();
+        void evolveBlock();
+        // inputs
+        boost::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size initialStep_, blockSize_;
+        boost::shared_ptr<BrownianGenerator> generator_;
+        // fixed variables
+        std::vector<std::vector<Real> > fixedDrifts_;
+        // working variables
+        Size numberOfRates_, numberOfFactors_, numberOfSteps_;
+        LMMCurveState curveState_;
+        Size currentStep_, currentPath_;
+        std::vector<Rate> forwards_, displacements_, initialLogForwards_;
+        std::vector<Rate> currentForwards_;
+        std::vector<Real> initialDrifts_, brownians_;
+        std::vector<Size> alive_;
+        // block of paths: rates (or factors) by paths...
+        Matrix logForwards_, blockForwards_, drifts1_, drifts2_;
+        std::vector<Matrix> blockBrownians_;
+        // ...and results, paths by rates
+        std::vector<Matrix> evolvedForwards_;
+        std::vector<Real> pathWeights_;
+        Matrix stepWeights_;
+        // helper classes
+        std::vector<LMMDriftCalculator> calculators_;
+    };
+
+}
+
+#endif
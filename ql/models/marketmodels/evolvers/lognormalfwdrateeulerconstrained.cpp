@@ -157,6 +157,10 @@ namespace QuantLib {
         return generator_->nextPath();
     }
 
+    void LogNormalFwdRateEulerConstrained::skipPaths(Size n) {
+        generator_->skipPaths(n);
+    }
+
     Real LogNormalFwdRateEulerConstrained::advanceStep()
     {
         // we're going from T1 to T2
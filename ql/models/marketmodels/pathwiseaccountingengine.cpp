@@ -1121,15 +1121,24 @@ namespace QuantLib {
     void PathwiseVegasOuterAccountingEngine::multiplePathValuesElementary(std::vector<Real>& means, std::vector<Real>& errors,
         Size numberOfPaths)
     {
-        Size numberOfElementaryVegas = numberRates_*numberSteps_*factors_;
-
-        std::vector<Real> values(product_->numberOfProducts()*(1+numberRates_+numberOfElementaryVegas));
-        means.resize(values.size());
-        errors.resize(values.size());
-        std::vector<Real> sums(values.size(),0.0);
-        std::vector<Real> sumsqs(values.size(),0.0);
+        ElementarySums sums(numberOfElementaryValues());
+        accumulateElementary(sums, numberOfPaths);
+        sums.results(means, errors);
+    }
 
+    Size PathwiseVegasOuterAccountingEngine::numberOfElementaryValues() const
+    {
+        Size numberOfElementaryVegas = numberRates_*numberSteps_*factors_;
+        return product_->numberOfProducts()*(1+numberRates_+numberOfElementaryVegas);
+    }
 
+    void PathwiseVegasOuterAccountingEngine::accumulateElementary(ElementarySums& sums,
+        Size numberOfPaths)
+    {
+        std::vector<Real> values(numberOfElementaryValues());
+        QL_REQUIRE(sums.sums.size() == values.size(),
+                   "sums have size " << sums.sums.size()
+                   << ", " << values.size() << " required");
 
         for (Size i=0; i<numberOfPaths; ++i)
         {
@@ -1137,18 +1146,43 @@ namespace QuantLib {
           
           for (Size j=0; j < values.size(); ++j)
             {
-                sums[j] += values[j];
-                sumsqs[j] += values[j]*values[j];
+                sums.sums[j] += values[j];
+                sums.squares[j] += values[j]*values[j];
 
             }
         }
+        sums.samples += numberOfPaths;
+    }
+
+    PathwiseVegasOuterAccountingEngine::ElementarySums::ElementarySums(Size size)
+    : sums(size, 0.0), squares(size, 0.0), samples(0) {}
+
+    void PathwiseVegasOuterAccountingEngine::ElementarySums::merge(
+                                                const ElementarySums& other)
+    {
+        QL_REQUIRE(other.sums.size() == sums.size(),
+                   "size mismatch: " << sums.size() << " required, "
+                   << other.sums.size() << " provided");
+        for (Size j=0; j < sums.size(); ++j)
+        {
+            sums[j] += other.sums[j];
+            squares[j] += other.squares[j];
+        }
+        samples += other.samples;
+    }
 
-        for (Size j=0; j < values.size(); ++j)
+    void PathwiseVegasOuterAccountingEngine::ElementarySums::results(
+        std::vector<Real>& means, std::vector<Real>& errors) const
+    {
+        means.resize(sums.size());
+        errors.resize(sums.size());
+
+        for (Size j=0; j < sums.size(); ++j)
             {
-                means[j] = sums[j]/numberOfPaths;
-                Real meanSq = sumsqs[j]/numberOfPaths;
+                means[j] = sums[j]/samples;
+                Real meanSq = squares[j]/samples;
                 Real variance = meanSq - means[j]*means[j];
-                errors[j] = std::sqrt(variance/numberOfPaths);
+                errors[j] = std::sqrt(variance/samples);
 
             }
     }
@@ -1160,6 +1194,14 @@ namespace QuantLib {
 
             multiplePathValuesElementary(allMeans,allErrors,numberOfPaths);
 
+            combineVegas(allMeans, allErrors, means, errors);
+        }
+
+        void PathwiseVegasOuterAccountingEngine::combineVegas(const std::vector<Real>& allMeans,
+                                                              const std::vector<Real>& allErrors,
+                                                              std::vector<Real>& means,
+                                                              std::vector<Real>& errors) const
+        {
             Size outDataPerProduct = 1+numberRates_+numberBumps_;
             Size inDataPerProduct = 1+numberRates_+numberElementaryVegas_;
 
@@ -1192,6 +1234,84 @@ namespace QuantLib {
 
         } // end of method
 
+
+    namespace {
+
+        std::vector<boost::shared_ptr<MarketModelEvolver> >
+        upcast(const std::vector<boost::shared_ptr<LogNormalFwdRateEuler> >& evolvers)
+        {
+            return std::vector<boost::shared_ptr<MarketModelEvolver> >(
+                                            evolvers.begin(), evolvers.end());
+        }
+
+    }
+
+    ParallelPathwiseAccountingEngine::ParallelPathwiseAccountingEngine(
+        const std::vector<boost::shared_ptr<LogNormalFwdRateEuler> >& evolvers,
+        const Clone<MarketModelPathwiseMultiProduct>& product,
+        const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+        Real initialNumeraireValue,
+        Size pathsPerBlock)
+    : numberValues_(product->numberOfProducts()*(pseudoRootStructure->numberOfRates()+1)),
+      scheduler_(upcast(evolvers), pathsPerBlock)
+    {
+        workers_.reserve(evolvers.size());
+        // each worker clones the product
+        for (Size i=0; i<evolvers.size(); ++i)
+            workers_.push_back(PathwiseAccountingEngine(evolvers[i], product,
+                                                        pseudoRootStructure,
+                                                        initialNumeraireValue));
+    }
+
+    void ParallelPathwiseAccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
+        Size numberOfPaths)
+    {
+        scheduler_.simulate(workers_,
+                            &PathwiseAccountingEngine::multiplePathValues,
+                            SequenceStatisticsInc(numberValues_),
+                            stats, numberOfPaths);
+    }
+
+
+    ParallelPathwiseVegasOuterAccountingEngine::ParallelPathwiseVegasOuterAccountingEngine(
+        const std::vector<boost::shared_ptr<LogNormalFwdRateEuler> >& evolvers,
+        const Clone<MarketModelPathwiseMultiProduct>& product,
+        const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+        const std::vector<std::vector<Matrix> >& vegaBumps,
+        Real initialNumeraireValue,
+        Size pathsPerBlock)
+    : scheduler_(upcast(evolvers), pathsPerBlock)
+    {
+        workers_.reserve(evolvers.size());
+        for (Size i=0; i<evolvers.size(); ++i)
+            workers_.push_back(PathwiseVegasOuterAccountingEngine(
+                                   evolvers[i], product, pseudoRootStructure,
+                                   vegaBumps, initialNumeraireValue));
+    }
+
+    void ParallelPathwiseVegasOuterAccountingEngine::multiplePathValuesElementary(
+        std::vector<Real>& means, std::vector<Real>& errors, Size numberOfPaths)
+    {
+        typedef PathwiseVegasOuterAccountingEngine::ElementarySums sums_type;
+        sums_type empty(workers_.front().numberOfElementaryValues());
+        sums_type sums(empty);
+        scheduler_.simulate(workers_,
+                            &PathwiseVegasOuterAccountingEngine::accumulateElementary,
+                            empty, sums, numberOfPaths);
+        sums.results(means, errors);
+    }
+
+    void ParallelPathwiseVegasOuterAccountingEngine::multiplePathValues(
+        std::vector<Real>& means, std::vector<Real>& errors, Size numberOfPaths)
+    {
+        std::vector<Real> allMeans;
+        std::vector<Real> allErrors;
+
+        multiplePathValuesElementary(allMeans, allErrors, numberOfPaths);
+
+        workers_.front().combineVegas(allMeans, allErrors, means, errors);
+    }
+
 } // end of namespace
 
 
@@ -22,6 +22,7 @@
 #ifndef quantlib_pathwise_accounting_engine_hpp
 #define quantlib_pathwise_accounting_engine_hpp
 
+#include <ql/models/marketmodels/accountingengine.hpp>
 #include <ql/models/marketmodels/pathwisemultiproduct.hpp>
 #include <ql/models/marketmodels/pathwisediscounter.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
@@ -208,6 +209,25 @@ namespace QuantLib {
                                 std::vector<Real>& errors,
                                 Size numberOfPaths);
 
+        //! sums over paths of the elementary values and of their squares
+        struct ElementarySums {
+            explicit ElementarySums(Size size = 0);
+            void merge(const ElementarySums& other);
+            //! means and standard errors of the values
+            void results(std::vector<Real>& means,
+                         std::vector<Real>& errors) const;
+            std::vector<Real> sums, squares;
+            Size samples;
+        };
+        Size numberOfElementaryValues() const;
+        //! adds the elementary values of the next paths to the sums
+        void accumulateElementary(ElementarySums& sums, Size numberOfPaths);
+        //! combines elementary means and errors into vegas with respect to VegaBumps
+        void combineVegas(const std::vector<Real>& allMeans,
+                          const std::vector<Real>& allErrors,
+                          std::vector<Real>& means,
+                          std::vector<Real>& errors) const;
+
       private:
           Real singlePathValues(std::vector<Real>& values);
 
@@ -272,6 +292,71 @@ namespace QuantLib {
 */
     };
 
+    //! Pathwise deltas computed in parallel
+    /*! Each worker has its own Euler evolver and its own copy of the
+        product; paths are distributed among workers in blocks as
+        described for detail::PathBlockScheduler.  Results equal the
+        ones of PathwiseAccountingEngine up to rounding.
+
+        \pre The evolvers must be built from the same market model,
+             Brownian-generator factory, numeraires and initial step.
+
+        This is tested in MarketModelTest::testParallelPathwiseEngines
+    */
+    class ParallelPathwiseAccountingEngine {
+      public:
+        ParallelPathwiseAccountingEngine(
+            const std::vector<boost::shared_ptr<LogNormalFwdRateEuler> >&
+                                                                  evolvers,
+            const Clone<MarketModelPathwiseMultiProduct>& product,
+            const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+            Real initialNumeraireValue,
+            Size pathsPerBlock = 1024);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        std::vector<PathwiseAccountingEngine> workers_;
+        Size numberValues_;
+        detail::PathBlockScheduler scheduler_;
+    };
+
+    //! Pathwise deltas and vegas computed in parallel
+    /*! Each worker is a PathwiseVegasOuterAccountingEngine with its
+        own Euler evolver; paths are distributed among workers in
+        blocks as described for detail::PathBlockScheduler.  Results
+        equal the ones of PathwiseVegasOuterAccountingEngine up to
+        rounding.
+
+        \pre The evolvers must be built from the same market model,
+             Brownian-generator factory, numeraires and initial step.
+
+        This is tested in MarketModelTest::testParallelPathwiseEngines
+    */
+    class ParallelPathwiseVegasOuterAccountingEngine {
+      public:
+        ParallelPathwiseVegasOuterAccountingEngine(
+            const std::vector<boost::shared_ptr<LogNormalFwdRateEuler> >&
+                                                                  evolvers,
+            const Clone<MarketModelPathwiseMultiProduct>& product,
+            const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+            const std::vector<std::vector<Matrix> >& VegaBumps,
+            Real initialNumeraireValue,
+            Size pathsPerBlock = 1024);
+
+        //! Use to get vegas with respect to VegaBumps
+        void multiplePathValues(std::vector<Real>& means,
+                                std::vector<Real>& errors,
+                                Size numberOfPaths);
+
+        //! Use to get vegas with respect to pseudo-root-elements
+        void multiplePathValuesElementary(std::vector<Real>& means,
+                                          std::vector<Real>& errors,
+                                          Size numberOfPaths);
+      private:
+        std::vector<PathwiseVegasOuterAccountingEngine> workers_;
+        detail::PathBlockScheduler scheduler_;
+    };
+
 }
 
 #endif
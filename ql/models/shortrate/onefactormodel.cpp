@@ -89,6 +89,25 @@ namespace QuantLib {
     : TreeLattice1D<OneFactorModel::ShortRateTree>(timeGrid, tree->size(1)),
       tree_(tree), dynamics_(dynamics) {}
 
+    void OneFactorModel::ShortRateTree::stepback(Size i,
+                                                 const Array& values,
+                                                 Array& newValues) const {
+        const std::vector<Size>& k = tree_->descendants(i);
+        const std::vector<Real>& p0 = tree_->probabilities(i, 0);
+        const std::vector<Real>& p1 = tree_->probabilities(i, 1);
+        const std::vector<Real>& p2 = tree_->probabilities(i, 2);
+        const Array& discounts = this->discounts(i);
+        const Real* v = values.begin();
+        Real* result = newValues.begin();
+        const long n = long(size(i));
+        #pragma omp parallel for
+        for (long j=0; j<n; j++) {
+            const Real* w = v + k[j];
+            result[j] = (p0[j]*w[0] + p1[j]*w[1] + p2[j]*w[2])
+                      * discounts[j];
+        }
+    }
+
     OneFactorModel::OneFactorModel(Size nArguments)
     : ShortRateModel(nArguments) {}
 
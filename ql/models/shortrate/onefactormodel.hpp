@@ -103,6 +103,12 @@ namespace QuantLib {
         Real probability(Size i, Size index, Size branch) const {
             return tree_->probability(i, index, branch);
         }
+        /*! Rollback on the contiguous branching data of the
+            trinomial tree and on cached discount factors; the
+            results are the same as those of the generic
+            TreeLattice implementation.
+        */
+        void stepback(Size i, const Array& values, Array& newValues) const;
       private:
         boost::shared_ptr<TrinomialTree> tree_;
         boost::shared_ptr<ShortRateDynamics> dynamics_;
@@ -255,21 +255,14 @@ const Disposable<Array> Gaussian1dModel::yGrid(const Real stdDevs,
 
     Array result(2 * gridPoints + 1, 0.0);
 
-    Real x_t, e_0_t, e_t_T, stdDev_0_t, stdDev_t_T;
-    Real stdDev_0_T = stateProcess_->stdDeviation(0.0, 0.0, T);
-    Real e_0_T = stateProcess_->expectation(0.0, 0.0, T);
+    const GridMoments m = gridMoments(T, t);
+
+    Real e_t_T, stdDev_t_T = m.stdDev_t_T;
 
     if (t < QL_EPSILON) {
-        // stdDev_0_t = 0.0;
-        stdDev_t_T = stdDev_0_T;
-        // e_0_t = 0.0;
-        // x_t = 0.0;
-        e_t_T = e_0_T;
+        e_t_T = m.e_0_T;
     } else {
-        stdDev_0_t = stateProcess_->stdDeviation(0.0, 0.0, t);
-        stdDev_t_T = stateProcess_->stdDeviation(t, 0.0, T - t);
-        e_0_t = stateProcess_->expectation(0.0, 0.0, t);
-        x_t = y * stdDev_0_t + e_0_t;
+        Real x_t = y * m.stdDev_0_t + m.e_0_t;
         e_t_T = stateProcess_->expectation(t, x_t, T - t);
     }
 
@@ -277,9 +270,79 @@ const Disposable<Array> Gaussian1dModel::yGrid(const Real stdDevs,
 
     for (int j = -gridPoints; j <= gridPoints; j++) {
         result[j + gridPoints] =
-            (e_t_T + stdDev_t_T * ((Real)j) * h - e_0_T) / stdDev_0_T;
+            (e_t_T + stdDev_t_T * ((Real)j) * h - m.e_0_T) / m.stdDev_0_T;
     }
 
     return result;
 }
+
+const Gaussian1dModel::GridMoments
+Gaussian1dModel::gridMoments(const Time T, const Time t) const {
+
+    // the cache is only valid for a calculated model, otherwise
+    // (e.g. during the initialization of derived classes) the
+    // moments are computed from scratch
+    std::pair<Time, Time> k(T, t);
+    if (calculated_) {
+        MomentsCacheType::iterator i = momentsCache_.find(k);
+        if (i != momentsCache_.end())
+            return i->second;
+    }
+
+    GridMoments m;
+    m.stdDev_0_T = stateProcess_->stdDeviation(0.0, 0.0, T);
+    m.e_0_T = stateProcess_->expectation(0.0, 0.0, T);
+    if (t < QL_EPSILON) {
+        m.stdDev_0_t = 0.0;
+        m.stdDev_t_T = m.stdDev_0_T;
+        m.e_0_t = 0.0;
+    } else {
+        m.stdDev_0_t = stateProcess_->stdDeviation(0.0, 0.0, t);
+        m.stdDev_t_T = stateProcess_->stdDeviation(t, 0.0, T - t);
+        m.e_0_t = stateProcess_->expectation(0.0, 0.0, t);
+    }
+    if (calculated_)
+        momentsCache_.insert(std::make_pair(k, m));
+    return m;
+}
+
+const Array &Gaussian1dModel::gridValues(
+    GridCacheType &cache, const CachedGridKey &k, const bool numeraire,
+    const Handle<YieldTermStructure> &yts) const {
+
+    calculate();
+
+    GridCacheType::iterator i = cache.find(k);
+    if (i != cache.end())
+        return i->second;
+
+    // changes of an external curve must invalidate the cache, too
+    if (!yts.empty())
+        curveObserver_->registerWith(yts);
+
+    Array z = yGrid(k.yStdDevs, k.gridPoints);
+    Array result(z.size());
+    for (Size j = 0; j < z.size(); ++j)
+        result[j] = numeraire ? numeraireImpl(k.t, z[j], yts)
+                              : zerobondImpl(k.T, k.t, z[j], yts);
+    return cache.insert(std::make_pair(k, result)).first->second;
+}
+
+const Array &
+Gaussian1dModel::zerobondGrid(const Time T, const Time t, const Real yStdDevs,
+                              const int gridPoints,
+                              const Handle<YieldTermStructure> &yts) const {
+    CachedGridKey k = {T, t, yStdDevs, gridPoints,
+                       yts.empty() ? 0 : yts.currentLink().get()};
+    return gridValues(zerobondGridCache_, k, false, yts);
+}
+
+const Array &
+Gaussian1dModel::numeraireGrid(const Time t, const Real yStdDevs,
+                               const int gridPoints,
+                               const Handle<YieldTermStructure> &yts) const {
+    CachedGridKey k = {t, t, yStdDevs, gridPoints,
+                       yts.empty() ? 0 : yts.currentLink().get()};
+    return gridValues(numeraireGridCache_, k, true, yts);
+}
 }
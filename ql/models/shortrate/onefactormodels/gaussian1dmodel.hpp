@@ -148,6 +148,22 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
                                   const Real T = 1.0, const Real t = 0,
                                   const Real y = 0) const;
 
+    /*! Returns the zerobond prices P(t,T) for all points of the
+        standardized grid yGrid(yStdDevs, gridPoints) at time t.
+        The results are cached until the model is updated; the
+        reference is valid until then, too. */
+    const Array &zerobondGrid(
+        const Time T, const Time t, const Real yStdDevs,
+        const int gridPoints,
+        const Handle<YieldTermStructure> &yts = Handle<YieldTermStructure>()) const;
+
+    /*! Returns the numeraire values at time t for all points of the
+        standardized grid yGrid(yStdDevs, gridPoints), cached as
+        above. */
+    const Array &numeraireGrid(
+        const Time t, const Real yStdDevs, const int gridPoints,
+        const Handle<YieldTermStructure> &yts = Handle<YieldTermStructure>()) const;
+
   private:
     // It is of great importance for performance reasons to cache underlying
     // swaps generated from indexes. In addition the indexes may only be given
@@ -181,10 +197,71 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
 
     mutable CacheType swapCache_;
 
+    // Engines evaluate zerobonds and numeraires on the same grid of
+    // the state variable for every exercise date and cash flow, and
+    // the conditional grids in yGrid only depend on the state through
+    // the conditional expectation.  Both are cached here and the
+    // caches are cleared whenever the model is recalculated or an
+    // external curve used for the cached values changes.
+
+    struct CachedGridKey {
+        Time T, t;
+        Real yStdDevs;
+        int gridPoints;
+        const YieldTermStructure *yts;
+        bool operator==(const CachedGridKey &o) const {
+            return T == o.T && t == o.t && yStdDevs == o.yStdDevs &&
+                   gridPoints == o.gridPoints && yts == o.yts;
+        }
+    };
+
+    struct CachedGridKeyHasher
+        : std::unary_function<CachedGridKey, std::size_t> {
+        std::size_t operator()(CachedGridKey const &x) const {
+            std::size_t seed = 0;
+            boost::hash_combine(seed, x.T);
+            boost::hash_combine(seed, x.t);
+            boost::hash_combine(seed, x.yStdDevs);
+            boost::hash_combine(seed, x.gridPoints);
+            boost::hash_combine(seed, x.yts);
+            return seed;
+        }
+    };
+
+    typedef boost::unordered_map<CachedGridKey, Array, CachedGridKeyHasher>
+        GridCacheType;
+
+    struct GridMoments {
+        Real stdDev_0_T, e_0_T, stdDev_0_t, stdDev_t_T, e_0_t;
+    };
+
+    typedef boost::unordered_map<std::pair<Time, Time>, GridMoments>
+        MomentsCacheType;
+
+    const GridMoments gridMoments(const Time T, const Time t) const;
+    // fills the given cache with numeraires or zerobonds
+    const Array &gridValues(GridCacheType &cache, const CachedGridKey &k,
+                            const bool numeraire,
+                            const Handle<YieldTermStructure> &yts) const;
+
+    mutable GridCacheType zerobondGridCache_, numeraireGridCache_;
+    mutable MomentsCacheType momentsCache_;
+
+    // changes of external curves only invalidate the grid caches, so
+    // that the model itself doesn't depend on them
+    struct CurveObserver : public Observer {
+        CurveObserver(const Gaussian1dModel *p) : p_(p) {}
+        void update() { p_->flushGridCache(); }
+        const Gaussian1dModel *p_;
+    };
+
+    boost::shared_ptr<CurveObserver> curveObserver_;
+
   protected:
     // we let derived classes register with the termstructure
     Gaussian1dModel(const Handle<YieldTermStructure> &yieldTermStructure)
-        : TermStructureConsistentModel(yieldTermStructure) {
+        : TermStructureConsistentModel(yieldTermStructure),
+          curveObserver_(new CurveObserver(this)) {
         registerWith(Settings::instance().evaluationDate());
     }
 
@@ -201,13 +278,25 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
         evaluationDate_ = Settings::instance().evaluationDate();
         enforcesTodaysHistoricFixings_ =
             Settings::instance().enforcesTodaysHistoricFixings();
+        flushGridCache();
+        // the caches are empty, the external curves can be released
+        curveObserver_->unregisterWithAll();
     }
 
     void generateArguments() {
+        flushGridCache();
         calculate();
         notifyObservers();
     }
 
+    // derived classes must call this whenever the state process or
+    // the numeraire change without a recalculation of the model
+    void flushGridCache() const {
+        zerobondGridCache_.clear();
+        numeraireGridCache_.clear();
+        momentsCache_.clear();
+    }
+
     // retrieve underlying swap from cache if possible, otherwise
     // create it and store it in the cache
     boost::shared_ptr<VanillaSwap>
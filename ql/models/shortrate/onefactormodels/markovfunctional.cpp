@@ -27,6 +27,7 @@
 #include <ql/termstructures/volatility/kahalesmilesection.hpp>
 #include <ql/termstructures/volatility/atmadjustedsmilesection.hpp>
 #include <ql/termstructures/volatility/atmsmilesection.hpp>
+#include <functional>
 
 namespace QuantLib {
 
@@ -238,7 +239,7 @@ namespace QuantLib {
         discreteNumeraire_ = boost::shared_ptr<Matrix>(new Matrix(
             times_.size(), 2 * modelSettings_.yGridPoints_ + 1, 1.0));
         for (Size i = 0; i < times_.size(); i++) {
-            boost::shared_ptr<Interpolation> numInt(new CubicInterpolation(
+            boost::shared_ptr<CubicInterpolation> numInt(new CubicInterpolation(
                 y_.begin(), y_.end(), discreteNumeraire_->row_begin(i),
                 CubicInterpolation::Spline, true, CubicInterpolation::Lagrange,
                 0.0, CubicInterpolation::Lagrange, 0.0));
@@ -441,6 +442,37 @@ namespace QuantLib {
                         i->second.smileSection_->shift(),
                     Option::Call, i->second.annuity_,
                     modelSettings_.digitalGap_);
+
+            // the grid is denser for low strikes, where the swap rates
+            // are found for most of the state variable grid
+            Size n = 2 * modelSettings_.yGridPoints_;
+            Real kMin = modelSettings_.lowerRateBound_ -
+                        i->second.smileSection_->shift();
+            Real kMax = modelSettings_.upperRateBound_ -
+                        i->second.smileSection_->shift();
+            std::vector<Real> &k = i->second.digitalStrikes_;
+            std::vector<Real> &d = i->second.digitalPrices_;
+            k.resize(n + 1);
+            d.resize(n + 1);
+            bool monotonic = true;
+            for (Size j = 0; j <= n; ++j) {
+                Real u = static_cast<Real>(j) / static_cast<Real>(n);
+                k[j] = kMin + (kMax - kMin) * u * u;
+                if (j == 0)
+                    d[j] = i->second.minRateDigital_;
+                else if (j == n)
+                    d[j] = i->second.maxRateDigital_;
+                else
+                    d[j] = i->second.smileSection_->digitalOptionPrice(
+                        k[j], Option::Call, i->second.annuity_,
+                        modelSettings_.digitalGap_);
+                if (j > 0 && d[j] > d[j - 1])
+                    monotonic = false;
+            }
+            if (!monotonic) {
+                k.clear();
+                d.clear();
+            }
             ++pointIndex;
         }
     }
@@ -725,6 +757,23 @@ namespace QuantLib {
         Real tb = times_[i];
         Real dt = tb - ta;
 
+        // both interpolations share the grid y_, so the polynomial
+        // pieces are located once and evaluated directly; the grid
+        // is equidistant up to rounding, which gives a first guess
+        // for the index that is then corrected to match locate()
+        const CubicInterpolation &numa = *numeraire_[i - 1];
+        const CubicInterpolation &numb = *numeraire_[i];
+        const std::vector<Real> &aa = numa.aCoefficients(),
+                                &ba = numa.bCoefficients(),
+                                &ca = numa.cCoefficients(),
+                                &ab = numb.aCoefficients(),
+                                &bb = numb.bCoefficients(),
+                                &cb = numb.cCoefficients();
+        Matrix::const_row_iterator va = discreteNumeraire_->row_begin(i - 1),
+                                   vb = discreteNumeraire_->row_begin(i);
+        Size last = y_.size() - 2;
+        Real h = (y_.back() - y_.front()) / static_cast<Real>(last + 1);
+
         for (Size j = 0; j < y.size(); j++) {
             Real yv = y[j];
             if (yv < y_.front())
@@ -733,8 +782,15 @@ namespace QuantLib {
             // object, see above
             if (yv > y_.back())
                 yv = y_.back();
-            Real na = (*numeraire_[i - 1])(yv);
-            Real nb = (*numeraire_[i])(yv);
+            Size k = std::min(
+                static_cast<Size>((yv - y_.front()) / h), last);
+            while (k > 0 && yv < y_[k])
+                --k;
+            while (k < last && yv >= y_[k + 1])
+                ++k;
+            Real dx = yv - y_[k];
+            Real na = va[k] + dx * (aa[k] + dx * (ba[k] + dx * ca[k]));
+            Real nb = vb[k] + dx * (ab[k] + dx * (bb[k] + dx * cb[k]));
             res[j] =
                 inverseNormalization / ((tz - ta) / nb + (tb - tz) / na) * dt;
             // linear in reciprocal of normalized numeraire
@@ -758,22 +814,27 @@ namespace QuantLib {
 
         Array result(y.size(), 0.0);
 
-        // Gauss Hermite
+        // Gauss Hermite, the numeraire is evaluated for the
+        // abscissas belonging to all points in y at once
 
         Real stdDev_0_t = stateProcess_->stdDeviation(0.0, 0.0, t);
         // we use that the standard deviation is independent of $x$ here
         Real stdDev_0_T = stateProcess_->stdDeviation(0.0, 0.0, T);
         Real stdDev_t_T = stateProcess_->stdDeviation(t, 0.0, T - t);
 
+        Size n = modelSettings_.gaussHermitePoints_;
+        Array ya(y.size() * n);
         for (Size j = 0; j < y.size(); j++) {
-            Array ya(modelSettings_.gaussHermitePoints_);
-            for (Size i = 0; i < modelSettings_.gaussHermitePoints_; i++) {
-                ya[i] = (y[j] * stdDev_0_t + stdDev_t_T * normalIntegralX_[i]) /
-                        stdDev_0_T;
+            for (Size i = 0; i < n; i++) {
+                ya[j * n + i] =
+                    (y[j] * stdDev_0_t + stdDev_t_T * normalIntegralX_[i]) /
+                    stdDev_0_T;
             }
-            Array res = numeraireArray(T, ya);
-            for (Size i = 0; i < modelSettings_.gaussHermitePoints_; i++) {
-                result[j] += normalIntegralW_[i] / res[i];
+        }
+        Array res = numeraireArray(T, ya);
+        for (Size j = 0; j < y.size(); j++) {
+            for (Size i = 0; i < n; i++) {
+                result[j] += normalIntegralW_[i] / res[j * n + i];
             }
         }
 
@@ -826,6 +887,22 @@ namespace QuantLib {
 
         ZeroHelper z(this, expiry, p, digitalPrice);
         Brent b;
+
+        // if available, the tabulated digitals (which are
+        // non-increasing in the strike) give a tight bracket and an
+        // initial guess by inverse linear interpolation
+        const std::vector<Real> &k = p.digitalStrikes_;
+        const std::vector<Real> &d = p.digitalPrices_;
+        Size i = std::lower_bound(d.begin(), d.end(), digitalPrice,
+                                  std::greater<Real>()) -
+                 d.begin();
+        if (i > 0 && i < d.size()) {
+            Real w = (d[i - 1] - digitalPrice) / (d[i - 1] - d[i]);
+            w = std::max(std::min(w, 0.99), 0.01);
+            return b.solve(z, modelSettings_.marketRateAccuracy_,
+                           k[i - 1] + w * (k[i] - k[i - 1]), k[i - 1], k[i]);
+        }
+
         Real solution = b.solve(
             z, modelSettings_.marketRateAccuracy_,
             std::max(std::min(guess, modelSettings_.upperRateBound_ - 0.00001),
@@ -28,7 +28,7 @@
 #include <ql/termstructures/volatility/swaption/swaptionvolstructure.hpp>
 #include <ql/termstructures/volatility/optionlet/optionletvolatilitystructure.hpp>
 #include <ql/processes/mfstateprocess.hpp>
-#include <ql/math/interpolation.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
 
 namespace QuantLib {
 
@@ -229,6 +229,11 @@ namespace QuantLib {
             boost::shared_ptr<SmileSection> rawSmileSection_;
             Real minRateDigital_;
             Real maxRateDigital_;
+            // digital prices tabulated on a strike grid, used to
+            // bracket the market swap rates (empty if the prices are
+            // not monotonic)
+            std::vector<Real> digitalStrikes_;
+            std::vector<Real> digitalPrices_;
         };
 
 // utility macro to write messages to the model outputs
@@ -337,6 +342,7 @@ namespace QuantLib {
             // hard to avoid though.
             calculate();
             updateNumeraireTabulation();
+            flushGridCache();
             notifyObservers();
         }
 
@@ -454,7 +460,7 @@ namespace QuantLib {
         boost::shared_ptr<Matrix> discreteNumeraire_;
         // vector of interpolated numeraires in y direction for all calibration
         // times
-        std::vector<boost::shared_ptr<Interpolation> > numeraire_;
+        std::vector<boost::shared_ptr<CubicInterpolation> > numeraire_;
 
         Parameter reversion_;
         Parameter &sigma_;
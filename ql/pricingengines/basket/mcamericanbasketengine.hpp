@@ -167,7 +167,7 @@ namespace QuantLib {
                                          this->arguments_.payoff));
 
         return boost::shared_ptr<LongstaffSchwartzPathPricer<MultiPath> > (
-             new LongstaffSchwartzPathPricer<MultiPath>(
+             new CompactLongstaffSchwartzPathPricer<MultiPath>(
                      this->timeGrid(),
                      earlyExercisePathPricer,
                      *(process->riskFreeRate())));
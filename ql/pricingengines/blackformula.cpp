@@ -32,6 +32,7 @@
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
 #endif
 #include <boost/math/special_functions/atanh.hpp>
+#include <boost/math/special_functions/erf.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic pop
 #endif
@@ -52,10 +53,189 @@ namespace {
                                                      << displacement
                                                      << ") must be positive");
     }
+
+    void checkBatchParameters(const std::vector<QuantLib::Real>& strikes,
+                              const std::vector<QuantLib::Real>& forwards,
+                              const std::vector<QuantLib::Real>& stdDevs,
+                              const std::vector<QuantLib::Real>& discounts) {
+        QL_REQUIRE(forwards.size() == strikes.size(),
+                   "number of forwards (" << forwards.size()
+                   << ") does not match number of strikes ("
+                   << strikes.size() << ")");
+        QL_REQUIRE(stdDevs.size() == strikes.size(),
+                   "number of std devs (" << stdDevs.size()
+                   << ") does not match number of strikes ("
+                   << strikes.size() << ")");
+        QL_REQUIRE(discounts.size() == strikes.size(),
+                   "number of discounts (" << discounts.size()
+                   << ") does not match number of strikes ("
+                   << strikes.size() << ")");
+        for (QuantLib::Size i=0; i<strikes.size(); ++i) {
+            QL_REQUIRE(stdDevs[i]>=0.0,
+                       "stdDev #" << i << " (" << stdDevs[i]
+                       << ") must be non-negative");
+            QL_REQUIRE(discounts[i]>0.0,
+                       "discount #" << i << " (" << discounts[i]
+                       << ") must be positive");
+        }
+    }
+
+    void checkBatchParameters(const std::vector<QuantLib::Real>& strikes,
+                              const std::vector<QuantLib::Real>& forwards,
+                              const std::vector<QuantLib::Real>& stdDevs,
+                              const std::vector<QuantLib::Real>& discounts,
+                              QuantLib::Real displacement) {
+        checkBatchParameters(strikes, forwards, stdDevs, discounts);
+        QL_REQUIRE(displacement >= 0.0, "displacement ("
+                                            << displacement
+                                            << ") must be non-negative");
+        for (QuantLib::Size i=0; i<strikes.size(); ++i) {
+            QL_REQUIRE(strikes[i] + displacement >= 0.0,
+                       "strike #" << i << " + displacement (" << strikes[i]
+                       << " + " << displacement << ") must be non-negative");
+            QL_REQUIRE(forwards[i] + displacement > 0.0,
+                       "forward #" << i << " + displacement (" << forwards[i]
+                       << " + " << displacement << ") must be positive");
+        }
+    }
 }
 
 namespace QuantLib {
 
+    namespace {
+
+        // normalised Black function for x = ln(F/K) <= 0, i.e. the
+        // out-of-the-money call price divided by sqrt(F*K); its
+        // complement bMax-b is calculated directly for accuracy.
+        class NormalisedBlack {
+          public:
+            explicit NormalisedBlack(Real x)
+            : x_(x), ex_(std::exp(0.5*x)) {}
+            Real maxValue() const { return ex_; }
+            Real value(Real s) const {
+                return ex_*phi(x_/s+0.5*s) - phi(x_/s-0.5*s)/ex_;
+            }
+            Real complement(Real s) const {
+                return ex_*phi(-x_/s-0.5*s) + phi(x_/s-0.5*s)/ex_;
+            }
+            // first derivative with respect to s, i.e. normalised vega
+            Real derivative(Real s) const {
+                return M_1_SQRTPI*M_SQRT1_2 *
+                    std::exp(-0.5*(x_*x_/(s*s) + 0.25*s*s));
+            }
+            // second and third derivatives divided by the first
+            Real secondOverFirst(Real s) const {
+                return x_*x_/(s*s*s) - 0.25*s;
+            }
+            Real thirdOverFirst(Real s) const {
+                Real a = secondOverFirst(s);
+                return a*a - 3.0*x_*x_/(s*s*s*s) - 0.25;
+            }
+          private:
+            static Real phi(Real z) {
+                return 0.5*boost::math::erfc(-z*M_SQRT1_2);
+            }
+            Real x_, ex_;
+        };
+
+        // inverts the normalised Black function, see the documentation
+        // of blackFormulaImpliedStdDevHouseholder
+        Real normalisedImpliedStdDev(Real beta, Real x) {
+            const NormalisedBlack b(x);
+            const Real bMax = b.maxValue();
+            QL_REQUIRE(beta < bMax,
+                       "normalised price (" << beta << ") must be lower "
+                       "than its upper bound (" << bMax << ")");
+            if (beta <= 0.0)
+                return 0.0;
+            if (x == 0.0)
+                return 2.0*M_SQRT2*boost::math::erf_inv(beta);
+
+            // the point of maximum vega separates the two branches
+            const Real sc = std::sqrt(-2.0*x);
+            const bool lower = beta < b.value(sc);
+
+            InverseCumulativeNormal invPhi;
+            Real s, sMin, sMax, target;
+            if (lower) {
+                // small-s asymptotics: b ~ 2pi|x|/sqrt(27) N(-|x|/sqrt(3)/s)^3
+                Real q = std::pow(beta*std::sqrt(27.0)/(-2.0*M_PI*x),
+                                  1.0/3.0);
+                s = q < 0.5 ? x/(std::sqrt(3.0)*invPhi(q)) : sc;
+                s = std::min(s, sc);
+                sMin = 0.0;
+                sMax = sc;
+                target = std::log(beta);
+            } else {
+                // large-s asymptotics: bMax-b ~ (bMax+1/bMax) N(-s/2)
+                Real q = (bMax-beta)/(bMax+1.0/bMax);
+                s = std::max(-2.0*invPhi(q), sc);
+                sMin = sc;
+                sMax = QL_MAX_REAL;
+                target = std::log(bMax-beta);
+            }
+
+            // Householder iterations on the logarithm of b (lower branch)
+            // or of bMax-b (upper branch); the bracket [sMin,sMax] is
+            // narrowed at each step and used to safeguard the iterations
+            const Size maxIterations = 50;
+            for (Size i=0; i<maxIterations; ++i) {
+                Real u = lower ? b.value(s) : b.complement(s);
+                Real ds = Null<Real>();
+                if (u <= 0.0) {
+                    // underflow, we are far out on the flat side
+                    if (lower)
+                        sMin = s;
+                    else
+                        sMax = s;
+                } else {
+                    Real g = std::log(u) - target;
+                    // g is increasing in s on the lower branch and
+                    // decreasing on the upper one
+                    if ((g < 0.0) == lower)
+                        sMin = s;
+                    else
+                        sMax = s;
+                    Real u1 = (lower ? 1.0 : -1.0)*b.derivative(s)/u;
+                    Real u2 = u1*b.secondOverFirst(s);
+                    Real u3 = u1*b.thirdOverFirst(s);
+                    Real g1 = u1;
+                    Real g2 = u2 - u1*u1;
+                    Real g3 = u3 - 3.0*u2*u1 + 2.0*u1*u1*u1;
+                    if (lower) {
+                        // log(b) ~ -x^2/(2s^2) for small s, so that its
+                        // reciprocal is almost quadratic in s
+                        Real l = g + target;
+                        Real f = 1.0/l - 1.0/target;
+                        Real f1 = -g1/(l*l);
+                        Real f2 = (-g2 + 2.0*g1*g1/l)/(l*l);
+                        Real f3 = (-g3 + 6.0*g1*g2/l
+                                   - 6.0*g1*g1*g1/(l*l))/(l*l);
+                        g = f; g1 = f1; g2 = f2; g3 = f3;
+                    }
+                    Real nu = -g/g1, h2 = g2/g1, h3 = g3/g1;
+                    ds = nu*(1.0+0.5*h2*nu)/(1.0+nu*(h2+h3*nu/6.0));
+                }
+                // the iteration converges with fourth order, so that
+                // a small enough correction brings s to machine precision;
+                // waiting for smaller ones would only chase rounding noise
+                if (ds != Null<Real>() && std::fabs(ds) <= 1.0e-10*s)
+                    return s + ds;
+                Real next = s + (ds == Null<Real>() ? 0.0 : ds);
+                if (ds == Null<Real>() || !(next > sMin && next < sMax)) {
+                    // fall back on bisection
+                    next = (sMax == QL_MAX_REAL) ? 2.0*s : 0.5*(sMin+sMax);
+                    if (next == s)
+                        break;
+                }
+                s = next;
+            }
+            return s;
+        }
+
+    }
+
+
     Real blackFormula(Option::Type optionType,
                       Real strike,
                       Real forward,
@@ -341,6 +521,57 @@ namespace QuantLib {
             forward, blackPrice, discount, displacement, guess, accuracy, maxIterations);
     }
 
+    Real blackFormulaImpliedStdDevHouseholder(Option::Type optionType,
+                                              Real strike,
+                                              Real forward,
+                                              Real blackPrice,
+                                              Real discount,
+                                              Real displacement)
+    {
+        checkParameters(strike, forward, displacement);
+
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        QL_REQUIRE(blackPrice>=0.0,
+                   "option price (" << blackPrice << ") must be non-negative");
+        // check the price of the "other" option implied by put-call paity
+        Real otherOptionPrice = blackPrice - optionType*(forward-strike)*discount;
+        QL_REQUIRE(otherOptionPrice>=0.0,
+                   "negative " << Option::Type(-1*optionType) <<
+                   " price (" << otherOptionPrice <<
+                   ") implied by put-call parity. No solution exists for " <<
+                   optionType << " strike " << strike <<
+                   ", forward " << forward <<
+                   ", price " << blackPrice <<
+                   ", deflator " << discount);
+
+        // the normalised Black function is written in terms of the
+        // out-of-the-money option
+        if (optionType*(forward-strike) > 0.0)
+            blackPrice = otherOptionPrice;
+
+        strike = strike + displacement;
+        forward = forward + displacement;
+        QL_REQUIRE(strike>0.0,
+                   "strike + displacement (" << strike << ") must be "
+                   "positive to imply a standard deviation");
+
+        Real x = -std::fabs(std::log(forward/strike));
+        Real beta = blackPrice/(discount*std::sqrt(forward*strike));
+        return normalisedImpliedStdDev(beta, x);
+    }
+
+    Real blackFormulaImpliedStdDevHouseholder(
+                        const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+                        Real forward,
+                        Real blackPrice,
+                        Real discount,
+                        Real displacement) {
+        return blackFormulaImpliedStdDevHouseholder(payoff->optionType(),
+            payoff->strike(), forward, blackPrice, discount, displacement);
+    }
+
     Real blackFormulaCashItmProbability(Option::Type optionType,
                                         Real strike,
                                         Real forward,
@@ -553,6 +784,20 @@ namespace QuantLib {
 
         Real impliedBpvol = std::sqrt(M_PI / (2 * tte)) * straddlePremium * heta;
 
+        // the approximation above is accurate to about 1e-10; a single
+        // Newton step on the Bachelier price brings it to machine precision
+        Real stdDev = impliedBpvol*std::sqrt(tte);
+        Real vega = bachelierBlackFormulaStdDevDerivative(strike, forward,
+                                                          stdDev, discount);
+        if (vega > 0.0) {
+            Real price = bachelierBlackFormula(optionType, strike, forward,
+                                               stdDev, discount);
+            Real correction = (bachelierPrice - price)/vega;
+            // only accept a genuine refinement
+            if (std::fabs(correction) < 1.0e-6*stdDev)
+                impliedBpvol = (stdDev + correction)/std::sqrt(tte);
+        }
+
         return impliedBpvol;
     }
 
@@ -584,5 +829,222 @@ namespace QuantLib {
                                      stdDev, discount);
     }
 
+    void blackFormula(Option::Type optionType,
+                      const std::vector<Real>& strikes,
+                      const std::vector<Real>& forwards,
+                      const std::vector<Real>& stdDevs,
+                      const std::vector<Real>& discounts,
+                      std::vector<Real>& results,
+                      Real displacement) {
+        checkBatchParameters(strikes, forwards, stdDevs, discounts,
+                             displacement);
+        results.resize(strikes.size());
+        CumulativeNormalDistribution phi;
+        for (Size i=0; i<strikes.size(); ++i) {
+            Real forward = forwards[i] + displacement;
+            Real strike = strikes[i] + displacement;
+            Real stdDev = stdDevs[i];
+            // since displacement is non-negative strike==0 iff
+            // displacement==0; the intrinsic value is returned
+            if (stdDev==0.0 || strike==0.0) {
+                results[i] = std::max((forward-strike)*optionType, Real(0.0))
+                    * discounts[i];
+                continue;
+            }
+            Real d1 = std::log(forward/strike)/stdDev + 0.5*stdDev;
+            Real d2 = d1 - stdDev;
+            Real result = optionType *
+                (forward*phi(optionType*d1) - strike*phi(optionType*d2));
+            // numerical inaccuracies can yield a negative answer
+            results[i] = discounts[i] * std::max(Real(0.0), result);
+        }
+    }
+
+    void blackFormulaStdDevDerivative(const std::vector<Real>& strikes,
+                                      const std::vector<Real>& forwards,
+                                      const std::vector<Real>& stdDevs,
+                                      const std::vector<Real>& discounts,
+                                      std::vector<Real>& results,
+                                      Real displacement) {
+        checkBatchParameters(strikes, forwards, stdDevs, discounts,
+                             displacement);
+        results.resize(strikes.size());
+        NormalDistribution gaussian;
+        for (Size i=0; i<strikes.size(); ++i) {
+            Real forward = forwards[i] + displacement;
+            Real strike = strikes[i] + displacement;
+            Real stdDev = stdDevs[i];
+            if (stdDev==0.0 || strike==0.0) {
+                results[i] = 0.0;
+                continue;
+            }
+            Real d1 = std::log(forward/strike)/stdDev + .5*stdDev;
+            results[i] = discounts[i] * forward * gaussian(d1);
+        }
+    }
+
+    void bachelierBlackFormula(Option::Type optionType,
+                               const std::vector<Real>& strikes,
+                               const std::vector<Real>& forwards,
+                               const std::vector<Real>& stdDevs,
+                               const std::vector<Real>& discounts,
+                               std::vector<Real>& results) {
+        checkBatchParameters(strikes, forwards, stdDevs, discounts);
+        results.resize(strikes.size());
+        CumulativeNormalDistribution phi;
+        for (Size i=0; i<strikes.size(); ++i) {
+            Real d = (forwards[i]-strikes[i])*optionType;
+            Real stdDev = stdDevs[i];
+            if (stdDev==0.0) {
+                results[i] = discounts[i]*std::max(d, 0.0);
+                continue;
+            }
+            Real h = d/stdDev;
+            Real result = stdDev*phi.derivative(h) + d*phi(h);
+            // numerical inaccuracies can yield a negative answer
+            results[i] = discounts[i] * std::max(Real(0.0), result);
+        }
+    }
+
+    void bachelierBlackFormulaStdDevDerivative(
+                                      const std::vector<Real>& strikes,
+                                      const std::vector<Real>& forwards,
+                                      const std::vector<Real>& stdDevs,
+                                      const std::vector<Real>& discounts,
+                                      std::vector<Real>& results) {
+        checkBatchParameters(strikes, forwards, stdDevs, discounts);
+        results.resize(strikes.size());
+        NormalDistribution gaussian;
+        for (Size i=0; i<strikes.size(); ++i) {
+            Real stdDev = stdDevs[i];
+            if (stdDev==0.0) {
+                results[i] = 0.0;
+                continue;
+            }
+            Real d1 = (forwards[i] - strikes[i])/stdDev;
+            results[i] = discounts[i] * gaussian(d1);
+        }
+    }
+
+    void blackFormulaWithDerivatives(Option::Type optionType,
+                                     const std::vector<Real>& strikes,
+                                     const std::vector<Real>& forwards,
+                                     const std::vector<Real>& stdDevs,
+                                     const std::vector<Real>& discounts,
+                                     std::vector<Real>& values,
+                                     std::vector<Real>& stdDevDerivatives,
+                                     std::vector<Real>& forwardDerivatives,
+                                     Real displacement) {
+        checkBatchParameters(strikes, forwards, stdDevs, discounts,
+                             displacement);
+        values.resize(strikes.size());
+        stdDevDerivatives.resize(strikes.size());
+        forwardDerivatives.resize(strikes.size());
+        CumulativeNormalDistribution phi;
+        NormalDistribution gaussian;
+        for (Size i=0; i<strikes.size(); ++i) {
+            Real forward = forwards[i] + displacement;
+            Real strike = strikes[i] + displacement;
+            Real stdDev = stdDevs[i];
+            if (stdDev==0.0 || strike==0.0) {
+                Real intrinsic = (forward-strike)*optionType;
+                values[i] = std::max(intrinsic, Real(0.0)) * discounts[i];
+                stdDevDerivatives[i] = 0.0;
+                forwardDerivatives[i] =
+                    intrinsic > 0.0 ? optionType*discounts[i] : 0.0;
+                continue;
+            }
+            Real d1 = std::log(forward/strike)/stdDev + 0.5*stdDev;
+            Real d2 = d1 - stdDev;
+            Real nd1 = phi(optionType*d1);
+            Real result = optionType *
+                (forward*nd1 - strike*phi(optionType*d2));
+            // numerical inaccuracies can yield a negative answer
+            values[i] = discounts[i] * std::max(Real(0.0), result);
+            stdDevDerivatives[i] = discounts[i] * forward * gaussian(d1);
+            forwardDerivatives[i] = optionType * discounts[i] * nd1;
+        }
+    }
+
+    void bachelierBlackFormulaWithDerivatives(
+                                      Option::Type optionType,
+                                      const std::vector<Real>& strikes,
+                                      const std::vector<Real>& forwards,
+                                      const std::vector<Real>& stdDevs,
+                                      const std::vector<Real>& discounts,
+                                      std::vector<Real>& values,
+                                      std::vector<Real>& stdDevDerivatives,
+                                      std::vector<Real>& forwardDerivatives) {
+        checkBatchParameters(strikes, forwards, stdDevs, discounts);
+        values.resize(strikes.size());
+        stdDevDerivatives.resize(strikes.size());
+        forwardDerivatives.resize(strikes.size());
+        CumulativeNormalDistribution phi;
+        NormalDistribution gaussian;
+        for (Size i=0; i<strikes.size(); ++i) {
+            Real d = (forwards[i]-strikes[i])*optionType;
+            Real stdDev = stdDevs[i];
+            if (stdDev==0.0) {
+                values[i] = discounts[i]*std::max(d, 0.0);
+                stdDevDerivatives[i] = 0.0;
+                forwardDerivatives[i] =
+                    d > 0.0 ? optionType*discounts[i] : 0.0;
+                continue;
+            }
+            Real h = d/stdDev;
+            Real density = gaussian(h), nh = phi(h);
+            Real result = stdDev*density + d*nh;
+            // numerical inaccuracies can yield a negative answer
+            values[i] = discounts[i] * std::max(Real(0.0), result);
+            stdDevDerivatives[i] = discounts[i] * density;
+            forwardDerivatives[i] = optionType * discounts[i] * nh;
+        }
+    }
+
+    void blackFormulaImpliedStdDev(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& blackPrices,
+                                   const std::vector<Real>& discounts,
+                                   std::vector<Real>& results,
+                                   Real displacement) {
+        checkBatchParameters(strikes, forwards,
+                             std::vector<Real>(strikes.size(), 0.0),
+                             discounts, displacement);
+        QL_REQUIRE(blackPrices.size() == strikes.size(),
+                   "number of prices (" << blackPrices.size()
+                   << ") does not match number of strikes ("
+                   << strikes.size() << ")");
+        results.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            results[i] = blackFormulaImpliedStdDevHouseholder(
+                              optionType, strikes[i], forwards[i],
+                              blackPrices[i], discounts[i], displacement);
+    }
+
+    void bachelierBlackFormulaImpliedVol(Option::Type optionType,
+                                         const std::vector<Real>& strikes,
+                                         const std::vector<Real>& forwards,
+                                         const std::vector<Real>& ttes,
+                                         const std::vector<Real>& prices,
+                                         const std::vector<Real>& discounts,
+                                         std::vector<Real>& results) {
+        checkBatchParameters(strikes, forwards,
+                             std::vector<Real>(strikes.size(), 0.0),
+                             discounts);
+        QL_REQUIRE(ttes.size() == strikes.size(),
+                   "number of times (" << ttes.size()
+                   << ") does not match number of strikes ("
+                   << strikes.size() << ")");
+        QL_REQUIRE(prices.size() == strikes.size(),
+                   "number of prices (" << prices.size()
+                   << ") does not match number of strikes ("
+                   << strikes.size() << ")");
+        results.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            results[i] = bachelierBlackFormulaImpliedVol(
+                              optionType, strikes[i], forwards[i], ttes[i],
+                              prices[i], discounts[i]);
+    }
 
 }
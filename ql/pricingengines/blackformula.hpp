@@ -33,6 +33,7 @@
 
 #include <ql/option.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -145,6 +146,41 @@ namespace QuantLib {
                         Natural maxIterations = 100);
 
 
+    /*! Black 1976 implied standard deviation,
+        i.e. volatility*sqrt(timeToMaturity)
+
+        The price is translated into the normalised Black function
+        of the out-of-the-money option, which is then inverted by
+        Householder (third-order) iterations on its logarithm below
+        the point of maximum vega, and on the logarithm of its
+        distance from the upper price bound above it, along the
+        lines of P. Jaeckel, "By Implication", Wilmott (2006).
+        Starting from the asymptotic expansions of the normalised
+        Black function for small and large standard deviations,
+        machine precision is usually reached in two or three
+        iterations, each of which costs a single evaluation of
+        the Black formula; no guess or accuracy is needed.
+    */
+    Real blackFormulaImpliedStdDevHouseholder(Option::Type optionType,
+                                              Real strike,
+                                              Real forward,
+                                              Real blackPrice,
+                                              Real discount = 1.0,
+                                              Real displacement = 0.0);
+
+    /*! Black 1976 implied standard deviation,
+        i.e. volatility*sqrt(timeToMaturity)
+
+        \sa blackFormulaImpliedStdDevHouseholder
+    */
+    Real blackFormulaImpliedStdDevHouseholder(
+                        const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+                        Real forward,
+                        Real blackPrice,
+                        Real discount = 1.0,
+                        Real displacement = 0.0);
+
+
     /*! Black 1976 probability of being in the money (in the bond martingale
         measure), i.e. N(d2).
         It is a risk-neutral probability, not the real world one.
@@ -260,7 +296,8 @@ namespace QuantLib {
         It is calculated using  the analytic implied volatility approximation
         of J. Choi, K Kim and M. Kwak (2009), “Numerical Approximation of the
         Implied Volatility Under Arithmetic Brownian Motion”,
-        Applied Math. Finance, 16(3), pp. 261-268.
+        Applied Math. Finance, 16(3), pp. 261-268, refined by a
+        single Newton step on the Bachelier price.
     */
     Real bachelierBlackFormulaImpliedVol(Option::Type optionType,
                                    Real strike,
@@ -287,6 +324,128 @@ namespace QuantLib {
                                                 Real stdDev,
                                                 Real discount = 1.0);
 
+
+    /*! \name Batch versions
+
+        The functions below evaluate the formulas above over a set of
+        options sharing the same type and displacement, e.g. the
+        optionlets of a cap or floor leg. All arguments are checked in
+        a single pass before any value is calculated, and the
+        distribution objects are built once for the whole batch, so
+        that the main loop only contains the actual calculation.
+
+        The input vectors must have the same size; the results vector
+        is resized accordingly.
+    */
+    //@{
+
+    /*! Black 1976 formula
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    void blackFormula(Option::Type optionType,
+                      const std::vector<Real>& strikes,
+                      const std::vector<Real>& forwards,
+                      const std::vector<Real>& stdDevs,
+                      const std::vector<Real>& discounts,
+                      std::vector<Real>& results,
+                      Real displacement = 0.0);
+
+    /*! Black 1976 formula for standard deviation derivative
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    void blackFormulaStdDevDerivative(const std::vector<Real>& strikes,
+                                      const std::vector<Real>& forwards,
+                                      const std::vector<Real>& stdDevs,
+                                      const std::vector<Real>& discounts,
+                                      std::vector<Real>& results,
+                                      Real displacement = 0.0);
+
+    /*! Bachelier formula
+        \warning Bachelier model needs absolute volatility, not
+                 percentage volatility. Standard deviation is
+                 absoluteVolatility*sqrt(timeToMaturity)
+    */
+    void bachelierBlackFormula(Option::Type optionType,
+                               const std::vector<Real>& strikes,
+                               const std::vector<Real>& forwards,
+                               const std::vector<Real>& stdDevs,
+                               const std::vector<Real>& discounts,
+                               std::vector<Real>& results);
+
+    /*! Bachelier formula for standard deviation derivative
+        \warning Bachelier model needs absolute volatility, not
+                 percentage volatility. Standard deviation is
+                 absoluteVolatility*sqrt(timeToMaturity)
+    */
+    void bachelierBlackFormulaStdDevDerivative(
+                                      const std::vector<Real>& strikes,
+                                      const std::vector<Real>& forwards,
+                                      const std::vector<Real>& stdDevs,
+                                      const std::vector<Real>& discounts,
+                                      std::vector<Real>& results);
+
+    /*! Black 1976 formula together with its derivatives with
+        respect to the standard deviation and to the forward; the
+        three results are calculated in the same pass and share the
+        evaluation of the normal distribution.
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    void blackFormulaWithDerivatives(Option::Type optionType,
+                                     const std::vector<Real>& strikes,
+                                     const std::vector<Real>& forwards,
+                                     const std::vector<Real>& stdDevs,
+                                     const std::vector<Real>& discounts,
+                                     std::vector<Real>& values,
+                                     std::vector<Real>& stdDevDerivatives,
+                                     std::vector<Real>& forwardDerivatives,
+                                     Real displacement = 0.0);
+
+    /*! Bachelier formula together with its derivatives with respect
+        to the standard deviation and to the forward.
+        \warning Bachelier model needs absolute volatility, not
+                 percentage volatility. Standard deviation is
+                 absoluteVolatility*sqrt(timeToMaturity)
+    */
+    void bachelierBlackFormulaWithDerivatives(
+                                      Option::Type optionType,
+                                      const std::vector<Real>& strikes,
+                                      const std::vector<Real>& forwards,
+                                      const std::vector<Real>& stdDevs,
+                                      const std::vector<Real>& discounts,
+                                      std::vector<Real>& values,
+                                      std::vector<Real>& stdDevDerivatives,
+                                      std::vector<Real>& forwardDerivatives);
+
+    /*! Black 1976 implied standard deviation,
+        i.e. volatility*sqrt(timeToMaturity)
+
+        Each price is inverted by blackFormulaImpliedStdDevHouseholder;
+        prices violating the no-arbitrage bounds cause an exception
+        reporting the offending option.
+    */
+    void blackFormulaImpliedStdDev(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& blackPrices,
+                                   const std::vector<Real>& discounts,
+                                   std::vector<Real>& results,
+                                   Real displacement = 0.0);
+
+    /*! Bachelier implied volatility
+        \sa bachelierBlackFormulaImpliedVol
+    */
+    void bachelierBlackFormulaImpliedVol(Option::Type optionType,
+                                         const std::vector<Real>& strikes,
+                                         const std::vector<Real>& forwards,
+                                         const std::vector<Real>& ttes,
+                                         const std::vector<Real>& prices,
+                                         const std::vector<Real>& discounts,
+                                         std::vector<Real>& results);
+    //@}
+
 }
 
 #endif
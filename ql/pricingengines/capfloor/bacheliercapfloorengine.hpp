@@ -32,7 +32,14 @@ namespace QuantLib {
     class Quote;
 
     //! Bachelier-Black-formula cap/floor engine
-    /*! \ingroup capfloorengines */
+    /*! The volatilities of the optionlets are queried from the
+        volatility structure in a single batch, and the optionlet
+        prices, vegas and deltas (i.e., derivatives with respect to
+        the forward rate) are calculated in the same pass; they are
+        returned as additional results.
+
+        \ingroup capfloorengines
+    */
     class BachelierCapFloorEngine : public CapFloor::engine {
       public:
         BachelierCapFloorEngine(const Handle<YieldTermStructure>& discountCurve,
@@ -81,70 +81,128 @@ namespace QuantLib {
         Size optionlets = arguments_.startDates.size();
         std::vector<Real> values(optionlets, 0.0);
         std::vector<Real> vegas(optionlets, 0.0);
+        std::vector<Real> deltas(optionlets, 0.0);
         std::vector<Real> stdDevs(optionlets, 0.0);
         CapFloor::Type type = arguments_.type;
         Date today = vol_->referenceDate();
         Date settlement = discountCurve_->referenceDate();
 
+        // collect the live optionlets first, so that the volatilities
+        // can be queried and the formulas evaluated over the whole leg
+        // in one go
+        std::vector<Size> live;
+        std::vector<Real> forwards, discounts;
+        std::vector<Time> fixingTimes, sqrtTimes;
+        std::vector<Real> capRates, floorRates;
+        live.reserve(optionlets);
         for (Size i=0; i<optionlets; ++i) {
             Date paymentDate = arguments_.endDates[i];
             // handling of settlementDate, npvDate and includeSettlementFlows
             // should be implemented.
             // For the time being just discard expired caplets
             if (paymentDate > settlement) {
-                DiscountFactor d = arguments_.nominals[i] *
-                                   arguments_.gearings[i] *
-                                   discountCurve_->discount(paymentDate) *
-                                   arguments_.accrualTimes[i];
-
-                Rate forward = arguments_.forwards[i];
+                live.push_back(i);
+                discounts.push_back(arguments_.nominals[i] *
+                                    arguments_.gearings[i] *
+                                    discountCurve_->discount(paymentDate) *
+                                    arguments_.accrualTimes[i]);
+                forwards.push_back(arguments_.forwards[i]);
 
                 Date fixingDate = arguments_.fixingDates[i];
-                Time sqrtTime = 0.0;
+                Time fixingTime = 0.0;
                 if (fixingDate > today)
-                    sqrtTime = std::sqrt(vol_->timeFromReference(fixingDate));
-
-                if (type == CapFloor::Cap || type == CapFloor::Collar) {
-                    Rate strike = arguments_.capRates[i];
-                    if (sqrtTime>0.0) {
-                        stdDevs[i] = std::sqrt(vol_->blackVariance(fixingDate,
-                                                                   strike));
-                        vegas[i] = blackFormulaStdDevDerivative(strike,
-                            forward, stdDevs[i], d, displacement_) * sqrtTime;
-                    }
-                    // include caplets with past fixing date
-                    values[i] = blackFormula(Option::Call,
-                        strike, forward, stdDevs[i], d, displacement_);
-                }
-                if (type == CapFloor::Floor || type == CapFloor::Collar) {
-                    Rate strike = arguments_.floorRates[i];
-                    Real floorletVega = 0.0;
-                    if (sqrtTime>0.0) {
-                        stdDevs[i] = std::sqrt(vol_->blackVariance(fixingDate,
-                                                                   strike));
-                        floorletVega = blackFormulaStdDevDerivative(strike,
-                            forward, stdDevs[i], d, displacement_) * sqrtTime;
-                    }
-                    Real floorlet = blackFormula(Option::Put,
-                        strike, forward, stdDevs[i], d, displacement_);
-                    if (type == CapFloor::Floor) {
-                        values[i] = floorlet;
-                        vegas[i] = floorletVega;
-                    } else {
-                        // a collar is long a cap and short a floor
-                        values[i] -= floorlet;
-                        vegas[i] -= floorletVega;
-                    }
-                }
-                value += values[i];
-                vega += vegas[i];
+                    fixingTime = vol_->timeFromReference(fixingDate);
+                fixingTimes.push_back(fixingTime);
+                sqrtTimes.push_back(std::sqrt(fixingTime));
+
+                if (type == CapFloor::Cap || type == CapFloor::Collar)
+                    capRates.push_back(arguments_.capRates[i]);
+                if (type == CapFloor::Floor || type == CapFloor::Collar)
+                    floorRates.push_back(arguments_.floorRates[i]);
+            }
+        }
+
+        // optionlets with past fixing date have null std dev; the
+        // others are queried in a single batch, caps first
+        std::vector<Real> capStdDevs(capRates.size(), 0.0);
+        std::vector<Real> floorStdDevs(floorRates.size(), 0.0);
+        std::vector<Time> optionTimes;
+        std::vector<Rate> strikes;
+        for (Size j=0; j<capRates.size(); ++j) {
+            if (fixingTimes[j] > 0.0) {
+                optionTimes.push_back(fixingTimes[j]);
+                strikes.push_back(capRates[j]);
+            }
+        }
+        for (Size j=0; j<floorRates.size(); ++j) {
+            if (fixingTimes[j] > 0.0) {
+                optionTimes.push_back(fixingTimes[j]);
+                strikes.push_back(floorRates[j]);
+            }
+        }
+        std::vector<Volatility> vols;
+        vol_->volatilities(optionTimes, strikes, vols);
+        // std devs are taken from the variances, as in blackVariance()
+        Size k = 0;
+        for (Size j=0; j<capRates.size(); ++j) {
+            if (fixingTimes[j] > 0.0) {
+                Volatility v = vols[k++];
+                capStdDevs[j] = std::sqrt(v*v*fixingTimes[j]);
+            }
+        }
+        for (Size j=0; j<floorRates.size(); ++j) {
+            if (fixingTimes[j] > 0.0) {
+                Volatility v = vols[k++];
+                floorStdDevs[j] = std::sqrt(v*v*fixingTimes[j]);
+            }
+        }
+
+        std::vector<Real> capletValues, capletVegas, capletDeltas;
+        if (type == CapFloor::Cap || type == CapFloor::Collar)
+            blackFormulaWithDerivatives(Option::Call, capRates, forwards,
+                                        capStdDevs, discounts, capletValues,
+                                        capletVegas, capletDeltas,
+                                        displacement_);
+        std::vector<Real> floorletValues, floorletVegas, floorletDeltas;
+        if (type == CapFloor::Floor || type == CapFloor::Collar)
+            blackFormulaWithDerivatives(Option::Put, floorRates, forwards,
+                                        floorStdDevs, discounts,
+                                        floorletValues, floorletVegas,
+                                        floorletDeltas, displacement_);
+
+        for (Size j=0; j<live.size(); ++j) {
+            Size i = live[j];
+            switch (type) {
+              case CapFloor::Cap:
+                values[i] = capletValues[j];
+                vegas[i] = capletVegas[j] * sqrtTimes[j];
+                deltas[i] = capletDeltas[j];
+                stdDevs[i] = capStdDevs[j];
+                break;
+              case CapFloor::Floor:
+                values[i] = floorletValues[j];
+                vegas[i] = floorletVegas[j] * sqrtTimes[j];
+                deltas[i] = floorletDeltas[j];
+                stdDevs[i] = floorStdDevs[j];
+                break;
+              case CapFloor::Collar:
+                // a collar is long a cap and short a floor
+                values[i] = capletValues[j] - floorletValues[j];
+                vegas[i] = (capletVegas[j] - floorletVegas[j]) * sqrtTimes[j];
+                deltas[i] = capletDeltas[j] - floorletDeltas[j];
+                break;
+              default:
+                QL_FAIL("unknown cap/floor type");
             }
+            value += values[i];
+            vega += vegas[i];
         }
         results_.value = value;
         results_.additionalResults["vega"] = vega;
 
         results_.additionalResults["optionletsPrice"] = values;
         results_.additionalResults["optionletsVega"] = vegas;
+        results_.additionalResults["optionletsDelta"] = deltas;
         results_.additionalResults["optionletsAtmForward"] = arguments_.forwards;
         if (type != CapFloor::Collar)
             results_.additionalResults["optionletsStdDev"] = stdDevs;
@@ -43,6 +43,15 @@ namespace QuantLib {
         registerWith(termStructure_);
     }
 
+    TreeCapFloorEngine::TreeCapFloorEngine(
+                           const boost::shared_ptr<ShortRateTreeCache>& cache,
+                           const Handle<YieldTermStructure>& termStructure)
+    : LatticeShortRateModelEngine<CapFloor::arguments,
+                                  CapFloor::results>(cache),
+      termStructure_(termStructure) {
+        registerWith(termStructure_);
+    }
+
     void TreeCapFloorEngine::calculate() const {
 
         QL_REQUIRE(!model_.empty(), "no model specified");
@@ -48,6 +48,9 @@ namespace QuantLib {
                            const TimeGrid& timeGrid,
                            const Handle<YieldTermStructure>& termStructure =
                                                  Handle<YieldTermStructure>());
+        TreeCapFloorEngine(const boost::shared_ptr<ShortRateTreeCache>& cache,
+                           const Handle<YieldTermStructure>& termStructure =
+                                                 Handle<YieldTermStructure>());
         //@}
         void calculate() const;
       private:
@@ -0,0 +1,279 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/credit/isdacdsengine.hpp>
+#include <ql/instruments/claim.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/termstructures/credit/piecewisedefaultcurve.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/math/interpolations/backwardflatinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        template <class Curve, class TS>
+        bool addNodes(const boost::shared_ptr<TS>& ts,
+                      std::vector<Date>& nodes) {
+            boost::shared_ptr<Curve> curve =
+                boost::dynamic_pointer_cast<Curve>(ts);
+            if (!curve)
+                return false;
+            // for bootstrapped curves, this triggers the calculation
+            const std::vector<Date>& dates = curve->dates();
+            nodes.insert(nodes.end(), dates.begin(), dates.end());
+            return true;
+        }
+
+    }
+
+    namespace detail {
+
+        std::vector<Date> flatRateNodes(
+              const boost::shared_ptr<DefaultProbabilityTermStructure>& p) {
+            std::vector<Date> nodes;
+            addNodes<PiecewiseDefaultCurve<HazardRate,BackwardFlat> >(
+                                                                   p, nodes)
+            || addNodes<PiecewiseDefaultCurve<SurvivalProbability,
+                                              LogLinear> >(p, nodes)
+            || addNodes<InterpolatedHazardRateCurve<BackwardFlat> >(p, nodes)
+            || addNodes<InterpolatedSurvivalProbabilityCurve<LogLinear> >(
+                                                                   p, nodes);
+            return nodes;
+        }
+
+        std::vector<Date> flatRateNodes(
+                          const boost::shared_ptr<YieldTermStructure>& y) {
+            std::vector<Date> nodes;
+            addNodes<PiecewiseYieldCurve<Discount,LogLinear> >(y, nodes)
+            || addNodes<PiecewiseYieldCurve<ForwardRate,BackwardFlat> >(
+                                                                   y, nodes)
+            || addNodes<InterpolatedDiscountCurve<LogLinear> >(y, nodes)
+            || addNodes<InterpolatedForwardCurve<BackwardFlat> >(y, nodes);
+            return nodes;
+        }
+
+        void exponentialIntegrals(Real x, Real& e1, Real& e2) {
+            // close to x = 0, the direct formulas lose precision and
+            // the Taylor series are used instead
+            if (std::fabs(x) < 0.1) {
+                e1 = e2 = 0.0;
+                Real term = 1.0; // (-x)^n/(n+1)!
+                for (Size n=0; n<12; ++n) {
+                    e1 += term;
+                    e2 += term*(n+1.0)/(n+2.0);
+                    term *= -x/(n+2.0);
+                }
+            } else {
+                Real e = std::exp(-x);
+                e1 = (1.0-e)/x;
+                e2 = (1.0-e*(1.0+x))/(x*x);
+            }
+        }
+
+    }
+
+    IsdaCdsEngine::IsdaCdsEngine(
+                   const Handle<DefaultProbabilityTermStructure>& probability,
+                   Real recoveryRate,
+                   const Handle<YieldTermStructure>& discountCurve,
+                   boost::optional<bool> includeSettlementDateFlows)
+    : probability_(probability), recoveryRate_(recoveryRate),
+      discountCurve_(discountCurve),
+      includeSettlementDateFlows_(includeSettlementDateFlows) {
+        registerWith(probability_);
+        registerWith(discountCurve_);
+    }
+
+    void IsdaCdsEngine::calculate() const {
+        QL_REQUIRE(!discountCurve_.empty(),
+                   "no discount term structure set");
+        QL_REQUIRE(!probability_.empty(),
+                   "no probability term structure set");
+
+        Date today = Settings::instance().evaluationDate();
+        Date settlementDate = discountCurve_->referenceDate();
+
+        // merged nodes of the two curves; the periods between them
+        // have flat hazard and forward rates.
+        std::vector<Date> nodes =
+            detail::flatRateNodes(probability_.currentLink());
+        std::vector<Date> discountNodes =
+            detail::flatRateNodes(discountCurve_.currentLink());
+        nodes.insert(nodes.end(), discountNodes.begin(), discountNodes.end());
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+        // Upfront Flow NPV. Either we are on-the-run (no flow)
+        // or we are forward start
+        Real upfPVO1 = 0.0;
+        if (!arguments_.upfrontPayment->hasOccurred(
+                                               settlementDate,
+                                               includeSettlementDateFlows_)) {
+            // date determining the probability survival so we have to pay
+            //   the upfront (did not knock out)
+            Date effectiveUpfrontDate =
+                arguments_.protectionStart > probability_->referenceDate() ?
+                    arguments_.protectionStart : probability_->referenceDate();
+            upfPVO1 =
+                probability_->survivalProbability(effectiveUpfrontDate) *
+                discountCurve_->discount(arguments_.upfrontPayment->date());
+        }
+        results_.upfrontNPV = upfPVO1 * arguments_.upfrontPayment->amount();
+
+        results_.couponLegNPV  = 0.0;
+        results_.defaultLegNPV = 0.0;
+        for (Size i=0; i<arguments_.leg.size(); ++i) {
+            if (arguments_.leg[i]->hasOccurred(settlementDate,
+                                               includeSettlementDateFlows_))
+                continue;
+
+            boost::shared_ptr<FixedRateCoupon> coupon =
+                boost::dynamic_pointer_cast<FixedRateCoupon>(arguments_.leg[i]);
+
+            // In order to avoid a few switches, we calculate the NPV
+            // of both legs as a positive quantity. We'll give them
+            // the right sign at the end.
+
+            Date paymentDate = coupon->date(),
+                 startDate = (i == 0 ? arguments_.protectionStart :
+                                       coupon->accrualStartDate()),
+                 endDate = coupon->accrualEndDate();
+            Date effectiveStartDate =
+                (startDate <= today && today <= endDate) ? today : startDate;
+            Real couponAmount = coupon->amount();
+
+            Probability S = probability_->survivalProbability(paymentDate);
+            DiscountFactor endDiscount = discountCurve_->discount(paymentDate);
+
+            // On one side, we add the fixed rate payments in case of
+            // survival.
+            results_.couponLegNPV += S * couponAmount * endDiscount;
+
+            // On the other side, we add the payment (and possibly the
+            // accrual) in case of default, integrating exactly
+            // between consecutive nodes.  The accrual is linear in
+            // time starting from the accrual start date.
+            Time accrualStart =
+                probability_->timeFromReference(coupon->accrualStartDate());
+            Time accrualEnd =
+                probability_->timeFromReference(coupon->accrualEndDate());
+            Real accrualRate = accrualEnd > accrualStart ?
+                couponAmount/(accrualEnd-accrualStart) : 0.0;
+
+            std::vector<Date>::const_iterator node =
+                std::upper_bound(nodes.begin(), nodes.end(),
+                                 effectiveStartDate);
+            Date d0 = effectiveStartDate;
+            Time t0 = probability_->timeFromReference(d0);
+            Probability S0 = probability_->survivalProbability(d0);
+            DiscountFactor B0 = discountCurve_->discount(d0);
+            while (d0 < endDate) {
+                Date d1 = (node != nodes.end() && *node < endDate) ?
+                    *(node++) : endDate;
+                Time t1 = probability_->timeFromReference(d1);
+                Probability S1 = probability_->survivalProbability(d1);
+                DiscountFactor B1 = discountCurve_->discount(d1);
+
+                Real claim = arguments_.claim->amount(d1,
+                                                      arguments_.notional,
+                                                      recoveryRate_);
+                if (arguments_.paysAtDefaultTime) {
+                    if (S0 > S1) {
+                        Real hazard = std::log(S0/S1);
+                        Real e1, e2;
+                        detail::exponentialIntegrals(
+                            hazard + std::log(B0/B1), e1, e2);
+                        Real density = S0 * B0 * hazard;
+                        // accrual...
+                        if (arguments_.settlesAccrual)
+                            results_.couponLegNPV +=
+                                accrualRate * density *
+                                ((t0-accrualStart)*e1 + (t1-t0)*e2);
+                        // ...and claim.
+                        results_.defaultLegNPV += claim * density * e1;
+                    }
+                } else {
+                    Probability dP = S0 - S1;
+                    if (arguments_.settlesAccrual)
+                        results_.couponLegNPV +=
+                            couponAmount * endDiscount * dP;
+                    results_.defaultLegNPV += claim * endDiscount * dP;
+                }
+
+                // setup for next time around the loop
+                d0 = d1;
+                t0 = t1;
+                S0 = S1;
+                B0 = B1;
+            }
+        }
+
+        Real upfrontSign = 1.0;
+        switch (arguments_.side) {
+          case Protection::Seller:
+            results_.defaultLegNPV *= -1.0;
+            break;
+          case Protection::Buyer:
+            results_.couponLegNPV *= -1.0;
+            results_.upfrontNPV   *= -1.0;
+            upfrontSign = -1.0;
+            break;
+          default:
+            QL_FAIL("unknown protection side");
+        }
+
+        results_.value =
+            results_.defaultLegNPV+results_.couponLegNPV+results_.upfrontNPV;
+        results_.errorEstimate = Null<Real>();
+
+        if (results_.couponLegNPV != 0.0) {
+            results_.fairSpread =
+                -results_.defaultLegNPV*arguments_.spread/results_.couponLegNPV;
+        } else {
+            results_.fairSpread = Null<Rate>();
+        }
+
+        Real upfrontSensitivity = upfPVO1 * arguments_.notional;
+        if (upfrontSensitivity != 0.0) {
+            results_.fairUpfront =
+                -upfrontSign*(results_.defaultLegNPV + results_.couponLegNPV)
+                / upfrontSensitivity;
+        } else {
+            results_.fairUpfront = Null<Rate>();
+        }
+
+        static const Rate basisPoint = 1.0e-4;
+
+        if (arguments_.spread != 0.0) {
+            results_.couponLegBPS =
+                results_.couponLegNPV*basisPoint/arguments_.spread;
+        } else {
+            results_.couponLegBPS = Null<Rate>();
+        }
+
+        if (arguments_.upfront && *arguments_.upfront != 0.0) {
+            results_.upfrontBPS =
+                results_.upfrontNPV*basisPoint/(*arguments_.upfront);
+        } else {
+            results_.upfrontBPS = Null<Rate>();
+        }
+    }
+
+}
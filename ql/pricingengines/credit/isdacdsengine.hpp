@@ -0,0 +1,96 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file isdacdsengine.hpp
+    \brief Closed-form piecewise-flat engine for credit default swaps
+*/
+
+#ifndef quantlib_isda_cds_engine_hpp
+#define quantlib_isda_cds_engine_hpp
+
+#include <ql/instruments/creditdefaultswap.hpp>
+
+namespace QuantLib {
+
+    //! Closed-form engine for credit default swaps
+    /*! As in the ISDA standard model, hazard rates and instantaneous
+        forward rates are taken to be constant between the nodes of
+        the two curves.  Each coupon period is split at the nodes
+        falling inside it, and the default leg and the accrual paid
+        on default are integrated exactly on each sub-interval
+        \f$ [t_a, t_b] \f$; with
+        \f$ \lambda\Delta = \ln(S_a/S_b) \f$ and
+        \f$ f\Delta = \ln(P_a/P_b) \f$, the contribution of the
+        default leg is
+        \f[
+            C \, S_a P_a \frac{\lambda}{\lambda+f}
+            \left( 1 - e^{-(\lambda+f)\Delta} \right)
+        \f]
+        where \f$ C \f$ is the claim.  Thus, results don't depend on
+        a choice of integration step and the number of curve
+        evaluations is proportional to the number of coupons and
+        nodes.
+
+        Nodes are read from interpolated curves with flat hazard
+        rates or forward rates (i.e., backward-flat hazard-rate or
+        forward curves and log-linear survival-probability or
+        discount curves, either bootstrapped or not).  Flat curves
+        need no nodes; for other curves, the rates are assumed to be
+        constant on each coupon period.
+
+        \warning Claims depending on the default date are evaluated
+                 at the end of each sub-interval, as done by
+                 IntegralCdsEngine.
+    */
+    class IsdaCdsEngine : public CreditDefaultSwap::engine {
+      public:
+        IsdaCdsEngine(
+              const Handle<DefaultProbabilityTermStructure>&,
+              Real recoveryRate,
+              const Handle<YieldTermStructure>& discountCurve,
+              boost::optional<bool> includeSettlementDateFlows = boost::none);
+        void calculate() const;
+      private:
+        Handle<DefaultProbabilityTermStructure> probability_;
+        Real recoveryRate_;
+        Handle<YieldTermStructure> discountCurve_;
+        boost::optional<bool> includeSettlementDateFlows_;
+    };
+
+    namespace detail {
+
+        /*! returns the nodes of the curve if its hazard rates are
+            flat between them, or an empty vector otherwise. */
+        std::vector<Date> flatRateNodes(
+                  const boost::shared_ptr<DefaultProbabilityTermStructure>&);
+        /*! returns the nodes of the curve if its forward rates are
+            flat between them, or an empty vector otherwise. */
+        std::vector<Date> flatRateNodes(
+                             const boost::shared_ptr<YieldTermStructure>&);
+
+        /*! returns \f$ (1-e^{-x})/x \f$ and
+            \f$ (1-(1+x)e^{-x})/x^2 \f$ in e1 and e2, i.e., the
+            integrals over \f$ [0,1] \f$ of \f$ e^{-xu} \f$ and
+            \f$ u e^{-xu} \f$. */
+        void exponentialIntegrals(Real x, Real& e1, Real& e2);
+
+    }
+
+}
+
+
+#endif
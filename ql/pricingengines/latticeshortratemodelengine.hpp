@@ -27,12 +27,16 @@
 
 #include <ql/models/model.hpp>
 #include <ql/pricingengines/genericmodelengine.hpp>
+#include <ql/pricingengines/shortratetreecache.hpp>
 
 namespace QuantLib {
 
     //! Engine for a short-rate model specialized on a lattice
     /*! Derived engines only need to implement the <tt>calculate()</tt>
         method
+
+        Engines built on the same ShortRateTreeCache instance share
+        its tree instead of building their own.
     */
     template <class Arguments, class Results>
     class LatticeShortRateModelEngine
@@ -47,11 +51,14 @@ namespace QuantLib {
         LatticeShortRateModelEngine(
                                const boost::shared_ptr<ShortRateModel>& model,
                                const TimeGrid& timeGrid);
+        LatticeShortRateModelEngine(
+                        const boost::shared_ptr<ShortRateTreeCache>& cache);
         void update();
       protected:
         TimeGrid timeGrid_;
         Size timeSteps_;
         boost::shared_ptr<Lattice> lattice_;
+        boost::shared_ptr<ShortRateTreeCache> cache_;
     };
 
     template <class Arguments, class Results>
@@ -85,10 +92,21 @@ namespace QuantLib {
         lattice_ = this->model_->tree(timeGrid);
     }
 
+    template <class Arguments, class Results>
+    LatticeShortRateModelEngine<Arguments, Results>::LatticeShortRateModelEngine(
+            const boost::shared_ptr<ShortRateTreeCache>& cache)
+    : GenericModelEngine<ShortRateModel, Arguments, Results>(cache->model()),
+      timeGrid_(cache->timeGrid()), timeSteps_(0), cache_(cache) {
+        this->registerWith(cache_);
+        lattice_ = cache_->lattice();
+    }
+
     template <class Arguments, class Results>
     void LatticeShortRateModelEngine<Arguments, Results>::update()
     {
-        if (!timeGrid_.empty())
+        if (cache_)
+            lattice_ = cache_->lattice();
+        else if (!timeGrid_.empty())
             lattice_ = this->model_->tree(timeGrid_);
         GenericModelEngine<ShortRateModel, Arguments, Results>::update();
     }
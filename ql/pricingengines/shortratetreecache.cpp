@@ -0,0 +1,44 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/shortratetreecache.hpp>
+
+namespace QuantLib {
+
+    ShortRateTreeCache::ShortRateTreeCache(
+                                    const Handle<ShortRateModel>& model,
+                                    const TimeGrid& timeGrid)
+    : model_(model), timeGrid_(timeGrid) {
+        QL_REQUIRE(!timeGrid_.empty(), "empty time grid given");
+        registerWith(model_);
+    }
+
+    ShortRateTreeCache::ShortRateTreeCache(
+                                    const Handle<ShortRateModel>& model,
+                                    const std::vector<Time>& mandatoryTimes,
+                                    Size timeSteps)
+    : model_(model),
+      timeGrid_(mandatoryTimes.begin(), mandatoryTimes.end(), timeSteps) {
+        registerWith(model_);
+    }
+
+    void ShortRateTreeCache::performCalculations() const {
+        QL_REQUIRE(!model_.empty(), "no model specified");
+        lattice_ = model_->tree(timeGrid_);
+    }
+
+}
@@ -0,0 +1,89 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file shortratetreecache.hpp
+    \brief short-rate tree shared among lattice engines
+*/
+
+#ifndef quantlib_short_rate_tree_cache_hpp
+#define quantlib_short_rate_tree_cache_hpp
+
+#include <ql/models/model.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/timegrid.hpp>
+
+namespace QuantLib {
+
+    //! Short-rate tree shared among lattice engines
+    /*! This class builds the tree of a short-rate model on a given
+        time grid and keeps it until the model notifies a change
+        (e.g., because it was recalibrated or its term structure
+        moved).  Lattice engines built on the same instance use the
+        same tree; therefore, when pricing a portfolio of callable
+        instruments on the same model, the tree is fitted and its
+        state prices are calculated only once instead of once per
+        instrument.
+
+        The time grid must contain the mandatory times of all the
+        instruments to be priced; it can be built by merging them.
+    */
+    class ShortRateTreeCache : public LazyObject {
+      public:
+        ShortRateTreeCache(const Handle<ShortRateModel>& model,
+                           const TimeGrid& timeGrid);
+        /*! The time grid is built from the union of the passed
+            mandatory times, as in the corresponding TimeGrid
+            constructor.
+        */
+        ShortRateTreeCache(const Handle<ShortRateModel>& model,
+                           const std::vector<Time>& mandatoryTimes,
+                           Size timeSteps);
+        //! \name Inspectors
+        //@{
+        const Handle<ShortRateModel>& model() const;
+        const TimeGrid& timeGrid() const;
+        //! the tree, which is rebuilt if the model changed
+        const boost::shared_ptr<Lattice>& lattice() const;
+        //@}
+      private:
+        void performCalculations() const;
+        Handle<ShortRateModel> model_;
+        TimeGrid timeGrid_;
+        mutable boost::shared_ptr<Lattice> lattice_;
+    };
+
+
+    // inline definitions
+
+    inline const Handle<ShortRateModel>& ShortRateTreeCache::model() const {
+        return model_;
+    }
+
+    inline const TimeGrid& ShortRateTreeCache::timeGrid() const {
+        return timeGrid_;
+    }
+
+    inline const boost::shared_ptr<Lattice>&
+    ShortRateTreeCache::lattice() const {
+        calculate();
+        return lattice_;
+    }
+
+}
+
+
+#endif
@@ -43,6 +43,15 @@ namespace QuantLib {
         registerWith(termStructure_);
     }
 
+    TreeVanillaSwapEngine::TreeVanillaSwapEngine(
+                           const boost::shared_ptr<ShortRateTreeCache>& cache,
+                           const Handle<YieldTermStructure>& termStructure)
+    : LatticeShortRateModelEngine<VanillaSwap::arguments,
+                                  VanillaSwap::results>(cache),
+      termStructure_(termStructure) {
+        registerWith(termStructure_);
+    }
+
     void TreeVanillaSwapEngine::calculate() const {
 
         QL_REQUIRE(!model_.empty(), "no model specified");
@@ -50,6 +50,9 @@ namespace QuantLib {
                               const TimeGrid& timeGrid,
                               const Handle<YieldTermStructure>& termStructure =
                                                  Handle<YieldTermStructure>());
+        TreeVanillaSwapEngine(const boost::shared_ptr<ShortRateTreeCache>&,
+                              const Handle<YieldTermStructure>& termStructure =
+                                                 Handle<YieldTermStructure>());
         //@}
         void calculate() const;
       private:
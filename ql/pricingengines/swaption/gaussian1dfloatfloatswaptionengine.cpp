@@ -226,6 +226,62 @@ namespace QuantLib {
             event0Time = std::max(
                 model_->termStructure()->timeFromReference(event0), 0.0);
 
+            // zerobonds and numeraire on the integration grid, these are
+            // cached by the model and shared between calls; at expiry,
+            // coupons are evaluated at the given state y instead
+            std::vector<Array> leg1Zerobonds, leg2Zerobonds;
+            Array numeraires;
+            Real discount0 = 1.0, rebateZerobond = 0.0;
+            if (isEventDate) {
+                Time t0 = model_->termStructure()->timeFromReference(event0);
+                numeraires = model_->numeraireGrid(
+                    event0Time, stddevs_, integrationPoints_, discountCurve_);
+                if (event0 > expiry) {
+                    if (isLeg1Fixing) {
+                        for (Size j = std::find(
+                                 arguments_.leg1FixingDates.begin(),
+                                 arguments_.leg1FixingDates.end(), event0) -
+                                      arguments_.leg1FixingDates.begin();
+                             j < arguments_.leg1FixingDates.size() &&
+                             arguments_.leg1FixingDates[j] == event0;
+                             ++j)
+                            leg1Zerobonds.push_back(model_->zerobondGrid(
+                                model_->termStructure()->timeFromReference(
+                                    arguments_.leg1PayDates[j]),
+                                t0, stddevs_, integrationPoints_,
+                                discountCurve_));
+                    }
+                    if (isLeg2Fixing) {
+                        for (Size j = std::find(
+                                 arguments_.leg2FixingDates.begin(),
+                                 arguments_.leg2FixingDates.end(), event0) -
+                                      arguments_.leg2FixingDates.begin();
+                             j < arguments_.leg2FixingDates.size() &&
+                             arguments_.leg2FixingDates[j] == event0;
+                             ++j)
+                            leg2Zerobonds.push_back(model_->zerobondGrid(
+                                model_->termStructure()->timeFromReference(
+                                    arguments_.leg2PayDates[j]),
+                                t0, stddevs_, integrationPoints_,
+                                discountCurve_));
+                    }
+                }
+                if (isExercise) {
+                    if (considerProbabilities && probabilities_ != None)
+                        discount0 = model_->zerobond(event0Time, 0.0, 0.0,
+                                                     discountCurve_);
+                    if (rebatedExercise_ != NULL) {
+                        Size j =
+                            std::find(arguments_.exercise->dates().begin(),
+                                      arguments_.exercise->dates().end(),
+                                      event0) -
+                            arguments_.exercise->dates().begin();
+                        rebateZerobond = model_->zerobond(
+                            rebatedExercise_->rebatePaymentDate(j), event0);
+                    }
+                }
+            }
+
             // todo add openmp support later on (as in gaussian1dswaptionengine)
 
             for (Size k = 0; k < (event0 > expiry ? npv0.size() : 1); k++) {
@@ -447,6 +503,7 @@ namespace QuantLib {
                                            arguments_.leg1FixingDates.end(),
                                            event0) -
                                  arguments_.leg1FixingDates.begin();
+                        Size j0 = j;
                         Real zSpreadDf =
                             oas_.empty()
                                 ? 1.0
@@ -507,10 +564,13 @@ namespace QuantLib {
 
                             npv0a[k] -=
                                 amount *
-                                model_->zerobond(arguments_.leg1PayDates[j],
-                                                 event0, zk, discountCurve_) /
-                                model_->numeraire(event0Time, zk,
-                                                  discountCurve_) *
+                                (event0 > expiry
+                                     ? leg1Zerobonds[j - j0][k] / numeraires[k]
+                                     : model_->zerobond(
+                                           arguments_.leg1PayDates[j], event0,
+                                           zk, discountCurve_) /
+                                           model_->numeraire(event0Time, zk,
+                                                             discountCurve_)) *
                                 zSpreadDf;
 
                             if (j < arguments_.leg1FixingDates.size() - 1) {
@@ -531,6 +591,7 @@ namespace QuantLib {
                                            arguments_.leg2FixingDates.end(),
                                            event0) -
                                  arguments_.leg2FixingDates.begin();
+                        Size j0 = j;
                         Real zSpreadDf =
                             oas_.empty()
                                 ? 1.0
@@ -585,10 +646,13 @@ namespace QuantLib {
 
                             npv0a[k] +=
                                 amount *
-                                model_->zerobond(arguments_.leg2PayDates[j],
-                                                 event0, zk, discountCurve_) /
-                                model_->numeraire(event0Time, zk,
-                                                  discountCurve_) *
+                                (event0 > expiry
+                                     ? leg2Zerobonds[j - j0][k] / numeraires[k]
+                                     : model_->zerobond(
+                                           arguments_.leg2PayDates[j], event0,
+                                           zk, discountCurve_) /
+                                           model_->numeraire(event0Time, zk,
+                                                             discountCurve_)) *
                                 zSpreadDf;
                             if (j < arguments_.leg2FixingDates.size() - 1) {
                                 j++;
@@ -620,11 +684,14 @@ namespace QuantLib {
                                                     .yearFraction(event0,
                                                                   rebateDate)));
                         }
+                        Real numeraire =
+                            event0 > expiry
+                                ? numeraires[k]
+                                : model_->numeraire(event0Time, zk,
+                                                    discountCurve_);
                         Real exerciseValue =
                             (type == Option::Call ? 1.0 : -1.0) * npv0a[k] +
-                            rebate * model_->zerobond(rebateDate, event0) *
-                                zSpreadDf / model_->numeraire(event0Time, zk,
-                                                              discountCurve_);
+                            rebate * rebateZerobond * zSpreadDf / numeraire;
 
                         if (considerProbabilities && probabilities_ != None) {
                             if (exIdx == noEx) {
@@ -634,23 +701,13 @@ namespace QuantLib {
                                 npvp0.back()[k] =
                                     probabilities_ == Naive
                                         ? 1.0
-                                        : 1.0 / (model_->zerobond(
-                                                     event0Time, 0.0, 0.0,
-                                                     discountCurve_) *
-                                                 model_->numeraire(
-                                                     event0, z[k],
-                                                     discountCurve_));
+                                        : 1.0 / (discount0 * numeraires[k]);
                             }
                             if (exerciseValue >= npv0[k]) {
                                 npvp0[exIdx-1][k] =
                                     probabilities_ == Naive
                                         ? 1.0
-                                        : 1.0 / (model_->zerobond(
-                                                     event0Time, 0.0, 0.0,
-                                                     discountCurve_) *
-                                                 model_->numeraire(
-                                                     event0Time, z[k],
-                                                     discountCurve_));
+                                        : 1.0 / (discount0 * numeraires[k]);
                                 for (Size ii = exIdx; ii < noEx+1; ++ii)
                                     npvp0[ii][k] = 0.0;
                             }
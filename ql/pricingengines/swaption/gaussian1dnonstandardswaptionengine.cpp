@@ -198,6 +198,27 @@ namespace QuantLib {
                                  arguments_.floatingResetDates.end(), expiry0 - 1) -
                 arguments_.floatingResetDates.begin();
 
+            // zerobonds and numeraire on the integration grid, these are
+            // cached by the model and shared between calls
+            std::vector<Array> floatingZerobonds, fixedZerobonds;
+            Array numeraires;
+            if (expiry0 > settlement) {
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++)
+                    floatingZerobonds.push_back(model_->zerobondGrid(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.floatingPayDates[l]),
+                        expiry0Time, stddevs_, integrationPoints_,
+                        discountCurve_));
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++)
+                    fixedZerobonds.push_back(model_->zerobondGrid(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.fixedPayDates[l]),
+                        expiry0Time, stddevs_, integrationPoints_,
+                        discountCurve_));
+                numeraires = model_->numeraireGrid(
+                    expiry0Time, stddevs_, integrationPoints_, discountCurve_);
+            }
+
             // todo add openmp support later on (as in gaussian1dswaptionengine)
 
             for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
@@ -387,10 +408,7 @@ namespace QuantLib {
                                               arguments_.swap->iborIndex()) +
                                       arguments_.floatingSpreads[l]);
                         floatingLegNpv +=
-                            amount *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
+                            amount * floatingZerobonds[l - k1][k] * zSpreadDf;
                     }
                     Real fixedLegNpv = 0.0;
                     for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
@@ -406,9 +424,7 @@ namespace QuantLib {
                                                 arguments_.fixedPayDates[l])));
                         fixedLegNpv +=
                             arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
+                            fixedZerobonds[l - j1][k] * zSpreadDf;
                     }
                     Real rebate = 0.0;
                     Real zSpreadDf = 1.0;
@@ -431,7 +447,7 @@ namespace QuantLib {
                          rebate * model_->zerobond(rebateDate, expiry0, z[k],
                                                    discountCurve_) *
                              zSpreadDf) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                        numeraires[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
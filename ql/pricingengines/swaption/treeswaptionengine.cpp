@@ -53,6 +53,15 @@ namespace QuantLib {
         registerWith(termStructure_);
     }
 
+    TreeSwaptionEngine::TreeSwaptionEngine(
+                              const boost::shared_ptr<ShortRateTreeCache>& cache,
+                              const Handle<YieldTermStructure>& termStructure)
+    : LatticeShortRateModelEngine<Swaption::arguments,
+                                  Swaption::results>(cache),
+      termStructure_(termStructure) {
+        registerWith(termStructure_);
+    }
+
     void TreeSwaptionEngine::calculate() const {
 
         QL_REQUIRE(arguments_.settlementType==Settlement::Physical,
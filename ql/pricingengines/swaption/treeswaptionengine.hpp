@@ -62,6 +62,9 @@ namespace QuantLib {
                            Size timeSteps,
                            const Handle<YieldTermStructure>& termStructure =
                                                  Handle<YieldTermStructure>());
+        TreeSwaptionEngine(const boost::shared_ptr<ShortRateTreeCache>&,
+                           const Handle<YieldTermStructure>& termStructure =
+                                                 Handle<YieldTermStructure>());
         //@}
         void calculate() const;
       private:
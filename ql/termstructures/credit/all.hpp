@@ -1,6 +1,7 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/termstructures/credit/cdscurvebatchbuilder.hpp>
 #include <ql/termstructures/credit/defaultdensitystructure.hpp>
 #include <ql/termstructures/credit/defaultprobabilityhelpers.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
@@ -0,0 +1,353 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/credit/cdscurvebatchbuilder.hpp>
+#include <ql/pricingengines/credit/isdacdsengine.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/math/solvers1d/brent.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    class CdsCurveBatchBuilder::FairSpreadError {
+      public:
+        FairSpreadError(const CdsCurveBatchBuilder& builder,
+                        const Contract& contract,
+                        Size firstPiece, Size firstPayment,
+                        Rate spread, Real lossGivenDefault,
+                        Time segmentStart, Real integral,
+                        Real fixedProtection, Real fixedPremium)
+        : builder_(builder), contract_(contract),
+          firstPiece_(firstPiece), firstPayment_(firstPayment),
+          spread_(spread), lossGivenDefault_(lossGivenDefault),
+          segmentStart_(segmentStart), integral_(integral),
+          fixedProtection_(fixedProtection), fixedPremium_(fixedPremium) {}
+        Real operator()(Rate hazardRate) const {
+            Real protection = fixedProtection_, premium = fixedPremium_;
+            // only the periods after the last known node depend on
+            // the hazard rate being solved for
+            for (Size i=firstPiece_; i<contract_.pieces.size(); ++i) {
+                const Piece& p = contract_.pieces[i];
+                Probability S0 = std::exp(-integral_ - hazardRate
+                                                   *(p.start-segmentStart_));
+                builder_.addPiece(p, hazardRate, S0, protection, premium);
+            }
+            for (Size i=firstPayment_; i<contract_.payments.size(); ++i) {
+                const Payment& p = contract_.payments[i];
+                premium += p.value * std::exp(-integral_ - hazardRate
+                                                   *(p.time-segmentStart_));
+            }
+            return lossGivenDefault_*protection - spread_*premium;
+        }
+      private:
+        const CdsCurveBatchBuilder& builder_;
+        const Contract& contract_;
+        Size firstPiece_, firstPayment_;
+        Rate spread_;
+        Real lossGivenDefault_;
+        Time segmentStart_;
+        Real integral_, fixedProtection_, fixedPremium_;
+    };
+
+
+    CdsCurveBatchBuilder::CdsCurveBatchBuilder(
+                              const std::vector<Period>& tenors,
+                              Integer settlementDays,
+                              const Calendar& calendar,
+                              Frequency frequency,
+                              BusinessDayConvention paymentConvention,
+                              DateGeneration::Rule rule,
+                              const DayCounter& dayCounter,
+                              const Handle<YieldTermStructure>& discountCurve,
+                              const DayCounter& curveDayCounter,
+                              bool settlesAccrual,
+                              bool paysAtDefaultTime,
+                              Real accuracy)
+    : tenors_(tenors), settlementDays_(settlementDays), calendar_(calendar),
+      frequency_(frequency), paymentConvention_(paymentConvention),
+      rule_(rule), dayCounter_(dayCounter), discountCurve_(discountCurve),
+      curveDayCounter_(curveDayCounter), settlesAccrual_(settlesAccrual),
+      paysAtDefaultTime_(paysAtDefaultTime), accuracy_(accuracy) {
+        QL_REQUIRE(!tenors_.empty(), "no tenors given");
+        registerWith(discountCurve_);
+        registerWith(Settings::instance().evaluationDate());
+    }
+
+    const std::vector<Date>& CdsCurveBatchBuilder::dates() const {
+        calculate();
+        return dates_;
+    }
+
+    void CdsCurveBatchBuilder::performCalculations() const {
+        QL_REQUIRE(!discountCurve_.empty(), "no discount curve set");
+
+        // same schedules as in CdsHelper
+        Date today = Settings::instance().evaluationDate();
+        Date settlementDate = discountCurve_->referenceDate();
+        Date protectionStart = today + settlementDays_;
+        Date startDate = calendar_.adjust(protectionStart,
+                                          paymentConvention_);
+
+        std::vector<Leg> legs(tenors_.size());
+        dates_.assign(1, today);
+        for (Size j=0; j<tenors_.size(); ++j) {
+            Schedule schedule =
+                MakeSchedule().from(startDate)
+                              .to(today + tenors_[j])
+                              .withFrequency(frequency_)
+                              .withCalendar(calendar_)
+                              .withConvention(paymentConvention_)
+                              .withTerminationDateConvention(Unadjusted)
+                              .withRule(rule_);
+            Date maturity = calendar_.adjust(schedule.dates().back(),
+                                             paymentConvention_);
+            QL_REQUIRE(maturity > dates_.back(),
+                       io::ordinal(j+1) << " tenor (" << tenors_[j]
+                       << ") doesn't extend the curve beyond "
+                       << dates_.back());
+            dates_.push_back(maturity);
+            legs[j] = FixedRateLeg(schedule)
+                .withNotionals(1.0)
+                .withCouponRates(1.0, dayCounter_)
+                .withPaymentAdjustment(paymentConvention_);
+        }
+
+        times_.resize(dates_.size());
+        for (Size k=0; k<dates_.size(); ++k)
+            times_[k] = curveDayCounter_.yearFraction(today, dates_[k]);
+
+        // periods are split at the curve nodes and at the nodes of
+        // the discount curve, if any
+        std::vector<Date> nodes =
+            detail::flatRateNodes(discountCurve_.currentLink());
+        nodes.insert(nodes.end(), dates_.begin(), dates_.end());
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+        contracts_.resize(tenors_.size());
+        for (Size j=0; j<tenors_.size(); ++j) {
+            Contract& contract = contracts_[j];
+            contract.pieces.clear();
+            contract.payments.clear();
+            const Leg& leg = legs[j];
+            for (Size i=0; i<leg.size(); ++i) {
+                if (leg[i]->hasOccurred(settlementDate))
+                    continue;
+                boost::shared_ptr<FixedRateCoupon> coupon =
+                    boost::dynamic_pointer_cast<FixedRateCoupon>(leg[i]);
+
+                Date paymentDate = coupon->date(),
+                     start = (i == 0 ? protectionStart :
+                                       coupon->accrualStartDate()),
+                     end = coupon->accrualEndDate();
+                Date effectiveStart =
+                    (start <= today && today <= end) ? today : start;
+                Real amount = coupon->amount();
+                DiscountFactor paymentDiscount =
+                    discountCurve_->discount(paymentDate);
+
+                Payment payment;
+                payment.time = curveDayCounter_.yearFraction(today,
+                                                             paymentDate);
+                payment.segment =
+                    std::lower_bound(dates_.begin(), dates_.end(),
+                                     paymentDate) - dates_.begin();
+                payment.value = amount * paymentDiscount;
+                contract.payments.push_back(payment);
+
+                Time accrualStart = curveDayCounter_.yearFraction(
+                                          today, coupon->accrualStartDate());
+                Time accrualEnd = curveDayCounter_.yearFraction(
+                                            today, coupon->accrualEndDate());
+
+                std::vector<Date>::const_iterator node =
+                    std::upper_bound(nodes.begin(), nodes.end(),
+                                     effectiveStart);
+                Date d0 = effectiveStart;
+                Time t0 = curveDayCounter_.yearFraction(today, d0);
+                DiscountFactor B0 = discountCurve_->discount(d0);
+                while (d0 < end) {
+                    Date d1 = (node != nodes.end() && *node < end) ?
+                        *(node++) : end;
+                    Time t1 = curveDayCounter_.yearFraction(today, d1);
+                    DiscountFactor B1 = discountCurve_->discount(d1);
+
+                    Piece p;
+                    p.segment =
+                        std::lower_bound(dates_.begin(), dates_.end(),
+                                         d1) - dates_.begin();
+                    p.start = t0;
+                    p.length = t1 - t0;
+                    p.accrued = t0 - accrualStart;
+                    p.discount = B0;
+                    p.logDiscountRatio = std::log(B0/B1);
+                    p.accrualRate = accrualEnd > accrualStart ?
+                        amount/(accrualEnd-accrualStart) : 0.0;
+                    p.paymentDiscount = paymentDiscount;
+                    p.couponValue = amount * paymentDiscount;
+                    contract.pieces.push_back(p);
+
+                    d0 = d1;
+                    t0 = t1;
+                    B0 = B1;
+                }
+            }
+        }
+    }
+
+    Probability CdsCurveBatchBuilder::survival(
+                                   Size segment, Time t,
+                                   const std::vector<Rate>& hazardRates,
+                                   const std::vector<Real>& integrals) const {
+        return std::exp(-integrals[segment-1]
+                        - hazardRates[segment-1]*(t-times_[segment-1]));
+    }
+
+    void CdsCurveBatchBuilder::addPiece(const Piece& p, Rate hazardRate,
+                                        Probability S0, Real& protection,
+                                        Real& premium) const {
+        Real hazard = hazardRate * p.length;
+        if (hazard <= 0.0)
+            return;
+        if (paysAtDefaultTime_) {
+            Real e1, e2;
+            detail::exponentialIntegrals(hazard + p.logDiscountRatio,
+                                         e1, e2);
+            Real density = S0 * p.discount * hazard;
+            protection += density * e1;
+            if (settlesAccrual_)
+                premium += p.accrualRate * density *
+                           (p.accrued*e1 + p.length*e2);
+        } else {
+            // paid at the end of the coupon period
+            Real dP = S0 * (1.0 - std::exp(-hazard));
+            protection += p.paymentDiscount * dP;
+            if (settlesAccrual_)
+                premium += p.couponValue * dP;
+        }
+    }
+
+    void CdsCurveBatchBuilder::bootstrap(const std::vector<Rate>& spreads,
+                                         Real recoveryRate,
+                                         std::vector<Rate>& hazardRates) const {
+        const Size n = contracts_.size();
+        QL_REQUIRE(spreads.size() == n,
+                   "wrong number of spreads (" << spreads.size()
+                   << ", " << n << " required)");
+        QL_REQUIRE(recoveryRate >= 0.0 && recoveryRate < 1.0,
+                   "recovery rate (" << recoveryRate
+                   << ") must be in [0.0, 1.0)");
+        Real lossGivenDefault = 1.0 - recoveryRate;
+
+        hazardRates.resize(n);
+        // integrals[k] is the integral of the hazard rate up to the
+        // k-th node
+        std::vector<Real> integrals(n+1, 0.0);
+        for (Size j=1; j<=n; ++j) {
+            QL_REQUIRE(spreads[j-1] >= 0.0,
+                       "negative spread (" << spreads[j-1]
+                       << ") given for " << io::ordinal(j) << " tenor");
+            const Contract& contract = contracts_[j-1];
+
+            // contributions from periods with known hazard rates
+            Real protection = 0.0, premium = 0.0;
+            Size firstPiece = 0;
+            while (firstPiece < contract.pieces.size()
+                   && contract.pieces[firstPiece].segment < j) {
+                const Piece& p = contract.pieces[firstPiece++];
+                addPiece(p, hazardRates[p.segment-1],
+                         survival(p.segment, p.start, hazardRates, integrals),
+                         protection, premium);
+            }
+            Size firstPayment = 0;
+            while (firstPayment < contract.payments.size()
+                   && contract.payments[firstPayment].segment < j) {
+                const Payment& p = contract.payments[firstPayment++];
+                premium += p.value *
+                    survival(p.segment, p.time, hazardRates, integrals);
+            }
+
+            FairSpreadError f(*this, contract, firstPiece, firstPayment,
+                              spreads[j-1], lossGivenDefault,
+                              times_[j-1], integrals[j-1],
+                              protection, premium);
+            Brent solver;
+            solver.setLowerBound(0.0);
+            // the credit triangle gives the initial guess
+            Rate guess = spreads[j-1]/lossGivenDefault;
+            hazardRates[j-1] =
+                solver.solve(f, accuracy_, guess,
+                             std::max(0.5*guess, 1.0e-4));
+            integrals[j] = integrals[j-1]
+                + hazardRates[j-1]*(times_[j]-times_[j-1]);
+        }
+    }
+
+    std::vector<Rate> CdsCurveBatchBuilder::hazardRates(
+                                          const std::vector<Rate>& spreads,
+                                          Real recoveryRate) const {
+        calculate();
+        std::vector<Rate> result;
+        bootstrap(spreads, recoveryRate, result);
+        return result;
+    }
+
+    std::vector<boost::shared_ptr<InterpolatedHazardRateCurve<BackwardFlat> > >
+    CdsCurveBatchBuilder::curves(
+                           const std::vector<std::vector<Rate> >& spreads,
+                           const std::vector<Real>& recoveryRates) const {
+        QL_REQUIRE(recoveryRates.size() == spreads.size(),
+                   "mismatch between number of spread sets ("
+                   << spreads.size() << ") and recovery rates ("
+                   << recoveryRates.size() << ")");
+        calculate();
+
+        const Size names = spreads.size();
+        std::vector<std::vector<Rate> > hazardRates(names);
+        std::vector<std::string> errors(names);
+        // exceptions can't propagate out of the parallel loop and
+        // are reported afterwards
+        #pragma omp parallel for schedule(dynamic, 16)
+        for (long i=0; i<long(names); ++i) {
+            try {
+                bootstrap(spreads[i], recoveryRates[i], hazardRates[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+
+        std::vector<boost::shared_ptr<
+            InterpolatedHazardRateCurve<BackwardFlat> > > result(names);
+        std::vector<Rate> data(dates_.size());
+        for (Size i=0; i<names; ++i) {
+            QL_REQUIRE(errors[i].empty(),
+                       "failed to bootstrap " << io::ordinal(i+1)
+                       << " curve: " << errors[i]);
+            // the first value is not used by the interpolation
+            data[0] = hazardRates[i][0];
+            std::copy(hazardRates[i].begin(), hazardRates[i].end(),
+                      data.begin()+1);
+            result[i] = boost::shared_ptr<
+                InterpolatedHazardRateCurve<BackwardFlat> >(
+                    new InterpolatedHazardRateCurve<BackwardFlat>(
+                                          dates_, data, curveDayCounter_));
+        }
+        return result;
+    }
+
+}
@@ -0,0 +1,144 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cdscurvebatchbuilder.hpp
+    \brief bootstrap of hazard-rate curves for several reference entities
+*/
+
+#ifndef quantlib_cds_curve_batch_builder_hpp
+#define quantlib_cds_curve_batch_builder_hpp
+
+#include <ql/termstructures/credit/interpolatedhazardratecurve.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/math/interpolations/backwardflatinterpolation.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/time/schedule.hpp>
+
+namespace QuantLib {
+
+    //! Bootstrap of hazard-rate curves for a universe of names
+    /*! This class bootstraps piecewise-flat hazard-rate curves from
+        running CDS spreads for any number of reference entities
+        sharing the same conventions, CDS tenors and discount curve,
+        as done for each of them by a PiecewiseDefaultCurve with
+        HazardRate traits, BackwardFlat interpolation and
+        SpreadCdsHelper instances.
+
+        The coupon schedules and the discount factors needed to price
+        the quoted swaps are calculated once for the whole universe
+        and stored as a set of periods on which hazard and forward
+        rates are flat; they are recalculated when the discount curve
+        or the evaluation date change.  For each name, the hazard
+        rates are then solved for sequentially, pricing the swaps in
+        closed form as done by IsdaCdsEngine, without instantiating
+        instruments or term structures.  When OpenMP is enabled, the
+        names are bootstrapped in parallel.
+
+        The resulting curves reprice the quoted swaps exactly when
+        used with IsdaCdsEngine; they are close to, but don't exactly
+        equal, the curves bootstrapped with SpreadCdsHelper, whose
+        swaps are priced with MidPointCdsEngine.
+
+        \warning The discount curve must not be modified while a
+                 batch is being bootstrapped.
+    */
+    class CdsCurveBatchBuilder : public LazyObject {
+      public:
+        CdsCurveBatchBuilder(const std::vector<Period>& tenors,
+                             Integer settlementDays,
+                             const Calendar& calendar,
+                             Frequency frequency,
+                             BusinessDayConvention paymentConvention,
+                             DateGeneration::Rule rule,
+                             const DayCounter& dayCounter,
+                             const Handle<YieldTermStructure>& discountCurve,
+                             const DayCounter& curveDayCounter,
+                             bool settlesAccrual = true,
+                             bool paysAtDefaultTime = true,
+                             Real accuracy = 1.0e-12);
+        //! \name Inspectors
+        //@{
+        //! the reference date followed by the maturities of the swaps
+        const std::vector<Date>& dates() const;
+        //@}
+        //! \name Calculations
+        //@{
+        /*! returns the hazard rate for each tenor, i.e., for the
+            period ending at the maturity of the corresponding swap.
+        */
+        std::vector<Rate> hazardRates(const std::vector<Rate>& spreads,
+                                      Real recoveryRate) const;
+        /*! returns a curve for each name; spreads[i][j] is the
+            running spread quoted for the i-th name and j-th tenor.
+        */
+        std::vector<boost::shared_ptr<
+                            InterpolatedHazardRateCurve<BackwardFlat> > >
+        curves(const std::vector<std::vector<Rate> >& spreads,
+               const std::vector<Real>& recoveryRates) const;
+        //@}
+      private:
+        void performCalculations() const;
+        void bootstrap(const std::vector<Rate>& spreads,
+                       Real recoveryRate,
+                       std::vector<Rate>& hazardRates) const;
+        // sub-period of a coupon on which both rates are flat
+        struct Piece {
+            Size segment;
+            Time start, length, accrued;
+            DiscountFactor discount;
+            Real logDiscountRatio, accrualRate;
+            DiscountFactor paymentDiscount;
+            Real couponValue;
+        };
+        // survival-contingent coupon payment
+        struct Payment {
+            Size segment;
+            Time time;
+            Real value;
+        };
+        struct Contract {
+            std::vector<Piece> pieces;
+            std::vector<Payment> payments;
+        };
+        class FairSpreadError;
+        friend class FairSpreadError;
+        Probability survival(Size segment, Time t,
+                             const std::vector<Rate>& hazardRates,
+                             const std::vector<Real>& integrals) const;
+        void addPiece(const Piece& p, Rate hazardRate, Probability S0,
+                      Real& protection, Real& premium) const;
+
+        std::vector<Period> tenors_;
+        Integer settlementDays_;
+        Calendar calendar_;
+        Frequency frequency_;
+        BusinessDayConvention paymentConvention_;
+        DateGeneration::Rule rule_;
+        DayCounter dayCounter_;
+        Handle<YieldTermStructure> discountCurve_;
+        DayCounter curveDayCounter_;
+        bool settlesAccrual_, paysAtDefaultTime_;
+        Real accuracy_;
+        mutable std::vector<Date> dates_;
+        mutable std::vector<Time> times_;
+        mutable std::vector<Contract> contracts_;
+    };
+
+}
+
+
+#endif
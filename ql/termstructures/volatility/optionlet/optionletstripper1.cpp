@@ -53,8 +53,7 @@ OptionletStripper1::OptionletStripper1(
         capletVols_ = Matrix(nOptionletTenors_, nStrikes_);
         capFloorVols_ = Matrix(nOptionletTenors_, nStrikes_);
 
-        Real firstGuess = 0.14; // guess is only used for shifted lognormal vols
-        optionletStDevs_ = Matrix(nOptionletTenors_, nStrikes_, firstGuess);
+        optionletStDevs_ = Matrix(nOptionletTenors_, nStrikes_, 0.0);
 
         capFloors_ = CapFloorMatrix(nOptionletTenors_);
         capFloorEngines_ = std::vector<std::vector<boost::shared_ptr<PricingEngine> > >(nOptionletTenors_);
@@ -155,10 +154,11 @@ OptionletStripper1::OptionletStripper1(
                 DiscountFactor optionletAnnuity=optionletAccrualPeriods_[i]*d;
                 try {
                   if (volatilityType_ == ShiftedLognormal) {
-                    optionletStDevs_[i][j] = blackFormulaImpliedStdDev(
-                        optionletType, strikes[j], atmOptionletRate_[i],
-                        optionletPrices_[i][j], optionletAnnuity, displacement_,
-                        optionletStDevs_[i][j], accuracy_, maxIter_);
+                    optionletStDevs_[i][j] =
+                        blackFormulaImpliedStdDevHouseholder(
+                            optionletType, strikes[j], atmOptionletRate_[i],
+                            optionletPrices_[i][j], optionletAnnuity,
+                            displacement_);
                   } else if (volatilityType_ == Normal) {
                     optionletStDevs_[i][j] =
                         std::sqrt(optionletTimes_[i]) *
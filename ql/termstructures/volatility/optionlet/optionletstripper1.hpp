@@ -42,6 +42,11 @@ namespace QuantLib {
     /*! Helper class to strip optionlet (i.e. caplet/floorlet) volatilities
         (a.k.a. forward-forward volatilities) from the (cap/floor) term
         volatilities of a CapFloorTermVolSurface.
+
+        Shifted lognormal optionlet volatilities are implied with
+        blackFormulaImpliedStdDevHouseholder, which needs neither a
+        guess nor an accuracy; the accuracy and maxIter parameters are
+        kept for backward compatibility but are no longer used.
     */
     class OptionletStripper1 : public OptionletStripper {
       public:
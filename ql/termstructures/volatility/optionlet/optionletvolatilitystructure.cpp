@@ -41,4 +41,30 @@ namespace QuantLib {
                                                     const DayCounter& dc)
     : VolatilityTermStructure(settlementDays, cal, bdc, dc) {}
 
+    void OptionletVolatilityStructure::volatilities(
+                                      const std::vector<Time>& optionTimes,
+                                      const std::vector<Rate>& strikes,
+                                      std::vector<Volatility>& results,
+                                      bool extrapolate) const {
+        QL_REQUIRE(optionTimes.size() == strikes.size(),
+                   "number of option times (" << optionTimes.size()
+                   << ") must be equal to number of strikes ("
+                   << strikes.size() << ")");
+        for (Size i=0; i<optionTimes.size(); ++i) {
+            checkRange(optionTimes[i], extrapolate);
+            checkStrike(strikes[i], extrapolate);
+        }
+        results.resize(optionTimes.size());
+        if (!optionTimes.empty())
+            volatilitiesImpl(optionTimes, strikes, results);
+    }
+
+    void OptionletVolatilityStructure::volatilitiesImpl(
+                                      const std::vector<Time>& optionTimes,
+                                      const std::vector<Rate>& strikes,
+                                      std::vector<Volatility>& results) const {
+        for (Size i=0; i<optionTimes.size(); ++i)
+            results[i] = volatilityImpl(optionTimes[i], strikes[i]);
+    }
+
 }
@@ -30,6 +30,7 @@
 #include <ql/termstructures/voltermstructure.hpp>
 #include <ql/termstructures/volatility/optionlet/optionletstripper.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -93,6 +94,16 @@ namespace QuantLib {
                            Rate strike,
                            bool extrapolate = false) const;
 
+        //! returns the volatilities for given option times and strike rates
+        /*! The results are the same as those of volatility(); derived
+            classes can override volatilitiesImpl() so as to share
+            work among the queries, e.g. the optionlets of a cap leg.
+        */
+        void volatilities(const std::vector<Time>& optionTimes,
+                          const std::vector<Rate>& strikes,
+                          std::vector<Volatility>& results,
+                          bool extrapolate = false) const;
+
         //! returns the smile for a given option tenor
         boost::shared_ptr<SmileSection> smileSection(const Period& optionTenor,
                                                      bool extr = false) const;
@@ -117,6 +128,10 @@ namespace QuantLib {
         //! implements the actual volatility calculation in derived classes
         virtual Volatility volatilityImpl(Time optionTime,
                                           Rate strike) const = 0;
+        //! calls volatilityImpl() for each query by default
+        virtual void volatilitiesImpl(const std::vector<Time>& optionTimes,
+                                      const std::vector<Rate>& strikes,
+                                      std::vector<Volatility>& results) const;
     };
 
     // inline definitions
@@ -79,6 +79,31 @@ namespace QuantLib {
         return timeInterpolator->operator()(length, true);
     }
 
+    void StrippedOptionletAdapter::volatilitiesImpl(
+                                      const std::vector<Time>& optionTimes,
+                                      const std::vector<Rate>& strikes,
+                                      std::vector<Volatility>& results) const {
+        calculate();
+
+        const std::vector<Time>& optionletTimes =
+                                    optionletStripper_->optionletFixingTimes();
+        std::vector<Volatility> vol(nInterpolations_);
+        Interpolation timeInterpolator;
+        for (Size j=0; j<optionTimes.size(); ++j) {
+            // the interpolation in time is only rebuilt when the
+            // strike changes, i.e., once for a cap with a fixed strike
+            if (j == 0 || strikes[j] != strikes[j-1]) {
+                for (Size i=0; i<nInterpolations_; ++i)
+                    vol[i] = strikeInterpolations_[i]->operator()(strikes[j],
+                                                                  true);
+                timeInterpolator =
+                    LinearInterpolation(optionletTimes.begin(),
+                                        optionletTimes.end(), vol.begin());
+            }
+            results[j] = timeInterpolator(optionTimes[j], true);
+        }
+    }
+
     void StrippedOptionletAdapter::performCalculations() const {
 
         //const std::vector<Rate>& atmForward = optionletStripper_->atmOptionletRate();
@@ -68,6 +68,9 @@ namespace QuantLib {
                                                 Time optionTime) const;
         Volatility volatilityImpl(Time length,
                                   Rate strike) const;
+        void volatilitiesImpl(const std::vector<Time>& optionTimes,
+                              const std::vector<Rate>& strikes,
+                              std::vector<Volatility>& results) const;
         //@} 
     private:
         const boost::shared_ptr<StrippedOptionletBase> optionletStripper_;
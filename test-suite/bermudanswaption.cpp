@@ -21,6 +21,7 @@
 #include "utilities.hpp"
 #include <ql/instruments/swaption.hpp>
 #include <ql/pricingengines/swaption/treeswaptionengine.hpp>
+#include <ql/pricingengines/swaption/discretizedswaption.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/pricingengines/swaption/fdhullwhiteswaptionengine.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
@@ -224,10 +225,102 @@ void BermudanSwaptionTest::testCachedValues() {
                     << "expected:   " << otmValue);
 }
 
+void BermudanSwaptionTest::testSharedTree() {
+
+    BOOST_TEST_MESSAGE("Testing Bermudan swaptions priced on a shared tree...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+
+    Settings::instance().evaluationDate() = vars.today;
+
+    vars.settlement = Date(19, February, 2002);
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                          0.04875825,
+                                          Actual365Fixed()));
+
+    Rate atmRate = vars.makeSwap(0.0)->fairRate();
+
+    boost::shared_ptr<HullWhite> model(new HullWhite(vars.termStructure,
+                                                     0.048696, 0.0058904));
+
+    // a small book of swaptions with different strikes and
+    // exercise schedules...
+    std::vector<boost::shared_ptr<Swaption> > swaptions;
+    Real strikes[] = { 0.8, 1.0, 1.2 };
+    Integer exerciseShifts[] = { 0, -10 };
+    for (Size i=0; i<LENGTH(strikes); ++i) {
+        boost::shared_ptr<VanillaSwap> swap =
+            vars.makeSwap(strikes[i]*atmRate);
+        for (Size j=0; j<LENGTH(exerciseShifts); ++j) {
+            std::vector<Date> exerciseDates;
+            const Leg& leg = swap->fixedLeg();
+            for (Size k=0; k<leg.size(); k++) {
+                boost::shared_ptr<Coupon> coupon =
+                    boost::dynamic_pointer_cast<Coupon>(leg[k]);
+                exerciseDates.push_back(vars.calendar.adjust(
+                           coupon->accrualStartDate() + exerciseShifts[j]));
+            }
+            boost::shared_ptr<Exercise> exercise(
+                                      new BermudanExercise(exerciseDates));
+            swaptions.push_back(boost::shared_ptr<Swaption>(
+                                              new Swaption(swap, exercise)));
+        }
+    }
+
+    // ...whose mandatory times are merged into a single grid
+    std::vector<Time> times;
+    for (Size i=0; i<swaptions.size(); ++i) {
+        Swaption::arguments arguments;
+        swaptions[i]->setupArguments(&arguments);
+        DiscretizedSwaption discretized(
+                                arguments,
+                                vars.termStructure->referenceDate(),
+                                vars.termStructure->dayCounter());
+        std::vector<Time> t = discretized.mandatoryTimes();
+        times.insert(times.end(), t.begin(), t.end());
+    }
+
+    boost::shared_ptr<ShortRateTreeCache> cache(
+         new ShortRateTreeCache(Handle<ShortRateModel>(model), times, 100));
+
+    boost::shared_ptr<PricingEngine> sharedEngine(
+                                            new TreeSwaptionEngine(cache));
+    boost::shared_ptr<PricingEngine> ownEngine(
+                            new TreeSwaptionEngine(model, cache->timeGrid()));
+
+    Real tolerance = 1.0e-10;
+
+    for (Size n=0; n<2; ++n) {
+        if (n == 1) {
+            // the shared tree must be rebuilt when the model changes
+            Array parameters = model->params();
+            parameters[1] *= 1.2;
+            model->setParams(parameters);
+        }
+        for (Size i=0; i<swaptions.size(); ++i) {
+            swaptions[i]->setPricingEngine(ownEngine);
+            Real expected = swaptions[i]->NPV();
+            swaptions[i]->setPricingEngine(sharedEngine);
+            Real calculated = swaptions[i]->NPV();
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("failed to reproduce swaption value "
+                            "on shared tree"
+                            << (n == 1 ? " after model change" : "") << ":"
+                            << "\n    swaption:   " << i+1
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
+
 
 test_suite* BermudanSwaptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Bermudan swaption tests");
     suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testCachedValues));
+    suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testSharedTree));
     return suite;
 }
 
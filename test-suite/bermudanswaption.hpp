@@ -28,6 +28,7 @@
 class BermudanSwaptionTest {
   public:
     static void testCachedValues();
+    static void testSharedTree();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -117,6 +117,245 @@ void BlackFormulaTest::testChambersImpliedVol() {
     }
 }
 
+void BlackFormulaTest::testBatchFormulas() {
+
+    BOOST_TEST_MESSAGE("Testing batch Black and Bachelier formulas...");
+
+    Option::Type types[] = {Option::Call, Option::Put};
+    Real displacements[] = {0.0000, 0.0050, 0.0100};
+    Real forwards[] = {-0.0010, 0.0000, 0.0050, 0.0200, 0.0500, 100.0};
+    Real strikes[] = {-0.0100, -0.0050, 0.0000, 0.0010, 0.0050,
+                      0.0200, 0.1000, 80.0, 100.0, 120.0};
+    Real stdDevs[] = {0.0, 0.0001, 0.01, 0.10, 0.30, 1.00, 2.00, 6.00};
+    Real discounts[] = {1.00, 0.80, 1.10};
+
+    Real tol = 1.0E-12;
+
+    for (Size i1 = 0; i1 < LENGTH(types); ++i1) {
+        for (Size i2 = 0; i2 < LENGTH(displacements); ++i2) {
+            Real displacement = displacements[i2];
+            std::vector<Real> k, f, s, d;
+            for (Size i3 = 0; i3 < LENGTH(forwards); ++i3) {
+                for (Size i4 = 0; i4 < LENGTH(strikes); ++i4) {
+                    for (Size i5 = 0; i5 < LENGTH(stdDevs); ++i5) {
+                        for (Size i6 = 0; i6 < LENGTH(discounts); ++i6) {
+                            k.push_back(strikes[i4]);
+                            f.push_back(forwards[i3]);
+                            s.push_back(stdDevs[i5]);
+                            d.push_back(discounts[i6]);
+                        }
+                    }
+                }
+            }
+
+            std::vector<Real> values, vegas;
+            bachelierBlackFormula(types[i1], k, f, s, d, values);
+            bachelierBlackFormulaStdDevDerivative(k, f, s, d, vegas);
+            for (Size i = 0; i < k.size(); ++i) {
+                Real value =
+                    bachelierBlackFormula(types[i1], k[i], f[i], s[i], d[i]);
+                Real vega =
+                    bachelierBlackFormulaStdDevDerivative(k[i], f[i], s[i],
+                                                          d[i]);
+                if (std::fabs(values[i] - value) >
+                                tol * std::max(1.0, std::fabs(value)) ||
+                    std::fabs(vegas[i] - vega) >
+                                tol * std::max(1.0, std::fabs(vega)))
+                    BOOST_ERROR("batch Bachelier formula mismatch for "
+                                << types[i1]
+                                << "\n    forward:         " << f[i]
+                                << "\n    strike:          " << k[i]
+                                << "\n    std dev:         " << s[i]
+                                << "\n    discount:        " << d[i]
+                                << "\n    value:           " << value
+                                << "\n    batch value:     " << values[i]
+                                << "\n    vega:            " << vega
+                                << "\n    batch vega:      " << vegas[i]);
+            }
+
+            // Black needs positive displaced forwards and
+            // non-negative displaced strikes
+            std::vector<Real> bk, bf, bs, bd;
+            for (Size i = 0; i < k.size(); ++i) {
+                if (f[i] + displacement > 0.0 &&
+                    k[i] + displacement >= 0.0) {
+                    bk.push_back(k[i]);
+                    bf.push_back(f[i]);
+                    bs.push_back(s[i]);
+                    bd.push_back(d[i]);
+                }
+            }
+            blackFormula(types[i1], bk, bf, bs, bd, values, displacement);
+            blackFormulaStdDevDerivative(bk, bf, bs, bd, vegas, displacement);
+            for (Size i = 0; i < bk.size(); ++i) {
+                Real value = blackFormula(types[i1], bk[i], bf[i], bs[i],
+                                          bd[i], displacement);
+                Real vega = blackFormulaStdDevDerivative(bk[i], bf[i], bs[i],
+                                                         bd[i], displacement);
+                if (std::fabs(values[i] - value) >
+                                tol * std::max(1.0, std::fabs(value)) ||
+                    std::fabs(vegas[i] - vega) >
+                                tol * std::max(1.0, std::fabs(vega)))
+                    BOOST_ERROR("batch Black formula mismatch for "
+                                << types[i1]
+                                << "\n    displacement:    " << displacement
+                                << "\n    forward:         " << bf[i]
+                                << "\n    strike:          " << bk[i]
+                                << "\n    std dev:         " << bs[i]
+                                << "\n    discount:        " << bd[i]
+                                << "\n    value:           " << value
+                                << "\n    batch value:     " << values[i]
+                                << "\n    vega:            " << vega
+                                << "\n    batch vega:      " << vegas[i]);
+            }
+
+            // values and derivatives calculated together must match
+            // the ones above; the forward derivatives are checked
+            // against finite differences away from the kink and, for
+            // Black, where roundoff doesn't spoil them
+            std::vector<Real> values2, vegas2, deltas;
+            blackFormulaWithDerivatives(types[i1], bk, bf, bs, bd, values2,
+                                        vegas2, deltas, displacement);
+            for (Size i = 0; i < bk.size(); ++i) {
+                Real h = 1.0E-6 * (bf[i] + displacement);
+                Real delta = Null<Real>();
+                Real moneyness = (bk[i] + displacement)/(bf[i] + displacement);
+                if (bs[i] >= 0.01 && moneyness <= 10.0)
+                    delta = (blackFormula(types[i1], bk[i], bf[i]+h, bs[i],
+                                          bd[i], displacement) -
+                             blackFormula(types[i1], bk[i], bf[i]-h, bs[i],
+                                          bd[i], displacement)) / (2.0*h);
+                if (values2[i] != values[i] || vegas2[i] != vegas[i] ||
+                    (delta != Null<Real>() &&
+                     std::fabs(deltas[i] - delta) > 1.0E-6))
+                    BOOST_ERROR("Black formula with derivatives mismatch for "
+                                << types[i1]
+                                << "\n    displacement:    " << displacement
+                                << "\n    forward:         " << bf[i]
+                                << "\n    strike:          " << bk[i]
+                                << "\n    std dev:         " << bs[i]
+                                << "\n    discount:        " << bd[i]
+                                << "\n    value:           " << values[i]
+                                << "\n    batch value:     " << values2[i]
+                                << "\n    vega:            " << vegas[i]
+                                << "\n    batch vega:      " << vegas2[i]
+                                << "\n    delta:           " << delta
+                                << "\n    batch delta:     " << deltas[i]);
+            }
+
+            bachelierBlackFormula(types[i1], k, f, s, d, values);
+            bachelierBlackFormulaStdDevDerivative(k, f, s, d, vegas);
+            bachelierBlackFormulaWithDerivatives(types[i1], k, f, s, d,
+                                                 values2, vegas2, deltas);
+            for (Size i = 0; i < k.size(); ++i) {
+                Real h = 1.0E-6 * std::max(1.0, std::fabs(f[i]));
+                Real delta = Null<Real>();
+                if (s[i] >= 0.01)
+                    delta = (bachelierBlackFormula(types[i1], k[i], f[i]+h,
+                                                   s[i], d[i]) -
+                             bachelierBlackFormula(types[i1], k[i], f[i]-h,
+                                                   s[i], d[i])) / (2.0*h);
+                if (std::fabs(values2[i] - values[i]) >
+                                tol * std::max(1.0, std::fabs(values[i])) ||
+                    std::fabs(vegas2[i] - vegas[i]) >
+                                tol * std::max(1.0, std::fabs(vegas[i])) ||
+                    (delta != Null<Real>() &&
+                     std::fabs(deltas[i] - delta) > 1.0E-6))
+                    BOOST_ERROR("Bachelier formula with derivatives mismatch "
+                                "for " << types[i1]
+                                << "\n    forward:         " << f[i]
+                                << "\n    strike:          " << k[i]
+                                << "\n    std dev:         " << s[i]
+                                << "\n    discount:        " << d[i]
+                                << "\n    value:           " << values[i]
+                                << "\n    batch value:     " << values2[i]
+                                << "\n    vega:            " << vegas[i]
+                                << "\n    batch vega:      " << vegas2[i]
+                                << "\n    delta:           " << delta
+                                << "\n    batch delta:     " << deltas[i]);
+            }
+        }
+    }
+}
+
+void BlackFormulaTest::testHouseholderImpliedStdDev() {
+
+    BOOST_TEST_MESSAGE("Testing Householder Black implied std dev...");
+
+    Option::Type types[] = {Option::Call, Option::Put};
+    Real displacements[] = {0.0000, 0.0100};
+    Real forwards[] = {0.0050, 0.0300, 100.0};
+    Real moneyness[] = {0.01, 0.3, 0.8, 0.99, 1.0, 1.01, 1.25, 3.0, 100.0};
+    Real stdDevs[] = {0.001, 0.01, 0.05, 0.20, 0.50, 1.00, 3.00, 8.00};
+    Real discount = 0.9;
+
+    for (Size i1 = 0; i1 < LENGTH(types); ++i1) {
+      for (Size i2 = 0; i2 < LENGTH(displacements); ++i2) {
+        Real displacement = displacements[i2];
+        std::vector<Real> k, f, p, s;
+        for (Size i3 = 0; i3 < LENGTH(forwards); ++i3) {
+          Real forward = forwards[i3];
+          for (Size i4 = 0; i4 < LENGTH(moneyness); ++i4) {
+            Real strike = (forward+displacement)*moneyness[i4]
+                          - displacement;
+            for (Size i5 = 0; i5 < LENGTH(stdDevs); ++i5) {
+                Real stdDev = stdDevs[i5];
+                Real price = blackFormula(types[i1], strike, forward, stdDev,
+                                          discount, displacement);
+                Real vega = blackFormulaStdDevDerivative(strike, forward,
+                                          stdDev, discount, displacement);
+                // the price must carry enough information on the
+                // std dev to make the inversion meaningful
+                if (vega*stdDev < 1.0e-6*price || price < 1.0e-8*forward)
+                    continue;
+                Real implied = blackFormulaImpliedStdDevHouseholder(
+                    types[i1], strike, forward, price, discount, displacement);
+                // errors on the price are amplified by 1/vega; besides
+                // rounding, the cumulative normal used by blackFormula
+                // loses relative accuracy far in the tails
+                Real timeValue = price - discount*std::max(
+                    (forward-strike)*types[i1], 0.0);
+                Real tol = 1.0e-12*stdDev
+                         + (1.0e-14*price + 1.0e-8*timeValue)/vega;
+                if (std::fabs(implied - stdDev) > tol)
+                    BOOST_ERROR("failed to reproduce Black std dev for "
+                                << types[i1]
+                                << "\n    displacement:    " << displacement
+                                << "\n    forward:         " << forward
+                                << "\n    strike:          " << strike
+                                << "\n    price:           " << price
+                                << "\n    std dev:         " << stdDev
+                                << "\n    implied std dev: " << implied
+                                << "\n    error:           "
+                                << implied - stdDev
+                                << "\n    tolerance:       " << tol);
+                k.push_back(strike);
+                f.push_back(forward);
+                p.push_back(price);
+                s.push_back(implied);
+            }
+          }
+        }
+
+        std::vector<Real> implied;
+        blackFormulaImpliedStdDev(types[i1], k, f, p,
+                                  std::vector<Real>(k.size(), discount),
+                                  implied, displacement);
+        for (Size i = 0; i < k.size(); ++i) {
+            if (implied[i] != s[i])
+                BOOST_ERROR("batch implied std dev mismatch for "
+                            << types[i1]
+                            << "\n    displacement:    " << displacement
+                            << "\n    forward:         " << f[i]
+                            << "\n    strike:          " << k[i]
+                            << "\n    price:           " << p[i]
+                            << "\n    implied std dev: " << s[i]
+                            << "\n    batch value:     " << implied[i]);
+        }
+      }
+    }
+}
+
 test_suite* BlackFormulaTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Black formula tests");
 
@@ -124,6 +363,10 @@ test_suite* BlackFormulaTest::suite() {
         &BlackFormulaTest::testBachelierImpliedVol));
     suite->add(QUANTLIB_TEST_CASE(
         &BlackFormulaTest::testChambersImpliedVol));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testBatchFormulas));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testHouseholderImpliedStdDev));
 
     return suite;
 }
@@ -611,6 +611,83 @@ void CapFloorTest::testCachedValue() {
 }
 
 
+void CapFloorTest::testOptionletDeltas() {
+
+    BOOST_TEST_MESSAGE("Testing Black optionlet deltas...");
+
+    CommonVars vars;
+
+    // the forwarding curve is bumped with the discount curve kept
+    // fixed, so that only the forwards of the optionlets change; the
+    // strikes are away from the forward of the first optionlet, which
+    // is fixed today
+    Handle<YieldTermStructure> discountCurve(
+            flatRate(vars.settlement, 0.05, ActualActual(ActualActual::ISDA)));
+    Handle<Quote> vol(boost::shared_ptr<Quote>(new SimpleQuote(0.20)));
+    boost::shared_ptr<PricingEngine> engine(
+                                new BlackCapFloorEngine(discountCurve, vol));
+
+    Date startDate = vars.termStructure->referenceDate();
+    Leg leg = vars.makeLeg(startDate, 10);
+    std::vector<boost::shared_ptr<CapFloor> > capFloors;
+    capFloors.push_back(boost::shared_ptr<CapFloor>(
+                        new Cap(leg, std::vector<Rate>(1, 0.055))));
+    capFloors.push_back(boost::shared_ptr<CapFloor>(
+                        new Floor(leg, std::vector<Rate>(1, 0.045))));
+    capFloors.push_back(boost::shared_ptr<CapFloor>(
+                        new Collar(leg, std::vector<Rate>(1, 0.06),
+                                   std::vector<Rate>(1, 0.03))));
+
+    Rate rate = 0.05, bump = 1.0e-6;
+    for (Size n=0; n<capFloors.size(); ++n) {
+        CapFloor& capFloor = *capFloors[n];
+        capFloor.setPricingEngine(engine);
+
+        vars.termStructure.linkTo(flatRate(vars.settlement, rate,
+                                     ActualActual(ActualActual::ISDA)));
+        std::vector<Real> deltas =
+            capFloor.result<std::vector<Real> >("optionletsDelta");
+        std::vector<Real> prices =
+            capFloor.result<std::vector<Real> >("optionletsPrice");
+        Real value = capFloor.NPV();
+
+        vars.termStructure.linkTo(flatRate(vars.settlement, rate+bump,
+                                     ActualActual(ActualActual::ISDA)));
+        std::vector<Real> upPrices =
+            capFloor.result<std::vector<Real> >("optionletsPrice");
+        std::vector<Rate> upForwards =
+            capFloor.result<std::vector<Rate> >("optionletsAtmForward");
+
+        vars.termStructure.linkTo(flatRate(vars.settlement, rate-bump,
+                                     ActualActual(ActualActual::ISDA)));
+        std::vector<Real> downPrices =
+            capFloor.result<std::vector<Real> >("optionletsPrice");
+        std::vector<Rate> downForwards =
+            capFloor.result<std::vector<Rate> >("optionletsAtmForward");
+
+        Real sum = 0.0;
+        for (Size i=0; i<deltas.size(); ++i) {
+            sum += prices[i];
+            Real expected = (upPrices[i] - downPrices[i])
+                          / (upForwards[i] - downForwards[i]);
+            if (std::fabs(deltas[i] - expected) >
+                                    1.0e-6 * std::max(1.0, std::fabs(expected)))
+                BOOST_ERROR("failed to reproduce "
+                            << typeToString(capFloor.type())
+                            << " optionlet delta:"
+                            << "\n    optionlet:  " << i
+                            << "\n    calculated: " << deltas[i]
+                            << "\n    expected:   " << expected);
+        }
+        if (std::fabs(sum - value) > 1.0e-10)
+            BOOST_ERROR("optionlet prices don't add up to "
+                        << typeToString(capFloor.type()) << " value:"
+                        << "\n    sum:   " << sum
+                        << "\n    value: " << value);
+    }
+}
+
+
 test_suite* CapFloorTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cap/floor tests");
     suite->add(QUANTLIB_TEST_CASE(&CapFloorTest::testStrikeDependency));
@@ -621,6 +698,7 @@ test_suite* CapFloorTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&CapFloorTest::testATMRate));
     suite->add(QUANTLIB_TEST_CASE(&CapFloorTest::testImpliedVolatility));
     suite->add(QUANTLIB_TEST_CASE(&CapFloorTest::testCachedValue));
+    suite->add(QUANTLIB_TEST_CASE(&CapFloorTest::testOptionletDeltas));
     return suite;
 }
 
@@ -35,12 +35,14 @@
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/cashflows/floatingratecoupon.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/bond/bondfunctions.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <sstream>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -130,6 +132,34 @@ void CatBondTest::testEventSetForNoEvents () {
     BOOST_REQUIRE(!simulation->nextPath(path));
 }
 
+void CatBondTest::testEventSetFromStream() {
+    BOOST_TEST_MESSAGE("Testing that catastrophe events read from a stream are split as those in memory...");
+
+    boost::shared_ptr<std::istream> stream(new std::istringstream(
+        "# date loss\n"
+        "2012-02-01 100\n"
+        "2013-07-01 150\n"
+        "\n"
+        "2014-01-05 50\n"));
+    boost::shared_ptr<EventReader> reader(new StreamEventReader(stream));
+    EventSetSimulation streamed(reader, eventsStart, eventsEnd, Date(2, January, 2015), Date(5, January, 2016));
+
+    EventSet catRisk(sampleEvents, eventsStart, eventsEnd);
+    boost::shared_ptr<CatSimulation> simulation = catRisk.newSimulation(Date(2, January, 2015), Date(5, January, 2016));
+
+    std::vector<std::pair<Date, Real> > path, expected;
+    while (simulation->nextPath(expected)) {
+        BOOST_REQUIRE(streamed.nextPath(path));
+        BOOST_REQUIRE_EQUAL(expected.size(), path.size());
+        for (Size i=0; i<path.size(); ++i) {
+            BOOST_CHECK_EQUAL(expected[i].first, path[i].first);
+            BOOST_CHECK_EQUAL(expected[i].second, path[i].second);
+        }
+    }
+    BOOST_REQUIRE(!streamed.nextPath(path));
+}
+
+
 void CatBondTest::testBetaRisk() {
     BOOST_TEST_MESSAGE("Testing that beta risk gives correct terminal distribution...");
 
@@ -668,17 +698,179 @@ void CatBondTest::testCatBondWithGeneratedEventsProportional() {
     BOOST_CHECK_LT(riskFreeYield, yield);
 }
 
+
+void CatBondTest::testPortfolioPricing() {
+    BOOST_TEST_MESSAGE("Testing cat bonds priced together on the same events...");
+
+    CommonVars vars;
+
+    Date today(22,November,2004);
+    Settings::instance().evaluationDate() = today;
+
+    Natural settlementDays = 1;
+
+    Handle<YieldTermStructure> riskFreeRate(flatRate(today,0.025,Actual360()));
+    Handle<YieldTermStructure> discountCurve(flatRate(today,0.03,Actual360()));
+
+    shared_ptr<IborIndex> index(new USDLibor(6*Months, riskFreeRate));
+    Natural fixingDays = 1;
+
+    shared_ptr<IborCouponPricer> pricer(new
+        BlackIborCouponPricer(Handle<OptionletVolatilityStructure>()));
+
+    Schedule sch(Date(30,November,2004),
+                 Date(30,November,2008),
+                 Period(Semiannual),
+                 UnitedStates(UnitedStates::GovernmentBond),
+                 ModifiedFollowing, ModifiedFollowing,
+                 DateGeneration::Backward, false);
+
+    boost::shared_ptr<CatRisk> betaCatRisk(new BetaRisk(5000, 50, 500, 500));
+
+    boost::shared_ptr<EventPaymentOffset> paymentOffset(new NoOffset());
+    boost::shared_ptr<NotionalRisk> notionalRisks[] = {
+        boost::shared_ptr<NotionalRisk>(new ProportionalNotionalRisk(paymentOffset, 500, 1500)),
+        boost::shared_ptr<NotionalRisk>(new ProportionalNotionalRisk(paymentOffset, 1000, 3000)),
+        boost::shared_ptr<NotionalRisk>(new DigitalNotionalRisk(paymentOffset, 2000))
+    };
+
+    shared_ptr<MonteCarloCatBondEngine> catBondEngine(new MonteCarloCatBondEngine(betaCatRisk, discountCurve));
+
+    std::vector<boost::shared_ptr<CatBond> > catBonds;
+    for (Size i=0; i<LENGTH(notionalRisks); ++i) {
+        boost::shared_ptr<CatBond> catBond(new FloatingCatBond(
+                           settlementDays, vars.faceAmount, sch,
+                           index, ActualActual(ActualActual::ISMA),
+                           notionalRisks[i],
+                           ModifiedFollowing, fixingDays,
+                           std::vector<Rate>(), std::vector<Spread>(),
+                           std::vector<Rate>(), std::vector<Rate>(),
+                           false,
+                           100.0, Date(30,November,2004)));
+        catBond->setPricingEngine(catBondEngine);
+        setCouponPricer(catBond->cashflows(),pricer);
+        catBonds.push_back(catBond);
+    }
+
+    // the bonds have the same risk period, so that they are priced
+    // on the same paths as when priced separately
+    std::vector<CatBond::results> results = catBondEngine->portfolioResults(catBonds);
+
+    Real tolerance = 1.0e-8;
+    for (Size i=0; i<catBonds.size(); ++i) {
+        BOOST_CHECK_CLOSE(catBonds[i]->NPV(), results[i].value, tolerance);
+        BOOST_CHECK_CLOSE(catBonds[i]->settlementValue(), results[i].settlementValue, tolerance);
+        BOOST_CHECK_EQUAL(catBonds[i]->lossProbability(), results[i].lossProbability);
+        BOOST_CHECK_EQUAL(catBonds[i]->exhaustionProbability(), results[i].exhaustionProbability);
+        BOOST_CHECK_CLOSE(catBonds[i]->expectedLoss(), results[i].expectedLoss, tolerance);
+    }
+}
+
+void CatBondTest::testPortfolioPricingDuringRiskPeriod() {
+    BOOST_TEST_MESSAGE("Testing cat bonds priced together during their risk periods...");
+
+    CommonVars vars;
+    IndexHistoryCleaner cleaner;
+
+    Date today(22,November,2005);
+    Settings::instance().evaluationDate() = today;
+
+    Natural settlementDays = 1;
+
+    Handle<YieldTermStructure> riskFreeRate(flatRate(today,0.025,Actual360()));
+    Handle<YieldTermStructure> discountCurve(flatRate(today,0.03,Actual360()));
+
+    shared_ptr<IborIndex> index(new USDLibor(6*Months, riskFreeRate));
+    Natural fixingDays = 1;
+
+    shared_ptr<IborCouponPricer> pricer(new
+        BlackIborCouponPricer(Handle<OptionletVolatilityStructure>()));
+
+    // the first two bonds are already in their risk period, the
+    // third one starts in a year
+    Date startDates[] = { Date(30,November,2004),
+                          Date(30,November,2004),
+                          Date(30,November,2006) };
+    boost::shared_ptr<EventPaymentOffset> paymentOffset(new NoOffset());
+    boost::shared_ptr<NotionalRisk> notionalRisks[] = {
+        boost::shared_ptr<NotionalRisk>(new ProportionalNotionalRisk(paymentOffset, 500, 1500)),
+        boost::shared_ptr<NotionalRisk>(new DigitalNotionalRisk(paymentOffset, 1000)),
+        boost::shared_ptr<NotionalRisk>(new ProportionalNotionalRisk(paymentOffset, 1000, 3000))
+    };
+
+    std::vector<std::pair<Date, Real> > events;
+    for (Year y=1980; y<2005; ++y)
+        events.push_back(std::make_pair(Date(15, Month(1+y%12), y),
+                                        Real(400 + 150*(y%13))));
+    boost::shared_ptr<CatRisk> catRisks[] = {
+        boost::shared_ptr<CatRisk>(new BetaRisk(5000, 50, 500, 500)),
+        boost::shared_ptr<CatRisk>(new EventSet(
+            boost::shared_ptr<std::vector<std::pair<Date, Real> > >(
+                new std::vector<std::pair<Date, Real> >(events)),
+            Date(1, January, 1980), Date(31, December, 2004)))
+    };
+
+    for (Size k=0; k<LENGTH(catRisks); ++k) {
+        shared_ptr<MonteCarloCatBondEngine> catBondEngine(new MonteCarloCatBondEngine(catRisks[k], discountCurve));
+
+        std::vector<boost::shared_ptr<CatBond> > catBonds;
+        for (Size i=0; i<LENGTH(notionalRisks); ++i) {
+            Schedule sch(startDates[i],
+                         startDates[i] + 4*Years,
+                         Period(Semiannual),
+                         UnitedStates(UnitedStates::GovernmentBond),
+                         ModifiedFollowing, ModifiedFollowing,
+                         DateGeneration::Backward, false);
+            boost::shared_ptr<CatBond> catBond(new FloatingCatBond(
+                               settlementDays, vars.faceAmount, sch,
+                               index, ActualActual(ActualActual::ISMA),
+                               notionalRisks[i],
+                               ModifiedFollowing, fixingDays,
+                               std::vector<Rate>(), std::vector<Spread>(),
+                               std::vector<Rate>(), std::vector<Rate>(),
+                               false,
+                               100.0, startDates[i]));
+            catBond->setPricingEngine(catBondEngine);
+            setCouponPricer(catBond->cashflows(),pricer);
+            for (Size j=0; j<catBond->cashflows().size(); ++j) {
+                shared_ptr<FloatingRateCoupon> coupon =
+                    boost::dynamic_pointer_cast<FloatingRateCoupon>(
+                                                 catBond->cashflows()[j]);
+                if (coupon && coupon->fixingDate() < today)
+                    index->addFixing(coupon->fixingDate(), 0.025, true);
+            }
+            catBonds.push_back(catBond);
+        }
+
+        // each bond must be priced on the same events as when priced
+        // separately, both as of today and as of its settlement date
+        std::vector<CatBond::results> results = catBondEngine->portfolioResults(catBonds);
+
+        Real tolerance = 1.0e-8;
+        for (Size i=0; i<catBonds.size(); ++i) {
+            BOOST_CHECK_CLOSE(catBonds[i]->NPV(), results[i].value, tolerance);
+            BOOST_CHECK_CLOSE(catBonds[i]->settlementValue(), results[i].settlementValue, tolerance);
+            BOOST_CHECK_EQUAL(catBonds[i]->lossProbability(), results[i].lossProbability);
+            BOOST_CHECK_EQUAL(catBonds[i]->exhaustionProbability(), results[i].exhaustionProbability);
+            BOOST_CHECK_CLOSE(catBonds[i]->expectedLoss(), results[i].expectedLoss, tolerance);
+        }
+    }
+}
+
 test_suite* CatBondTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("CatBond tests");
 
     suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testEventSetForWholeYears));
     suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testEventSetForIrregularPeriods));
     suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testEventSetForNoEvents));
+    suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testEventSetFromStream));
     suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testBetaRisk));
     suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testRiskFreeAgainstFloatingRateBond));
     suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testCatBondInDoomScenario));
     suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testCatBondWithDoomOnceInTenYears));
     suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testCatBondWithDoomOnceInTenYearsProportional));
     suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testCatBondWithGeneratedEventsProportional));
+    suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testPortfolioPricing));
+    suite->add(QUANTLIB_TEST_CASE(&CatBondTest::testPortfolioPricingDuringRiskPeriod));
     return suite;
 }
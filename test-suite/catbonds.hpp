@@ -27,12 +27,15 @@ class CatBondTest {
     static void testEventSetForWholeYears();
     static void testEventSetForIrregularPeriods();
     static void testEventSetForNoEvents();
+    static void testEventSetFromStream();
     static void testBetaRisk();
     static void testRiskFreeAgainstFloatingRateBond();
     static void testCatBondInDoomScenario();
     static void testCatBondWithDoomOnceInTenYears();
     static void testCatBondWithDoomOnceInTenYearsProportional();
     static void testCatBondWithGeneratedEventsProportional();
+    static void testPortfolioPricing();
+    static void testPortfolioPricingDuringRiskPeriod();
     static boost::unit_test_framework::test_suite* suite();
 };
 
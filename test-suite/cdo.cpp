@@ -26,6 +26,8 @@
 #include <ql/experimental/credit/randomdefaultlatentmodel.hpp>
 #include <ql/experimental/credit/inhomogeneouspooldef.hpp>
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
+#include <ql/experimental/credit/recursivelossmodel.hpp>
+#include <ql/experimental/credit/fftlossmodel.hpp>
 
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -361,11 +363,121 @@ void CdoTest::testHW(unsigned dataSet) {
     }
 }
 
+void CdoTest::testFFTLossModel() {
+
+    BOOST_TEST_MESSAGE("Testing FFT loss model against recursive model...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    // heterogeneous pool; losses given default are multiples of 60
+    Size poolSize = 30;
+    Real recovery = 0.4;
+    boost::shared_ptr<Pool> pool(new Pool());
+    vector<string> names;
+    vector<Real> nominals;
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        nominals.push_back(100.0*(1 + i%3));
+        Handle<DefaultProbabilityTermStructure> curve(
+            boost::shared_ptr<DefaultProbabilityTermStructure>(
+                new FlatHazardRate(asofDate, 0.005 + 0.001*i,
+                                   ActualActual())));
+        vector<pair<DefaultProbKey,
+                    Handle<DefaultProbabilityTermStructure> > > probabilities;
+        probabilities.push_back(std::make_pair(
+            NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                       Period(0,Weeks), 10.),
+            curve));
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+    }
+
+    Handle<Quote> correlation(
+                        boost::shared_ptr<Quote>(new SimpleQuote(0.3)));
+    boost::shared_ptr<GaussianConstantLossLM> lossLM(
+        new GaussianConstantLossLM(correlation,
+                                   vector<Real>(poolSize, recovery),
+                                   LatentModelIntegrationType::GaussianQuadrature,
+                                   poolSize,
+                                   GaussianCopulaPolicy::initTraits()));
+
+    Size nBuckets = 0;
+    for (Size i=0; i<poolSize; ++i)
+        nBuckets += 1 + i%3;
+
+    boost::shared_ptr<DefaultLossModel> recursive(
+                                    new RecursiveGaussLossModel(lossLM));
+    boost::shared_ptr<DefaultLossModel> exact(
+                                new FFTGaussLossModel(lossLM, nBuckets));
+    boost::shared_ptr<DefaultLossModel> poisson(
+        new FFTGaussLossModel(lossLM, nBuckets, 5., -5., 50,
+                              FFTGaussLossModel::CompoundPoisson));
+
+    Real attachment[] = { 0.00, 0.03, 0.07, 0.15 };
+    Real detachment[] = { 0.03, 0.07, 0.15, 1.00 };
+    Date dates[] = { Date(31, August, 2008), Date(31, August, 2011) };
+    Real tolerance = 1.0e-6, poissonTolerance = 0.01;
+
+    for (Size j=0; j<LENGTH(attachment); ++j) {
+        boost::shared_ptr<Basket> basket(
+            new Basket(asofDate, names, nominals, pool,
+                       attachment[j], detachment[j]));
+        Real trancheNotional = basket->trancheNotional();
+        for (Size k=0; k<LENGTH(dates); ++k) {
+            basket->setLossModel(recursive);
+            Real expected = basket->expectedTrancheLoss(dates[k]);
+
+            basket->setLossModel(exact);
+            Real calculated = basket->expectedTrancheLoss(dates[k]);
+            if (std::fabs(calculated-expected) > tolerance*trancheNotional)
+                BOOST_ERROR("failed to reproduce expected tranche loss"
+                            << "\n    tranche:    " << attachment[j]
+                            << " - " << detachment[j]
+                            << "\n    date:       " << dates[k]
+                            << std::setprecision(10)
+                            << "\n    FFT:        " << calculated
+                            << "\n    recursive:  " << expected);
+
+            // expected shortfall at the null percentile is the
+            // expected loss
+            Real shortfall = basket->expectedShortfall(dates[k], 0.0);
+            if (std::fabs(shortfall-calculated) > 1.0e-10*trancheNotional)
+                BOOST_ERROR("inconsistent expected shortfall"
+                            << "\n    tranche:    " << attachment[j]
+                            << " - " << detachment[j]
+                            << "\n    date:       " << dates[k]
+                            << std::setprecision(10)
+                            << "\n    shortfall:  " << shortfall
+                            << "\n    loss:       " << calculated);
+
+            basket->setLossModel(poisson);
+            calculated = basket->expectedTrancheLoss(dates[k]);
+            if (std::fabs(calculated-expected) >
+                                        poissonTolerance*trancheNotional)
+                BOOST_ERROR("compound-Poisson approximation too far from "
+                            "expected tranche loss"
+                            << "\n    tranche:    " << attachment[j]
+                            << " - " << detachment[j]
+                            << "\n    date:       " << dates[k]
+                            << std::setprecision(10)
+                            << "\n    FFT:        " << calculated
+                            << "\n    recursive:  " << expected);
+        }
+    }
+}
+
 
 test_suite* CdoTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("CDO tests");
     for (unsigned i=0; i < LENGTH(hwData7); ++i)
         suite->add(QUANTLIB_TEST_CASE(
             boost::bind(&CdoTest::testHW, i)));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testFFTLossModel));
     return suite;
 }
@@ -28,6 +28,7 @@
 class CdoTest {
   public:
     static void testHW(unsigned dataSet);
+    static void testFFTLossModel();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -22,15 +22,18 @@
 #include <ql/instruments/creditdefaultswap.hpp>
 #include <ql/pricingengines/credit/midpointcdsengine.hpp>
 #include <ql/pricingengines/credit/integralcdsengine.hpp>
+#include <ql/pricingengines/credit/isdacdsengine.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/termstructures/credit/interpolatedhazardratecurve.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/yield/discountcurve.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/math/interpolations/backwardflatinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
 #include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <iomanip>
 #include <iostream>
@@ -558,6 +561,104 @@ void CreditDefaultSwapTest::testFairUpfront() {
 }
 
 
+void CreditDefaultSwapTest::testIsdaEngine() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing closed-form engine for credit-default swaps...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(9,June,2006);
+    Date today = Settings::instance().evaluationDate();
+    Calendar calendar = TARGET();
+    DayCounter curveDayCounter = Actual365Fixed();
+
+    // curve nodes deliberately fall inside the coupon periods
+    std::vector<Date> hazardDates;
+    std::vector<Real> hazardRates;
+    hazardDates.push_back(today);
+    hazardRates.push_back(0.0);
+    Real rates[] = { 0.008, 0.012, 0.021, 0.018, 0.030 };
+    Integer months[] = { 7, 17, 29, 50, 110 };
+    for (Size i=0; i<LENGTH(rates); ++i) {
+        hazardDates.push_back(today + months[i]*Months + 11*Days);
+        hazardRates.push_back(rates[i]);
+    }
+    Handle<DefaultProbabilityTermStructure> probabilityCurve(
+        boost::shared_ptr<DefaultProbabilityTermStructure>(
+            new InterpolatedHazardRateCurve<BackwardFlat>(hazardDates,
+                                                          hazardRates,
+                                                          curveDayCounter)));
+
+    std::vector<Date> discountDates;
+    std::vector<DiscountFactor> discounts;
+    discountDates.push_back(today);
+    discounts.push_back(1.0);
+    Real forwards[] = { 0.035, 0.041, 0.038, 0.047 };
+    Integer weeks[] = { 20, 75, 190, 470 };
+    for (Size i=0; i<LENGTH(forwards); ++i) {
+        Date d = today + weeks[i]*Weeks;
+        Time dt = curveDayCounter.yearFraction(discountDates.back(), d);
+        discounts.push_back(discounts.back()*std::exp(-forwards[i]*dt));
+        discountDates.push_back(d);
+    }
+    Handle<YieldTermStructure> discountCurve(
+        boost::shared_ptr<YieldTermStructure>(
+            new InterpolatedDiscountCurve<LogLinear>(discountDates,
+                                                     discounts,
+                                                     curveDayCounter)));
+
+    Schedule schedule =
+        MakeSchedule().from(Date(20,March,2006))
+                      .to(Date(20,June,2014))
+                      .withFrequency(Quarterly)
+                      .withCalendar(calendar)
+                      .withConvention(Following)
+                      .withTerminationDateConvention(Unadjusted)
+                      .withRule(DateGeneration::TwentiethIMM);
+
+    Real recoveryRate = 0.4;
+    Real notional = 10000.0;
+    Rate fixedRate = 0.0125;
+
+    CreditDefaultSwap cds(Protection::Buyer, notional, fixedRate,
+                          schedule, Following, Actual365Fixed());
+
+    // the error of the integral engine is linear in the step, so
+    // that a Richardson extrapolation should give the exact results
+    cds.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new IntegralCdsEngine(2*Days, probabilityCurve,
+                                      recoveryRate, discountCurve)));
+    Real coarseCouponLeg = cds.couponLegNPV();
+    Real coarseDefaultLeg = cds.defaultLegNPV();
+    cds.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new IntegralCdsEngine(1*Days, probabilityCurve,
+                                      recoveryRate, discountCurve)));
+    Real integralCouponLeg = 2.0*cds.couponLegNPV() - coarseCouponLeg;
+    Real integralDefaultLeg = 2.0*cds.defaultLegNPV() - coarseDefaultLeg;
+
+    cds.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new IsdaCdsEngine(probabilityCurve, recoveryRate,
+                                  discountCurve)));
+    Real couponLeg = cds.couponLegNPV();
+    Real defaultLeg = cds.defaultLegNPV();
+
+    Real tolerance = 1.0e-6;
+    if (std::fabs(couponLeg/integralCouponLeg - 1.0) > tolerance)
+        BOOST_ERROR(
+            "Failed to reproduce coupon-leg NPV with integral engine\n"
+            << std::setprecision(10)
+            << "    calculated NPV:  " << couponLeg << "\n"
+            << "    integrated NPV:  " << integralCouponLeg);
+    if (std::fabs(defaultLeg/integralDefaultLeg - 1.0) > tolerance)
+        BOOST_ERROR(
+            "Failed to reproduce default-leg NPV with integral engine\n"
+            << std::setprecision(10)
+            << "    calculated NPV:  " << defaultLeg << "\n"
+            << "    integrated NPV:  " << integralDefaultLeg);
+}
+
+
 test_suite* CreditDefaultSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Credit-default swap tests");
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testCachedValue));
@@ -567,6 +668,7 @@ test_suite* CreditDefaultSwapTest::suite() {
                               &CreditDefaultSwapTest::testImpliedHazardRate));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testFairSpread));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testFairUpfront));
+    suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testIsdaEngine));
     return suite;
 }
 
@@ -32,6 +32,7 @@ class CreditDefaultSwapTest {
     static void testImpliedHazardRate();
     static void testFairSpread();
     static void testFairUpfront();
+    static void testIsdaEngine();
     static boost::unit_test_framework::test_suite* suite();
 };
 
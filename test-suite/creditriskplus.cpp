@@ -20,6 +20,7 @@
 #include "creditriskplus.hpp"
 #include "utilities.hpp"
 #include <ql/experimental/risk/creditriskplus.hpp>
+#include <ql/experimental/risk/fftcreditriskplus.hpp>
 #include <ql/math/comparison.hpp>
 
 using namespace QuantLib;
@@ -119,8 +120,108 @@ void CreditRiskPlusTest::testReferenceValues() {
                    << cr.lossQuantile(0.99) << ", should be 250)");
 }
 
+void CreditRiskPlusTest::testFFTLossDistribution() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing credit risk plus loss distribution by FFT...");
+
+    // exposures are multiples of the loss unit, so that the moments
+    // of the distribution are not affected by rounding
+    Size m = 300;
+    Real unit = 0.5;
+    std::vector<Real> exposure(m), pd(m);
+    for (Size k = 0; k < m; ++k) {
+        exposure[k] = 1.0 + (k % 7) * 0.5;
+        pd[k] = 0.005 + (k % 11) * 0.003;
+    }
+
+    // single sector: same distribution as the Panjer recursion
+
+    std::vector<Size> sector(m, 0);
+    std::vector<Real> relativeDefaultVariance(1, 0.8 * 0.8);
+    Matrix rho(1, 1, 1.0);
+
+    CreditRiskPlus recursion(exposure, pd, sector, relativeDefaultVariance,
+                             rho, unit);
+    FFTCreditRiskPlus fft(exposure, pd, sector, relativeDefaultVariance,
+                          unit);
+
+    const std::vector<Real>& expected = recursion.loss();
+    const std::vector<Real>& calculated = fft.loss();
+    for (Size n = 0; n < std::min(expected.size(), calculated.size()); ++n) {
+        if (std::fabs(calculated[n] - expected[n]) > 1.0E-12)
+            BOOST_FAIL("failed to reproduce loss probability #"
+                       << n << " (" << calculated[n] << ", should be "
+                       << expected[n] << ")");
+    }
+
+    // independent sectors and an idiosyncratic one: the moments of
+    // the distribution match the analytic ones
+
+    relativeDefaultVariance.clear();
+    relativeDefaultVariance.push_back(0.0);
+    relativeDefaultVariance.push_back(0.5 * 0.5);
+    relativeDefaultVariance.push_back(1.0);
+    relativeDefaultVariance.push_back(0.7 * 0.7);
+    for (Size k = 0; k < m; ++k)
+        sector[k] = k % relativeDefaultVariance.size();
+
+    FFTCreditRiskPlus cr(exposure, pd, sector, relativeDefaultVariance, unit);
+    Real mean = 0.0, secondMoment = 0.0;
+    for (Size n = 0; n < cr.loss().size(); ++n) {
+        Real loss = n * unit;
+        mean += loss * cr.loss()[n];
+        secondMoment += loss * loss * cr.loss()[n];
+    }
+    Real stdDev = std::sqrt(secondMoment - mean * mean);
+
+    Matrix identity(relativeDefaultVariance.size(),
+                    relativeDefaultVariance.size(), 0.0);
+    for (Size i = 0; i < identity.rows(); ++i)
+        identity[i][i] = 1.0;
+    CreditRiskPlus uncorrelated(exposure, pd, sector,
+                                relativeDefaultVariance, identity, unit);
+
+    static const Real tol = 1E-8;
+
+    if (std::fabs(mean - cr.expectedLoss()) > tol)
+        BOOST_FAIL("failed to reproduce expected loss ("
+                   << mean << ", should be " << cr.expectedLoss() << ")");
+
+    if (std::fabs(stdDev - cr.unexpectedLoss()) > tol ||
+        std::fabs(stdDev - uncorrelated.unexpectedLoss()) > tol)
+        BOOST_FAIL("failed to reproduce unexpected loss ("
+                   << stdDev << ", should be " << cr.unexpectedLoss()
+                   << ")");
+
+    // the contributions add up to the portfolio figures
+
+    Real p = 0.99;
+    std::vector<Real> quantileContributions =
+        cr.lossQuantileContributions(p);
+    std::vector<Real> shortfallContributions =
+        cr.expectedShortfallContributions(p);
+    Real quantileSum = 0.0, shortfallSum = 0.0;
+    for (Size k = 0; k < m; ++k) {
+        quantileSum += quantileContributions[k];
+        shortfallSum += shortfallContributions[k];
+    }
+
+    if (std::fabs(quantileSum - cr.lossQuantile(p)) > tol)
+        BOOST_FAIL("loss quantile contributions ("
+                   << quantileSum << ") don't add up to the loss quantile ("
+                   << cr.lossQuantile(p) << ")");
+
+    if (std::fabs(shortfallSum - cr.expectedShortfall(p)) > tol)
+        BOOST_FAIL("expected shortfall contributions ("
+                   << shortfallSum
+                   << ") don't add up to the expected shortfall ("
+                   << cr.expectedShortfall(p) << ")");
+}
+
 test_suite *CreditRiskPlusTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("Credit risk plus tests");
     suite->add(QUANTLIB_TEST_CASE(&CreditRiskPlusTest::testReferenceValues));
+    suite->add(QUANTLIB_TEST_CASE(&CreditRiskPlusTest::testFFTLossDistribution));
     return suite;
 }
@@ -28,6 +28,7 @@
 class CreditRiskPlusTest {
   public:
     static void testReferenceValues();
+    static void testFFTLossDistribution();
     static boost::unit_test_framework::test_suite *suite();
 };
 
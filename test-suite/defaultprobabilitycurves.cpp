@@ -23,15 +23,19 @@
 #include <ql/termstructures/credit/piecewisedefaultcurve.hpp>
 #include <ql/termstructures/credit/defaultprobabilityhelpers.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
+#include <ql/termstructures/credit/cdscurvebatchbuilder.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/discountcurve.hpp>
 #include <ql/instruments/creditdefaultswap.hpp>
 #include <ql/pricingengines/credit/midpointcdsengine.hpp>
+#include <ql/pricingengines/credit/isdacdsengine.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/interpolations/backwardflatinterpolation.hpp>
 #include <ql/math/interpolations/loginterpolation.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <iomanip>
@@ -387,6 +391,141 @@ void DefaultProbabilityCurveTest::testUpfrontBootstrap() {
 }
 
 
+void DefaultProbabilityCurveTest::testBatchBootstrap() {
+    BOOST_TEST_MESSAGE("Testing batch bootstrap of hazard-rate curves...");
+
+    SavedSettings backup;
+
+    Calendar calendar = TARGET();
+    Date today = calendar.adjust(Date(9,June,2016));
+    Settings::instance().evaluationDate() = today;
+
+    Integer settlementDays = 1;
+    Frequency frequency = Quarterly;
+    BusinessDayConvention convention = Following;
+    DateGeneration::Rule rule = DateGeneration::TwentiethIMM;
+    DayCounter dayCounter = Actual360();
+    DayCounter curveDayCounter = Actual365Fixed();
+
+    std::vector<Date> discountDates;
+    std::vector<DiscountFactor> discounts;
+    discountDates.push_back(today);
+    discounts.push_back(1.0);
+    Integer months[] = { 6, 12, 24, 60, 144 };
+    Rate zeroRates[] = { 0.010, 0.012, 0.015, 0.021, 0.028 };
+    for (Size i=0; i<LENGTH(months); ++i) {
+        Date d = today + months[i]*Months;
+        discountDates.push_back(d);
+        discounts.push_back(std::exp(-zeroRates[i]*
+                                     curveDayCounter.yearFraction(today, d)));
+    }
+    Handle<YieldTermStructure> discountCurve(
+        boost::shared_ptr<YieldTermStructure>(
+            new InterpolatedDiscountCurve<LogLinear>(discountDates,
+                                                     discounts,
+                                                     curveDayCounter)));
+
+    std::vector<Period> tenors;
+    tenors.push_back(1*Years);
+    tenors.push_back(2*Years);
+    tenors.push_back(3*Years);
+    tenors.push_back(5*Years);
+    tenors.push_back(7*Years);
+    tenors.push_back(10*Years);
+
+    CdsCurveBatchBuilder builder(tenors, settlementDays, calendar,
+                                 frequency, convention, rule, dayCounter,
+                                 discountCurve, curveDayCounter);
+
+    Size names = 40;
+    std::vector<std::vector<Rate> > spreads(names,
+                                            std::vector<Rate>(tenors.size()));
+    std::vector<Real> recoveryRates(names);
+    for (Size i=0; i<names; ++i) {
+        for (Size j=0; j<tenors.size(); ++j)
+            spreads[i][j] = 0.002*(1 + i%7) + 0.0008*j*(1 + i%3);
+        recoveryRates[i] = 0.25 + 0.01*(i%20);
+    }
+
+    std::vector<boost::shared_ptr<
+        InterpolatedHazardRateCurve<BackwardFlat> > > curves =
+        builder.curves(spreads, recoveryRates);
+
+    Date protectionStart = today + settlementDays;
+    Date startDate = calendar.adjust(protectionStart, convention);
+    Real tolerance = 1.0e-10;
+
+    for (Size i=0; i<names; ++i) {
+        Handle<DefaultProbabilityTermStructure> probability(curves[i]);
+        boost::shared_ptr<PricingEngine> engine(
+                      new IsdaCdsEngine(probability, recoveryRates[i],
+                                        discountCurve));
+        for (Size j=0; j<tenors.size(); ++j) {
+            Schedule schedule(startDate, today + tenors[j],
+                              Period(frequency), calendar,
+                              convention, Unadjusted, rule, false);
+            CreditDefaultSwap cds(Protection::Buyer, 1.0, spreads[i][j],
+                                  schedule, convention, dayCounter,
+                                  true, true, protectionStart);
+            cds.setPricingEngine(engine);
+
+            Rate computedRate = cds.fairSpread();
+            if (std::fabs(computedRate - spreads[i][j]) > tolerance)
+                BOOST_ERROR(
+                    "\nFailed to reproduce fair spread for "
+                    << io::ordinal(i+1) << " name, " << tenors[j]
+                    << " credit-default swap\n"
+                    << std::setprecision(10)
+                    << "    computed rate: " << io::rate(computedRate) << "\n"
+                    << "    input rate:    " << io::rate(spreads[i][j]));
+        }
+    }
+
+    // the single-name calculation gives the same results...
+    std::vector<Rate> hazardRates =
+        builder.hazardRates(spreads[names-1], recoveryRates[names-1]);
+    for (Size j=0; j<tenors.size(); ++j) {
+        if (hazardRates[j] != curves[names-1]->hazardRates()[j+1])
+            BOOST_ERROR(
+                "\nMismatch between single-name and batch hazard rates for "
+                << tenors[j] << " tenor\n"
+                << std::setprecision(12)
+                << "    single name: " << hazardRates[j] << "\n"
+                << "    batch:       " << curves[names-1]->hazardRates()[j+1]);
+    }
+
+    // ...and results close to those of the usual bootstrap, where
+    // swaps are priced by the mid-point engine
+    std::vector<boost::shared_ptr<DefaultProbabilityHelper> > helpers;
+    for (Size j=0; j<tenors.size(); ++j)
+        helpers.push_back(boost::shared_ptr<DefaultProbabilityHelper>(
+                    new SpreadCdsHelper(spreads[0][j], tenors[j],
+                                        settlementDays, calendar,
+                                        frequency, convention, rule,
+                                        dayCounter, recoveryRates[0],
+                                        discountCurve)));
+    PiecewiseDefaultCurve<HazardRate,BackwardFlat> piecewiseCurve(
+                                           today, helpers, curveDayCounter);
+
+    const std::vector<Date>& dates = builder.dates();
+    for (Size j=1; j<dates.size(); ++j) {
+        if (dates[j] != piecewiseCurve.dates()[j])
+            BOOST_FAIL("\nMismatch between curve nodes\n"
+                       << "    batch:     " << dates[j] << "\n"
+                       << "    piecewise: " << piecewiseCurve.dates()[j]);
+        Probability expected = piecewiseCurve.survivalProbability(dates[j]);
+        Probability calculated = curves[0]->survivalProbability(dates[j]);
+        if (std::fabs(calculated - expected) > 1.0e-5)
+            BOOST_ERROR(
+                "\nFailed to reproduce bootstrapped survival probability at "
+                << dates[j] << "\n"
+                << std::setprecision(10)
+                << "    batch:     " << calculated << "\n"
+                << "    piecewise: " << expected);
+    }
+}
+
+
 test_suite* DefaultProbabilityCurveTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Default-probability curve tests");
     suite->add(QUANTLIB_TEST_CASE(
@@ -405,5 +544,7 @@ test_suite* DefaultProbabilityCurveTest::suite() {
                 &DefaultProbabilityCurveTest::testSingleInstrumentBootstrap));
     suite->add(QUANTLIB_TEST_CASE(
                          &DefaultProbabilityCurveTest::testUpfrontBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &DefaultProbabilityCurveTest::testBatchBootstrap));
     return suite;
 }
@@ -623,7 +623,48 @@ void DistributionTest::testBivariateCumulativeStudentVsBivariate() {
                         "\n    average error: " << avgDiff);
     }
 }
-    
+
+void DistributionTest::testBulkInverseCumulativeNormal() {
+
+    BOOST_TEST_MESSAGE("Testing bulk inverse cumulative normal transforms...");
+
+    // include both tails and an odd number of values, so that the
+    // last block is incomplete
+    Size N = 1001;
+    std::vector<Real> x(N);
+    for (Size i=0; i<N; i++)
+        x[i] = (i+0.5)/N;
+    x[1] = 1.0e-10;
+    x[N-2] = 1.0 - 1.0e-10;
+
+    InverseCumulativeNormal acklam(average, sigma);
+    MoroInverseCumulativeNormal moro(average, sigma);
+
+    std::vector<Real> y1(N), y2(x);
+    acklam.transform(&x[0], &x[0]+N, &y1[0]);
+    // in place
+    acklam.transform(&y2[0], &y2[0]+N, &y2[0]);
+    for (Size i=0; i<N; i++) {
+        Real expected = acklam(x[i]);
+        if (y1[i] != expected || y2[i] != expected)
+            BOOST_ERROR("bulk inverse cumulative normal mismatch at "
+                        << x[i] << ":"
+                        << "\n    expected:        " << expected
+                        << "\n    calculated:      " << y1[i]
+                        << "\n    in place:        " << y2[i]);
+    }
+
+    moro.transform(&x[0], &x[0]+N, &y1[0]);
+    for (Size i=0; i<N; i++) {
+        Real expected = moro(x[i]);
+        if (std::fabs(y1[i] - expected) > 1.0e-14*std::fabs(expected))
+            BOOST_ERROR("bulk Moro inverse cumulative normal mismatch at "
+                        << x[i] << ":"
+                        << "\n    expected:        " << expected
+                        << "\n    calculated:      " << y1[i]);
+    }
+}
+
 test_suite* DistributionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Distribution tests");
     suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testNormal));
@@ -636,6 +677,8 @@ test_suite* DistributionTest::suite() {
                           &DistributionTest::testBivariateCumulativeStudent));
     suite->add(QUANTLIB_TEST_CASE(
                &DistributionTest::testBivariateCumulativeStudentVsBivariate));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &DistributionTest::testBulkInverseCumulativeNormal));
     return suite;
 }
 
@@ -35,6 +35,7 @@ class DistributionTest {
     static void testInverseCumulativePoisson();
     static void testBivariateCumulativeStudent();
     static void testBivariateCumulativeStudentVsBivariate();
+    static void testBulkInverseCumulativeNormal();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -26,6 +26,8 @@
 #include <ql/pricingengines/swaption/gaussian1dswaptionengine.hpp>
 #include <ql/pricingengines/swaption/gaussian1djamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swaption/gaussian1dnonstandardswaptionengine.hpp>
+#include <ql/pricingengines/swaption/gaussian1dfloatfloatswaptionengine.hpp>
+#include <ql/instruments/floatfloatswaption.hpp>
 #include <ql/indexes/swap/euriborswap.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/target.hpp>
@@ -285,9 +287,162 @@ void GsrTest::testGsrModel() {
                     << GsrJamNpv << ")");
 }
 
+void GsrTest::testGridCache() {
+
+    BOOST_TEST_MESSAGE("Testing GSR integration-grid cache...");
+
+    Date refDate = Settings::instance().evaluationDate();
+
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.01));
+    boost::shared_ptr<SimpleQuote> rev(new SimpleQuote(0.02));
+    std::vector<Date> stepDates;
+    std::vector<Handle<Quote> > vols(1, Handle<Quote>(vol));
+
+    Handle<YieldTermStructure> yts(boost::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.03, Actual365Fixed())));
+    RelinkableHandle<YieldTermStructure> discountCurve(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(0, TARGET(), 0.025, Actual365Fixed())));
+    boost::shared_ptr<Gsr> model(
+        new Gsr(yts, stepDates, vols, Handle<Quote>(rev), 50.0));
+
+    // cached grids must reproduce the pointwise values exactly
+
+    Array z = model->yGrid(7.0, 32);
+    const Array &zb = model->zerobondGrid(12.0, 3.0, 7.0, 32, discountCurve);
+    const Array &nm = model->numeraireGrid(3.0, 7.0, 32, discountCurve);
+    for (Size i = 0; i < z.size(); ++i) {
+        Real zb0 = model->zerobond(12.0, 3.0, z[i], discountCurve);
+        Real nm0 = model->numeraire(3.0, z[i], discountCurve);
+        if (zb[i] != zb0 || nm[i] != nm0)
+            BOOST_ERROR("cached values differ from direct calculation at y="
+                        << z[i] << ": zerobond " << zb[i] << " vs " << zb0
+                        << ", numeraire " << nm[i] << " vs " << nm0);
+    }
+
+    // bermudan swaption priced with the caches filled by previous
+    // calculations must agree with a fresh model after changes in
+    // the model parameters or in the discount curve
+
+    Date start = TARGET().advance(refDate, 2 * Years);
+    boost::shared_ptr<IborIndex> euribor(new Euribor6M(yts));
+    boost::shared_ptr<VanillaSwap> underlying =
+        MakeVanillaSwap(8 * Years, euribor, 0.03)
+            .withEffectiveDate(start)
+            .withFixedLegDayCount(Thirty360());
+    std::vector<Date> exerciseDates;
+    for (Size i = 0; i < underlying->fixedLeg().size() - 1; ++i)
+        exerciseDates.push_back(TARGET().advance(
+            underlying->fixedSchedule().dates()[i], -2 * Days));
+    boost::shared_ptr<Exercise> exercise(
+        new BermudanExercise(exerciseDates));
+    Swaption swaption(underlying, exercise);
+    swaption.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new Gaussian1dSwaptionEngine(model, 32, 7.0, true, false,
+                                     discountCurve)));
+
+    boost::shared_ptr<SwapIndex> swapIndex(
+        new EuriborSwapIsdaFixA(10 * Years, yts));
+    Schedule floatSchedule = underlying->floatingSchedule();
+    boost::shared_ptr<FloatFloatSwap> floatFloat(new FloatFloatSwap(
+        VanillaSwap::Payer, 1.0, 1.0, floatSchedule, euribor,
+        Actual360(), floatSchedule, swapIndex, Actual360(), false, false,
+        1.0, 0.0025, Null<Real>(), Null<Real>(), 1.0, 0.0, Null<Real>(),
+        0.01));
+    std::vector<Date> floatExerciseDates;
+    for (Size i = 1; i < floatSchedule.size() - 1; ++i)
+        floatExerciseDates.push_back(
+            TARGET().advance(floatSchedule.dates()[i], -2 * Days));
+    std::vector<Real> rebates(floatExerciseDates.size(), 0.001);
+    boost::shared_ptr<RebatedExercise> floatExercise(new RebatedExercise(
+        BermudanExercise(floatExerciseDates), rebates, 2, TARGET()));
+    FloatFloatSwaption floatFloatSwaption(floatFloat, floatExercise);
+    floatFloatSwaption.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new Gaussian1dFloatFloatSwaptionEngine(
+            model, 32, 7.0, true, false, Handle<Quote>(), discountCurve,
+            false, Gaussian1dFloatFloatSwaptionEngine::Digital)));
+
+    Real tol = 1.0E-12;
+    Real vols0[] = { 0.01, 0.015, 0.0075 };
+    Real rates0[] = { 0.025, 0.025, 0.035 };
+    for (Size k = 0; k < LENGTH(vols0); ++k) {
+        vol->setValue(vols0[k]);
+        discountCurve.linkTo(boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(0, TARGET(), rates0[k], Actual365Fixed())));
+        Real cached = swaption.NPV();
+
+        std::vector<Real> vols1(1, vols0[k]);
+        boost::shared_ptr<Gsr> fresh(
+            new Gsr(yts, stepDates, vols1, rev->value(), 50.0));
+        Swaption swaption1(underlying, exercise);
+        swaption1.setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new Gaussian1dSwaptionEngine(fresh, 32, 7.0, true, false,
+                                         Handle<YieldTermStructure>(
+                                             discountCurve.currentLink()))));
+        Real expected = swaption1.NPV();
+
+        if (fabs(cached - expected) > tol)
+            BOOST_ERROR("swaption price with cached grids ("
+                        << cached << ") differs from fresh model ("
+                        << expected << ") for vol " << vols0[k]
+                        << " and discount rate " << rates0[k]);
+
+        Real cachedFloat = floatFloatSwaption.NPV();
+        FloatFloatSwaption floatFloatSwaption1(floatFloat, floatExercise);
+        floatFloatSwaption1.setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new Gaussian1dFloatFloatSwaptionEngine(
+                fresh, 32, 7.0, true, false, Handle<Quote>(),
+                Handle<YieldTermStructure>(discountCurve.currentLink()),
+                false, Gaussian1dFloatFloatSwaptionEngine::Digital)));
+        Real expectedFloat = floatFloatSwaption1.NPV();
+        std::vector<Real> cachedProbabilities =
+            floatFloatSwaption.result<std::vector<Real> >("probabilities");
+        std::vector<Real> expectedProbabilities =
+            floatFloatSwaption1.result<std::vector<Real> >("probabilities");
+        Real probabilityError = 0.0;
+        for (Size i = 0; i < cachedProbabilities.size(); ++i)
+            probabilityError =
+                std::max(probabilityError,
+                         fabs(cachedProbabilities[i] -
+                              expectedProbabilities[i]));
+
+        if (fabs(cachedFloat - expectedFloat) > tol ||
+            probabilityError > tol)
+            BOOST_ERROR("float float swaption with cached grids ("
+                        << cachedFloat << ") differs from fresh model ("
+                        << expectedFloat << ", probability error "
+                        << probabilityError << ") for vol " << vols0[k]
+                        << " and discount rate " << rates0[k]);
+    }
+
+    // changes of an external discount curve must flush the grid
+    // caches without triggering a recalculation of the model
+
+    boost::shared_ptr<SimpleQuote> externalRate(new SimpleQuote(0.025));
+    Handle<YieldTermStructure> externalCurve(
+        boost::shared_ptr<YieldTermStructure>(new FlatForward(
+            0, TARGET(), Handle<Quote>(externalRate), Actual365Fixed())));
+    model->zerobondGrid(12.0, 3.0, 7.0, 32, externalCurve);
+    Flag modelChanged;
+    modelChanged.registerWith(model);
+    externalRate->setValue(0.03);
+    if (modelChanged.isUp())
+        BOOST_ERROR("model notified of a change in the external curve");
+    const Array &zb1 =
+        model->zerobondGrid(12.0, 3.0, 7.0, 32, externalCurve);
+    for (Size i = 0; i < z.size(); ++i) {
+        Real zb0 = model->zerobond(12.0, 3.0, z[i], externalCurve);
+        if (fabs(zb1[i] - zb0) > tol)
+            BOOST_ERROR("cached zerobond not updated after change of the "
+                        "external curve at y="
+                        << z[i] << ": " << zb1[i] << " vs " << zb0);
+    }
+}
+
 test_suite *GsrTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("GSR model tests");
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrProcess));
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrModel));
+    suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGridCache));
     return suite;
 }
@@ -34,6 +34,7 @@
 #include <ql/math/integrals/twodimensionalintegral.hpp>
 #include <ql/experimental/math/piecewisefunction.hpp>
 #include <ql/experimental/math/piecewiseintegral.hpp>
+#include <ql/experimental/math/gaussianquadgridintegrator.hpp>
 
 #include <boost/make_shared.hpp>
 #include <boost/lambda/lambda.hpp>
@@ -309,6 +310,71 @@ void IntegralTest::testPiecewiseIntegral() {
     pw_check(*piecewise, 9.0, 10.0, 6.0);
 }
 
+namespace {
+
+    // x_1^0 x_2^2 x_3^4 times the Hermite weight
+    Real hermiteMonomial(const std::vector<Real>& x) {
+        Real result = 1.0;
+        for (Size i=0; i<x.size(); ++i)
+            result *= std::pow(x[i], Real(2*(i%3))) * std::exp(-x[i]*x[i]);
+        return result;
+    }
+
+    Disposable<std::vector<Real> > hermiteMonomials(
+                                   const std::vector<std::vector<Real> >& x) {
+        std::vector<Real> result(x.size());
+        for (Size i=0; i<x.size(); ++i)
+            result[i] = hermiteMonomial(x[i]);
+        return result;
+    }
+
+}
+
+void IntegralTest::testGaussianQuadratureGrids() {
+    BOOST_TEST_MESSAGE("Testing tabulated multidimensional "
+                       "Gauss-Hermite grids...");
+
+    // integrals over R of x^0, x^2 and x^4 times exp(-x^2)
+    const Real moments[] = { std::sqrt(M_PI),
+                             0.5*std::sqrt(M_PI),
+                             0.75*std::sqrt(M_PI) };
+    const GaussianQuadGridIntegrator::Grid grids[] = {
+        GaussianQuadGridIntegrator::TensorProduct,
+        GaussianQuadGridIntegrator::Smolyak
+    };
+    const char* gridNames[] = { "tensor-product", "sparse" };
+
+    const Real tol = 1.0e-12;
+    for (Size dimension=1; dimension<=3; ++dimension) {
+        Real expected = 1.0;
+        for (Size i=0; i<dimension; ++i)
+            expected *= moments[i%3];
+        // the polynomial has total degree 6 at most; both grids
+        // integrate it exactly.
+        for (Size j=0; j<LENGTH(grids); ++j) {
+            GaussianQuadGridIntegrator integrator(dimension, 9, grids[j], 7);
+            Real calculated = integrator(hermiteMonomial);
+            Real onBlocks = integrator.integrateBlocks(hermiteMonomials);
+            if (std::fabs(calculated-expected) > tol*expected
+                || std::fabs(onBlocks-expected) > tol*expected)
+                BOOST_FAIL(std::setprecision(16)
+                    << gridNames[j] << " grid integration failed: "
+                    << "\n    dimension:  " << dimension
+                    << "\n    nodes:      " << integrator.size()
+                    << "\n    calculated: " << calculated
+                    << "\n    on blocks:  " << onBlocks
+                    << "\n    expected:   " << expected);
+        }
+    }
+
+    // the sparse grid needs fewer nodes in higher dimension
+    GaussianQuadGridIntegrator tensor(3, 9), sparse(3, 9,
+                                          GaussianQuadGridIntegrator::Smolyak);
+    if (sparse.size() >= tensor.size())
+        BOOST_FAIL("sparse grid has " << sparse.size()
+                   << " nodes, tensor grid " << tensor.size());
+}
+
 test_suite* IntegralTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Integration tests");
     suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testSegment));
@@ -322,6 +388,7 @@ test_suite* IntegralTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testFolinIntegration));
     suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testDiscreteIntegrals));
     suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testPiecewiseIntegral));
+    suite->add(QUANTLIB_TEST_CASE(&IntegralTest::testGaussianQuadratureGrids));
     return suite;
 }
 
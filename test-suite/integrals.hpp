@@ -38,6 +38,7 @@ class IntegralTest {
     static void testFolinIntegration();
     static void testDiscreteIntegrals();
     static void testPiecewiseIntegral();
+    static void testGaussianQuadratureGrids();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -30,6 +30,9 @@
 #include <ql/math/randomnumbers/randomizedlds.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/sobolbrownianbridgersg.hpp>
+#include <ql/math/randomnumbers/inversecumulativersg.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <boost/progress.hpp>
 #include <ql/math/randomnumbers/latticerules.hpp>
@@ -1093,6 +1096,71 @@ void LowDiscrepancyTest::testSobolSkipping() {
     }
 }
 
+namespace {
+
+    template <class RSG>
+    void testBlocks(const RSG& rsg, const std::string& name) {
+        Size skip[] = { 0, 1, 42, 1000 };
+        Size samples = 37;
+        for (Size k=0; k<LENGTH(skip); k++) {
+            // draw the samples one by one...
+            RSG rsg1(rsg);
+            for (Size l=0; l<skip[k]; l++)
+                rsg1.nextSequence();
+            std::vector<Real> expected;
+            for (Size l=0; l<samples; l++) {
+                const std::vector<Real>& v = rsg1.nextSequence().value;
+                expected.insert(expected.end(), v.begin(), v.end());
+            }
+
+            // ...and as a block after skipping
+            RSG rsg2(rsg);
+            rsg2.skipTo(skip[k]);
+            std::vector<Real> block;
+            rsg2.nextSequences(samples, block);
+
+            if (block.size() != expected.size())
+                BOOST_FAIL(name << ": block size mismatch"
+                           << "\n  expected: " << expected.size()
+                           << "\n  found:    " << block.size());
+            for (Size n=0; n<block.size(); n++) {
+                if (block[n] != expected[n]) {
+                    BOOST_ERROR(name << ": mismatch in block generation"
+                                << "\n  skipped:  " << skip[k]
+                                << "\n  at index: " << n
+                                << "\n  expected: " << expected[n]
+                                << "\n  found:    " << block[n]);
+                    break;
+                }
+            }
+            const std::vector<Real>& last = rsg2.lastSequence().value;
+            if (!std::equal(last.begin(), last.end(),
+                            block.end()-last.size()))
+                BOOST_ERROR(name << ": last sequence does not match "
+                            "the end of the block");
+        }
+    }
+
+}
+
+void LowDiscrepancyTest::testBlockGenerationAndSkipping() {
+
+    BOOST_TEST_MESSAGE("Testing block generation and skipping "
+                       "of low-discrepancy sequences...");
+
+    unsigned long seed = 42;
+    Size dimensionality[] = { 1, 10, 100 };
+
+    for (Size j=0; j<LENGTH(dimensionality); j++) {
+        testBlocks(SobolRsg(dimensionality[j], seed), "Sobol");
+        testBlocks(HaltonRsg(dimensionality[j], seed), "Halton");
+        testBlocks(InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal>(
+                                           SobolRsg(dimensionality[j], seed)),
+                   "inverse-cumulative Sobol");
+    }
+    testBlocks(SobolBrownianBridgeRsg(3, 12), "Sobol Brownian bridge");
+}
+
 
 test_suite* LowDiscrepancyTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Low-discrepancy sequence tests");
@@ -1131,6 +1199,8 @@ test_suite* LowDiscrepancyTest::suite() {
            &LowDiscrepancyTest::testSobolLevitanLemieuxSobolDiscrepancy));
 
     suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testSobolSkipping));
+    suite->add(QUANTLIB_TEST_CASE(
+           &LowDiscrepancyTest::testBlockGenerationAndSkipping));
 
     suite->add(QUANTLIB_TEST_CASE(
            &LowDiscrepancyTest::testRandomizedLowDiscrepancySequence));
@@ -48,6 +48,7 @@ class LowDiscrepancyTest {
     static void testRandomizedLowDiscrepancySequence();
 
     static void testSobolSkipping();
+    static void testBlockGenerationAndSkipping();
 
     static void testRandomizedLattices();
 
@@ -26,6 +26,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include "utilities.hpp"
 #include <ql/models/marketmodels/accountingengine.hpp>
 #include <ql/models/marketmodels/browniangenerators/mtbrowniangenerator.hpp>
+#include <ql/models/marketmodels/browniangenerators/philoxbrowniangenerator.hpp>
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <ql/models/marketmodels/callability/collectnodedata.hpp>
 #include <ql/models/marketmodels/callability/lsstrategy.hpp>
@@ -42,6 +43,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateblockpc.hpp>
 #include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/models/abcdvol.hpp>
@@ -897,6 +899,507 @@ void MarketModelTest::testOneStepNormalForwardsAndOptionlets() {
         }
 }
 
+void MarketModelTest::testParallelAccountingEngine() {
+
+    BOOST_TEST_MESSAGE("Testing parallel accounting engine "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    std::vector<boost::shared_ptr<Payoff> >
+        optionletPayoffs(todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i) {
+        optionletPayoffs[i] = boost::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+    }
+    OneStepOptionlets product(rateTimes, accruals,
+                              paymentTimes, optionletPayoffs);
+
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> numeraires = makeMeasure(product, Terminal);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, todaysForwards.size(),
+                        ExponentialCorrelationFlatVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    const Size paths = 4000;
+
+    // the Mersenne twister can't skip paths, Philox can
+    std::vector<boost::shared_ptr<BrownianGeneratorFactory> > factories;
+    factories.push_back(boost::shared_ptr<BrownianGeneratorFactory>(
+                                    new MTBrownianGeneratorFactory(seed_)));
+    factories.push_back(boost::shared_ptr<BrownianGeneratorFactory>(
+                                new PhiloxBrownianGeneratorFactory(seed_)));
+
+    for (Size f=0; f<factories.size(); ++f) {
+        const BrownianGeneratorFactory& generatorFactory = *factories[f];
+        AccountingEngine engine(makeMarketModelEvolver(marketModel,
+                                                       numeraires,
+                                                       generatorFactory,
+                                                       Pc),
+                                product, initialNumeraireValue);
+        SequenceStatisticsInc expected(product.numberOfProducts());
+        engine.multiplePathValues(expected, paths);
+
+        Size workers[] = { 1, 3 };
+        std::vector<SequenceStatisticsInc> calculated;
+        for (Size k=0; k<LENGTH(workers); ++k) {
+            std::vector<boost::shared_ptr<MarketModelEvolver> > evolvers;
+            for (Size i=0; i<workers[k]; ++i)
+                evolvers.push_back(makeMarketModelEvolver(marketModel,
+                                                          numeraires,
+                                                          generatorFactory,
+                                                          Pc));
+            ParallelAccountingEngine parallelEngine(evolvers, product,
+                                                    initialNumeraireValue,
+                                                    256);
+            // two runs, to check that the second one continues the first
+            calculated.push_back(
+                        SequenceStatisticsInc(product.numberOfProducts()));
+            parallelEngine.multiplePathValues(calculated.back(), 1500);
+            parallelEngine.multiplePathValues(calculated.back(), paths-1500);
+        }
+
+        const Real tolerance = 1.0e-12;
+        std::vector<Real> expectedMean = expected.mean();
+        Matrix expectedCovariance = expected.covariance();
+        for (Size k=0; k<calculated.size(); ++k) {
+            if (calculated[k].samples() != paths)
+                BOOST_ERROR("wrong number of samples with " << workers[k]
+                            << " workers: " << calculated[k].samples()
+                            << " instead of " << paths);
+            std::vector<Real> mean = calculated[k].mean();
+            Matrix covariance = calculated[k].covariance();
+            for (Size i=0; i<mean.size(); ++i) {
+                if (std::fabs(mean[i]-expectedMean[i]) > tolerance
+                    || std::fabs(covariance[i][i]
+                                 -expectedCovariance[i][i]) > tolerance)
+                    BOOST_ERROR("failed to reproduce serial results with "
+                                << workers[k] << " workers for "
+                                << io::ordinal(i+1) << " optionlet:"
+                                << "\n    serial mean:       "
+                                << expectedMean[i]
+                                << "\n    parallel mean:     " << mean[i]
+                                << "\n    serial variance:   "
+                                << expectedCovariance[i][i]
+                                << "\n    parallel variance: "
+                                << covariance[i][i]);
+            }
+            // results must not depend on the number of workers
+            if (k > 0 && mean != calculated[0].mean())
+                BOOST_ERROR("results with " << workers[k] << " and "
+                            << workers[0] << " workers differ");
+        }
+    }
+}
+
+void MarketModelTest::testBlockEvolver() {
+
+    BOOST_TEST_MESSAGE("Testing predictor-corrector evolver "
+                       "working on blocks of paths...");
+
+    setup();
+
+    std::vector<Time> evolutionTimes(rateTimes.size()-1);
+    std::copy(rateTimes.begin(), rateTimes.end()-1, evolutionTimes.begin());
+    EvolutionDescription evolution(rateTimes, evolutionTimes);
+    std::vector<Size> numeraires = moneyMarketMeasure(evolution);
+
+    Size testedFactors[] = { 3, todaysForwards.size() };
+    for (Size m=0; m<LENGTH(testedFactors); ++m) {
+        Size factors = testedFactors[m];
+        boost::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(true, evolution, factors,
+                            ExponentialCorrelationAbcdVolatility);
+
+        MTBrownianGeneratorFactory generatorFactory(seed_);
+        LogNormalFwdRatePc evolver(marketModel, generatorFactory,
+                                   numeraires);
+        // the block size is chosen so that the last block is
+        // not exhausted
+        LogNormalFwdRateBlockPc blockEvolver(marketModel, generatorFactory,
+                                             numeraires, 0, 16);
+
+        const Size paths = 40;
+        const Real tolerance = 1.0e-14;
+        for (Size k=0; k<paths; ++k) {
+            Real weight = evolver.startNewPath();
+            Real blockWeight = blockEvolver.startNewPath();
+            if (weight != blockWeight)
+                BOOST_ERROR("path weights differ for "
+                            << io::ordinal(k+1) << " path");
+            for (Size j=0; j<evolutionTimes.size(); ++j) {
+                evolver.advanceStep();
+                blockEvolver.advanceStep();
+                const std::vector<Rate>& forwards =
+                    evolver.currentState().forwardRates();
+                const std::vector<Rate>& blockForwards =
+                    blockEvolver.currentState().forwardRates();
+                for (Size i=evolution.firstAliveRate()[j];
+                     i<forwards.size(); ++i) {
+                    if (std::fabs(blockForwards[i]-forwards[i]) > tolerance)
+                        BOOST_FAIL("failed to reproduce "
+                                   "path-by-path evolution with "
+                                   << factors << " factors:"
+                                   << "\n    path:       " << k+1
+                                   << "\n    step:       " << j+1
+                                   << "\n    rate:       " << i+1
+                                   << "\n    expected:   " << forwards[i]
+                                   << "\n    calculated: "
+                                   << blockForwards[i]);
+                }
+            }
+        }
+    }
+}
+
+void MarketModelTest::testSkipPaths() {
+
+    BOOST_TEST_MESSAGE("Testing skipping paths in "
+                       "market-model evolvers...");
+
+    setup();
+
+    std::vector<Time> evolutionTimes(rateTimes.size()-1);
+    std::copy(rateTimes.begin(), rateTimes.end()-1, evolutionTimes.begin());
+    EvolutionDescription evolution(rateTimes, evolutionTimes);
+    std::vector<Size> numeraires = moneyMarketMeasure(evolution);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationAbcdVolatility);
+
+    std::vector<boost::shared_ptr<BrownianGeneratorFactory> > factories;
+    factories.push_back(boost::shared_ptr<BrownianGeneratorFactory>(
+                                    new MTBrownianGeneratorFactory(seed_)));
+    factories.push_back(boost::shared_ptr<BrownianGeneratorFactory>(
+                                new PhiloxBrownianGeneratorFactory(seed_)));
+    factories.push_back(boost::shared_ptr<BrownianGeneratorFactory>(new
+        SobolBrownianGeneratorFactory(SobolBrownianGenerator::Diagonal,
+                                      seed_)));
+
+    // paths to skip before each pair of simulated paths
+    Size skips[] = { 0, 3, 1, 0, 16, 21, 2, 40 };
+    Size paths = 0;
+    for (Size i=0; i<LENGTH(skips); ++i)
+        paths += skips[i] + 2;
+
+    const Real tolerance = 1.0e-14;
+    for (Size f=0; f<factories.size(); ++f) {
+        // reference paths, drawn one after the other
+        LogNormalFwdRatePc evolver(marketModel, *factories[f], numeraires);
+        std::vector<std::vector<std::vector<Rate> > > expected(paths);
+        for (Size k=0; k<paths; ++k) {
+            evolver.startNewPath();
+            for (Size j=0; j<evolutionTimes.size(); ++j) {
+                evolver.advanceStep();
+                expected[k].push_back(evolver.currentState().forwardRates());
+            }
+        }
+
+        std::vector<boost::shared_ptr<MarketModelEvolver> > testees;
+        testees.push_back(boost::shared_ptr<MarketModelEvolver>(
+            new LogNormalFwdRatePc(marketModel, *factories[f], numeraires)));
+        testees.push_back(boost::shared_ptr<MarketModelEvolver>(
+            new LogNormalFwdRateBlockPc(marketModel, *factories[f],
+                                        numeraires, 0, 16)));
+
+        for (Size t=0; t<testees.size(); ++t) {
+            Size k = 0;
+            for (Size i=0; i<LENGTH(skips); ++i) {
+                testees[t]->skipPaths(skips[i]);
+                k += skips[i];
+                for (Size l=0; l<2; ++l, ++k) {
+                    testees[t]->startNewPath();
+                    for (Size j=0; j<evolutionTimes.size(); ++j) {
+                        testees[t]->advanceStep();
+                        const std::vector<Rate>& forwards =
+                            testees[t]->currentState().forwardRates();
+                        for (Size r=evolution.firstAliveRate()[j];
+                             r<forwards.size(); ++r) {
+                            if (std::fabs(forwards[r]-expected[k][j][r])
+                                                               > tolerance)
+                                BOOST_FAIL("failed to reproduce "
+                                           "sequential evolution:"
+                                           << "\n    generator:  "
+                                           << io::ordinal(f+1)
+                                           << "\n    evolver:    "
+                                           << io::ordinal(t+1)
+                                           << "\n    path:       " << k+1
+                                           << "\n    step:       " << j+1
+                                           << "\n    rate:       " << r+1
+                                           << "\n    expected:   "
+                                           << expected[k][j][r]
+                                           << "\n    calculated: "
+                                           << forwards[r]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void MarketModelTest::testParallelPathwiseEngines() {
+
+    BOOST_TEST_MESSAGE("Testing parallel pathwise engines "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    std::vector<boost::shared_ptr<Payoff> > payoffs(todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i)
+        payoffs[i] = boost::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+    MultiStepOptionlets productDummy(rateTimes, accruals,
+                                     paymentTimes, payoffs);
+    MarketModelPathwiseMultiDeflatedCaplet caplets(rateTimes, accruals,
+                                                   paymentTimes,
+                                                   todaysForwards);
+
+    EvolutionDescription evolution = caplets.evolution();
+    std::vector<Size> numeraires = makeMeasure(productDummy, MoneyMarket);
+    Size factors = 3;
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, factors,
+                        ExponentialCorrelationAbcdVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+    Size numberRates = evolution.numberOfRates();
+
+    // a parallel bump of all pseudo-root elements and a bump of
+    // the diagonal ones
+    std::vector<std::vector<Matrix> > vegaBumps(evolution.numberOfSteps());
+    for (Size t=0; t<vegaBumps.size(); ++t) {
+        Matrix all(numberRates, factors, 0.0);
+        Matrix diagonal(numberRates, factors, 0.0);
+        for (Size r=evolution.firstAliveRate()[t]; r<numberRates; ++r) {
+            for (Size f=0; f<factors; ++f)
+                all[r][f] = 0.01;
+            diagonal[r][0] = 0.01;
+        }
+        vegaBumps[t].push_back(all);
+        vegaBumps[t].push_back(diagonal);
+    }
+
+    const Size paths = 3000;
+    PhiloxBrownianGeneratorFactory generatorFactory(seed_);
+
+    SequenceStatisticsInc expected(
+                        caplets.numberOfProducts()*(numberRates+1));
+    PathwiseAccountingEngine engine(
+        boost::shared_ptr<LogNormalFwdRateEuler>(new
+            LogNormalFwdRateEuler(marketModel, generatorFactory,
+                                  numeraires)),
+        caplets, marketModel, initialNumeraireValue);
+    engine.multiplePathValues(expected, paths);
+
+    std::vector<Real> expectedVegas, expectedErrors;
+    PathwiseVegasOuterAccountingEngine vegasEngine(
+        boost::shared_ptr<LogNormalFwdRateEuler>(new
+            LogNormalFwdRateEuler(marketModel, generatorFactory,
+                                  numeraires)),
+        caplets, marketModel, vegaBumps, initialNumeraireValue);
+    vegasEngine.multiplePathValues(expectedVegas, expectedErrors, paths);
+
+    const Real tolerance = 1.0e-12;
+    Size workers[] = { 1, 3 };
+    for (Size k=0; k<LENGTH(workers); ++k) {
+        std::vector<boost::shared_ptr<LogNormalFwdRateEuler> > evolvers,
+                                                               vegaEvolvers;
+        for (Size i=0; i<workers[k]; ++i) {
+            evolvers.push_back(boost::shared_ptr<LogNormalFwdRateEuler>(new
+                LogNormalFwdRateEuler(marketModel, generatorFactory,
+                                      numeraires)));
+            vegaEvolvers.push_back(boost::shared_ptr<LogNormalFwdRateEuler>(
+                new LogNormalFwdRateEuler(marketModel, generatorFactory,
+                                          numeraires)));
+        }
+
+        ParallelPathwiseAccountingEngine parallelEngine(
+                   evolvers, caplets, marketModel, initialNumeraireValue, 256);
+        SequenceStatisticsInc calculated(expected.size());
+        parallelEngine.multiplePathValues(calculated, paths);
+
+        std::vector<Real> expectedMean = expected.mean();
+        std::vector<Real> mean = calculated.mean();
+        for (Size i=0; i<mean.size(); ++i) {
+            if (std::fabs(mean[i]-expectedMean[i]) > tolerance)
+                BOOST_ERROR("failed to reproduce serial deltas with "
+                            << workers[k] << " workers for "
+                            << io::ordinal(i+1) << " value:"
+                            << "\n    serial:   " << expectedMean[i]
+                            << "\n    parallel: " << mean[i]);
+        }
+
+        ParallelPathwiseVegasOuterAccountingEngine parallelVegasEngine(
+                                vegaEvolvers, caplets, marketModel, vegaBumps,
+                                initialNumeraireValue, 256);
+        std::vector<Real> vegas, errors;
+        parallelVegasEngine.multiplePathValues(vegas, errors, paths);
+
+        if (vegas.size() != expectedVegas.size())
+            BOOST_FAIL("wrong number of values with " << workers[k]
+                       << " workers: " << vegas.size()
+                       << " instead of " << expectedVegas.size());
+        for (Size i=0; i<vegas.size(); ++i) {
+            if (std::fabs(vegas[i]-expectedVegas[i]) > tolerance
+                || std::fabs(errors[i]-expectedErrors[i]) > tolerance)
+                BOOST_ERROR("failed to reproduce serial vegas with "
+                            << workers[k] << " workers for "
+                            << io::ordinal(i+1) << " value:"
+                            << "\n    serial:          " << expectedVegas[i]
+                            << "\n    parallel:        " << vegas[i]
+                            << "\n    serial error:    "
+                            << expectedErrors[i]
+                            << "\n    parallel error:  " << errors[i]);
+        }
+    }
+}
+
+void MarketModelTest::testParallelUpperBound() {
+
+    BOOST_TEST_MESSAGE("Testing parallel inner simulations "
+                       "in upper-bound engine...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+                               fixedRate, false);
+    std::vector<Time> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    SwapRateTrigger strategy(rateTimes,
+                             std::vector<Rate>(exerciseTimes.size(),
+                                               fixedRate),
+                             exerciseTimes);
+    NothingExerciseValue nullRebate(rateTimes);
+
+    EvolutionDescription evolution = receiverSwap.evolution();
+    std::vector<Size> numeraires = makeMeasure(receiverSwap, Terminal);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, todaysForwards.size(),
+                        ExponentialCorrelationFlatVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+    std::valarray<bool> isExerciseTime =
+        isInSubset(evolution.evolutionTimes(), strategy.exerciseTimes());
+
+    const Size outerPaths = 10, innerPaths = 128;
+
+    // the inner evolvers of the workers reach their paths by
+    // drawing the ones in between (Mersenne twister) or by
+    // skipping them (Philox)
+    std::vector<boost::shared_ptr<BrownianGeneratorFactory> > factories;
+    std::vector<boost::shared_ptr<BrownianGeneratorFactory> >
+        philoxFactories;
+    for (Size s=0; s<isExerciseTime.size(); ++s) {
+        factories.push_back(boost::shared_ptr<BrownianGeneratorFactory>(
+                                  new MTBrownianGeneratorFactory(seed_+s)));
+        philoxFactories.push_back(boost::shared_ptr<BrownianGeneratorFactory>(
+                              new PhiloxBrownianGeneratorFactory(seed_+s)));
+    }
+
+    const Real tolerance = 1.0e-12;
+    Real serialValue = Null<Real>();
+    for (Size g=0; g<2; ++g) {
+        const std::vector<boost::shared_ptr<BrownianGeneratorFactory> >&
+            innerFactories = (g == 0 ? factories : philoxFactories);
+        // workers == 0 stands for the serial engine
+        Size workers[] = { 0, 1, 3 };
+        std::vector<Real> calculated;
+        for (Size k=0; k<LENGTH(workers); ++k) {
+            MTBrownianGeneratorFactory outerFactory(seed_);
+            boost::shared_ptr<MarketModelEvolver> evolver =
+                makeMarketModelEvolver(marketModel, numeraires,
+                                       outerFactory, Pc);
+            std::vector<std::vector<boost::shared_ptr<MarketModelEvolver> > >
+                innerEvolvers;
+            for (Size s=0; s<isExerciseTime.size(); ++s) {
+                if (isExerciseTime[s]) {
+                    innerEvolvers.push_back(
+                        std::vector<boost::shared_ptr<MarketModelEvolver> >());
+                    for (Size i=0; i<std::max<Size>(workers[k],1); ++i)
+                        innerEvolvers.back().push_back(
+                            makeMarketModelEvolver(marketModel, numeraires,
+                                                   *innerFactories[s],
+                                                   Pc, s));
+                }
+            }
+            Statistics stats;
+            if (workers[k] == 0) {
+                std::vector<boost::shared_ptr<MarketModelEvolver> >
+                    serialEvolvers;
+                for (Size s=0; s<innerEvolvers.size(); ++s)
+                    serialEvolvers.push_back(innerEvolvers[s].front());
+                UpperBoundEngine engine(evolver, serialEvolvers,
+                                        receiverSwap, nullRebate,
+                                        receiverSwap, nullRebate,
+                                        strategy, initialNumeraireValue);
+                engine.multiplePathValues(stats, outerPaths, innerPaths);
+            } else {
+                UpperBoundEngine engine(evolver, innerEvolvers,
+                                        receiverSwap, nullRebate,
+                                        receiverSwap, nullRebate,
+                                        strategy, initialNumeraireValue,
+                                        16);
+                engine.multiplePathValues(stats, outerPaths, innerPaths);
+            }
+            calculated.push_back(stats.mean());
+        }
+
+        for (Size k=1; k<calculated.size(); ++k) {
+            if (std::fabs(calculated[k]-calculated[0]) > tolerance)
+                BOOST_ERROR("failed to reproduce serial upper bound with "
+                            << workers[k] << " workers and "
+                            << (g == 0 ? "Mersenne-twister" : "Philox")
+                            << " inner generators:"
+                            << "\n    serial:     " << calculated[0]
+                            << "\n    parallel:   " << calculated[k]);
+        }
+        if (g == 0)
+            serialValue = calculated[0];
+    }
+
+    // adaptive number of inner paths
+    Real innerTolerances[] = { 1.0, 1.0e-4 };
+    Size maxInnerPaths = 4*innerPaths;
+    for (Size k=0; k<LENGTH(innerTolerances); ++k) {
+        MTBrownianGeneratorFactory outerFactory(seed_);
+        boost::shared_ptr<MarketModelEvolver> evolver =
+            makeMarketModelEvolver(marketModel, numeraires,
+                                   outerFactory, Pc);
+        std::vector<boost::shared_ptr<MarketModelEvolver> > innerEvolvers;
+        for (Size s=0; s<isExerciseTime.size(); ++s) {
+            if (isExerciseTime[s]) {
+                MTBrownianGeneratorFactory innerFactory(seed_+s);
+                innerEvolvers.push_back(
+                    makeMarketModelEvolver(marketModel, numeraires,
+                                           innerFactory, Pc, s));
+            }
+        }
+        UpperBoundEngine engine(evolver, innerEvolvers,
+                                receiverSwap, nullRebate,
+                                receiverSwap, nullRebate,
+                                strategy, initialNumeraireValue);
+        Statistics stats;
+        engine.multiplePathValues(stats, outerPaths, innerPaths,
+                                  innerTolerances[k], maxInnerPaths);
+        if (k == 0) {
+            // a loose tolerance is met by the initial inner paths
+            if (std::fabs(stats.mean()-serialValue) > tolerance)
+                BOOST_ERROR("failed to reproduce fixed-path upper bound "
+                            "with loose inner tolerance:"
+                            << "\n    fixed:      " << serialValue
+                            << "\n    adaptive:   " << stats.mean());
+        } else {
+            Real error = stats.errorEstimate();
+            if (std::fabs(stats.mean()-serialValue) > 3.0*error)
+                BOOST_ERROR("adaptive upper bound out of range:"
+                            << "\n    fixed:      " << serialValue
+                            << "\n    adaptive:   " << stats.mean()
+                            << "\n    error:      " << error);
+        }
+    }
+}
+
 void MarketModelTest::testInverseFloater() 
 {
 
@@ -4886,6 +5389,11 @@ test_suite* MarketModelTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testOneStepForwardsAndOptionlets));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testOneStepNormalForwardsAndOptionlets));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelAccountingEngine));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testSkipPaths));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelPathwiseEngines));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testBlockEvolver));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelUpperBound));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCallableSwapNaif));
 
@@ -38,6 +38,11 @@ class MarketModelTest {
     static void testAllMultiStepProducts();
     static void testOneStepForwardsAndOptionlets();
     static void testOneStepNormalForwardsAndOptionlets();
+    static void testParallelAccountingEngine();
+    static void testSkipPaths();
+    static void testParallelPathwiseEngines();
+    static void testBlockEvolver();
+    static void testParallelUpperBound();
     static void testCallableSwapNaif();
     static void testCallableSwapLS();
     static void testCallableSwapAnderson(
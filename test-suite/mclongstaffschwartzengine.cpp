@@ -65,7 +65,8 @@ namespace {
         const boost::shared_ptr<Payoff> payoff_;
     };
 
-    template <class RNG>
+    template <class RNG,
+              class LsmPricer = LongstaffSchwartzPathPricer<MultiPath> >
     class MCAmericanMaxEngine
         : public MCLongstaffSchwartzEngine<VanillaOption::engine,
                                            MultiVariate,RNG>{
@@ -112,7 +113,7 @@ namespace {
                           new AmericanMaxPathPricer(this->arguments_.payoff));
 
             return boost::shared_ptr<LongstaffSchwartzPathPricer<MultiPath> > (
-                new LongstaffSchwartzPathPricer<MultiPath>(
+                new LsmPricer(
                     this->timeGrid(),
                     earlyExercisePathPricer,
                     process->riskFreeRate().currentLink()));
@@ -315,6 +316,99 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testCompactPathPricer() {
+
+    BOOST_TEST_MESSAGE("Testing compact Longstaff-Schwartz path pricer...");
+
+    SavedSettings backup;
+
+    const Date todaysDate(15, May, 1998);
+    const Date settlementDate(17, May, 1998);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Date maturity(16, May, 2001);
+    const DayCounter dayCounter = Actual365Fixed();
+
+    boost::shared_ptr<Exercise> americanExercise(
+        new AmericanExercise(settlementDate, maturity));
+
+    Handle<YieldTermStructure> flatTermStructure(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(settlementDate, 0.05, dayCounter)));
+    Handle<YieldTermStructure> flatDividendTS(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(settlementDate, 0.10, dayCounter)));
+    Handle<BlackVolTermStructure> flatVolTS(
+        boost::shared_ptr<BlackVolTermStructure>(new
+            BlackConstantVol(settlementDate, NullCalendar(),
+                             0.20, dayCounter)));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+        new PlainVanillaPayoff(Option::Call, 100.0));
+
+    RelinkableHandle<Quote> underlyingH;
+
+    boost::shared_ptr<GeneralizedBlackScholesProcess> stochasticProcess(new
+        GeneralizedBlackScholesProcess(
+            underlyingH, flatDividendTS, flatTermStructure, flatVolTS));
+
+    const Size numberAssets = 2;
+    Matrix corr(numberAssets, numberAssets, 0.0);
+    std::vector<boost::shared_ptr<StochasticProcess1D> > v;
+    for (Size i=0; i<numberAssets; ++i) {
+        v.push_back(stochasticProcess);
+        corr[i][i] = 1.0;
+    }
+
+    boost::shared_ptr<StochasticProcessArray> process(
+        new StochasticProcessArray(v, corr));
+    VanillaOption americanMaxOption(payoff, americanExercise);
+
+    // same paths for both engines; only the storage of the
+    // calibration data and the regression method differ
+    boost::shared_ptr<PricingEngine> standardEngine(
+        new MCAmericanMaxEngine<PseudoRandom>(
+                                    process, 25, Null<Size>(), false,
+                                    true, false, 2048, Null<Real>(),
+                                    Null<Size>(), 42, 2048));
+    boost::shared_ptr<PricingEngine> compactEngine(
+        new MCAmericanMaxEngine<PseudoRandom,
+                        CompactLongstaffSchwartzPathPricer<MultiPath> >(
+                                    process, 25, Null<Size>(), false,
+                                    true, false, 2048, Null<Real>(),
+                                    Null<Size>(), 42, 2048));
+
+    const Real tolerance = 1.0e-8;
+    for (Size i=0; i<3; ++i) {
+        const Real underlying = 90.0 + i*10.0;
+        underlyingH.linkTo(
+            boost::shared_ptr<Quote>(new SimpleQuote(underlying)));
+
+        americanMaxOption.setPricingEngine(standardEngine);
+        const Real expected = americanMaxOption.NPV();
+        const Real expectedProbability =
+            americanMaxOption.result<Real>("exerciseProbability");
+
+        americanMaxOption.setPricingEngine(compactEngine);
+        const Real calculated = americanMaxOption.NPV();
+        const Real calculatedProbability =
+            americanMaxOption.result<Real>("exerciseProbability");
+
+        if (std::fabs(calculated - expected) > tolerance
+            || std::fabs(calculatedProbability - expectedProbability)
+                                                             > tolerance) {
+            BOOST_ERROR("Failed to reproduce standard pricer results"
+                        << "\n    underlying:  " << underlying
+                        << "\n    expected:    " << expected
+                        << " (exercise probability "
+                        << expectedProbability << ")"
+                        << "\n    calculated:  " << calculated
+                        << " (exercise probability "
+                        << calculatedProbability << ")");
+        }
+    }
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
     // FLOATING_POINT_EXCEPTION
@@ -322,6 +416,8 @@ test_suite* MCLongstaffSchwartzEngineTest::suite() {
          &MCLongstaffSchwartzEngineTest::testAmericanOption));
     suite->add(QUANTLIB_TEST_CASE(
          &MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testCompactPathPricer));
     return suite;
 }
 
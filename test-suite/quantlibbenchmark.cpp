@@ -77,6 +77,11 @@
 
 #include <ql/types.hpp>
 #include <ql/version.hpp>
+#include <ql/termstructures/credit/cdscurvebatchbuilder.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/timer.hpp>
 #include <iostream>
@@ -127,6 +132,7 @@
 #include "riskstats.hpp"
 #include "shortratemodels.hpp"
 
+using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
 
@@ -155,9 +161,40 @@ namespace {
                              // point operations (not per sec!)
     };
 
+    // cases timed in items per second, reported separately since
+    // their flop count is not measured
+    class Throughput {
+      public:
+        typedef void (*fct_ptr)();
+        Throughput(std::string name, fct_ptr f, double items,
+                   std::string unit)
+        : f_(f), name_(name), items_(items), unit_(unit) {
+        }
+
+        test_case* getTestCase() const {
+            return QUANTLIB_TEST_CASE(f_);
+        }
+        double getItems() const {
+            return items_;
+        }
+        std::string getName() const {
+            return name_;
+        }
+        std::string getUnit() const {
+            return unit_;
+        }
+      private:
+        fct_ptr f_;
+        const std::string name_;
+        const double items_; // number of items processed by f
+        const std::string unit_;
+    };
+
     boost::timer t;
     std::list<double> runTimes;
     std::list<Benchmark> bm;
+    std::list<double> throughputTimes;
+    std::list<Throughput> tp;
 
     /* PAPI code
     float real_time, proc_time, mflops;
@@ -183,6 +220,45 @@ namespace {
         */
     }
 
+    const Size cdsCurveBatchNames = 20000;
+
+    void cdsCurveBatchBootstrap() {
+        SavedSettings backup;
+
+        Calendar calendar = TARGET();
+        Date today = calendar.adjust(Date(9,June,2016));
+        Settings::instance().evaluationDate() = today;
+
+        std::vector<Period> tenors;
+        tenors.push_back(1*Years);
+        tenors.push_back(2*Years);
+        tenors.push_back(3*Years);
+        tenors.push_back(5*Years);
+        tenors.push_back(7*Years);
+        tenors.push_back(10*Years);
+
+        Handle<YieldTermStructure> discountCurve(
+            boost::shared_ptr<YieldTermStructure>(
+                new FlatForward(today, 0.02, Actual365Fixed())));
+        CdsCurveBatchBuilder builder(tenors, 1, calendar, Quarterly,
+                                     Following, DateGeneration::TwentiethIMM,
+                                     Actual360(), discountCurve,
+                                     Actual365Fixed());
+
+        std::vector<std::vector<Rate> > spreads(
+                   cdsCurveBatchNames, std::vector<Rate>(tenors.size()));
+        std::vector<Real> recoveryRates(cdsCurveBatchNames);
+        for (Size i=0; i<cdsCurveBatchNames; ++i) {
+            for (Size j=0; j<tenors.size(); ++j)
+                spreads[i][j] = 0.002*(1 + i%7) + 0.0008*j*(1 + i%3);
+            recoveryRates[i] = 0.25 + 0.01*(i%20);
+        }
+
+        startTimer();
+        builder.curves(spreads, recoveryRates);
+        throughputTimes.push_back(t.elapsed());
+    }
+
     void printResults() {
         std::string header = "Benchmark Suite "
         #ifdef BOOST_MSVC
@@ -218,6 +294,22 @@ namespace {
                   << std::fixed << std::setw(6) << std::setprecision(1)
                   << sum/runTimes.size()
                   << " mflops" << std::endl;
+
+        if (tp.empty())
+            return;
+        std::cout << std::endl;
+        std::list<double>::const_iterator iterTT = throughputTimes.begin();
+        std::list<Throughput>::const_iterator iterTP = tp.begin();
+        while (iterTT != throughputTimes.end()) {
+            std::cout << iterTP->getName()
+                      << std::string(42-iterTP->getName().length(),' ')
+                      << ":" << std::fixed << std::setw(9)
+                      << std::setprecision(1)
+                      << iterTP->getItems()/(*iterTT)
+                      << " " << iterTP->getUnit() << std::endl;
+            iterTT++;
+            iterTP++;
+        }
     }
 }
 
@@ -284,6 +376,9 @@ test_suite* init_unit_test_suite(int, char*[]) {
     bm.push_back(Benchmark("ShortRateModel::Swaps",
         &ShortRateModelTest::testSwaps, 454.73));
 
+    tp.push_back(Throughput("CdsCurveBatchBuilder::curves",
+        &cdsCurveBatchBootstrap, cdsCurveBatchNames, "names/s"));
+
     test_suite* test = BOOST_TEST_SUITE("QuantLib benchmark suite");
 
     for (std::list<Benchmark>::const_iterator iter = bm.begin();
@@ -293,6 +388,10 @@ test_suite* init_unit_test_suite(int, char*[]) {
         test->add(QUANTLIB_TEST_CASE(stopTimer));
     }
 
+    for (std::list<Throughput>::const_iterator iter = tp.begin();
+         iter != tp.end(); ++iter)
+        test->add(iter->getTestCase());
+
     test->add(QUANTLIB_TEST_CASE(printResults));
 
     return test;
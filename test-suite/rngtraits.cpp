@@ -92,11 +92,112 @@ void RngTraitsTest::testCustomPoisson() {
 }
 
 
+void RngTraitsTest::testPhiloxValues() {
+
+    BOOST_TEST_MESSAGE("Testing Philox counter-based generator...");
+
+    // known-answer values published by the Philox authors
+    const boost::uint32_t keys[][2] = {
+        { 0x00000000UL, 0x00000000UL },
+        { 0xffffffffUL, 0xffffffffUL },
+        { 0xa4093822UL, 0x299f31d0UL }
+    };
+    const boost::uint32_t counters[][4] = {
+        { 0x00000000UL, 0x00000000UL, 0x00000000UL, 0x00000000UL },
+        { 0xffffffffUL, 0xffffffffUL, 0xffffffffUL, 0xffffffffUL },
+        { 0x243f6a88UL, 0x85a308d3UL, 0x13198a2eUL, 0x03707344UL }
+    };
+    const boost::uint32_t expected[][4] = {
+        { 0x6627e8d5UL, 0xe169c58dUL, 0xbc57ac4cUL, 0x9b00dbd8UL },
+        { 0x408f276dUL, 0x41c83b0eUL, 0xa20bc7c6UL, 0x6d5451fdUL },
+        { 0xd16cfe09UL, 0x94fdccebUL, 0x5001e420UL, 0x24126ea1UL }
+    };
+
+    for (Size i=0; i<LENGTH(keys); i++) {
+        boost::uint32_t result[4];
+        PhiloxUniformRng::block(keys[i], counters[i], result);
+        for (Size j=0; j<4; j++) {
+            if (result[j] != expected[i][j])
+                BOOST_ERROR("Philox value mismatch in test case " << i
+                            << "\n    word:       " << j
+                            << "\n    calculated: " << result[j]
+                            << "\n    expected:   " << expected[i][j]);
+        }
+    }
+
+    // random access
+    BigNatural seed = 42, stream = 7;
+    Size skip[] = { 0, 1, 3, 4, 1001 };
+    for (Size i=0; i<LENGTH(skip); i++) {
+        PhiloxUniformRng rng1(seed, stream), rng2(seed, stream);
+        for (Size j=0; j<skip[i]; j++)
+            rng1.nextInt32();
+        rng2.skipTo(skip[i]);
+        for (Size j=0; j<10; j++) {
+            unsigned long x1 = rng1.nextInt32(), x2 = rng2.nextInt32();
+            if (x1 != x2)
+                BOOST_ERROR("mismatch after skipping " << skip[i]
+                            << " numbers:"
+                            << "\n    expected: " << x1
+                            << "\n    found:    " << x2);
+        }
+    }
+}
+
+
+void RngTraitsTest::testCounterBasedStreams() {
+
+    BOOST_TEST_MESSAGE("Testing counter-based sequence generators...");
+
+    BigNatural seed = 1234;
+    Size dimension = 50, streams = 10;
+
+    // draw the streams in reverse order from a second set of generators
+    std::vector<std::vector<Real> > forward(streams), backward(streams);
+    for (Size i=0; i<streams; i++) {
+        CounterBasedPseudoRandom::rsg_type rsg =
+            CounterBasedPseudoRandom::make_sequence_generator(dimension,
+                                                              seed, i);
+        forward[i] = rsg.nextSequence().value;
+    }
+    for (Size i=streams; i>0; i--) {
+        CounterBasedPseudoRandom::rsg_type rsg =
+            CounterBasedPseudoRandom::make_sequence_generator(dimension,
+                                                              seed, i-1);
+        backward[i-1] = rsg.nextSequence().value;
+    }
+
+    for (Size i=0; i<streams; i++) {
+        if (forward[i] != backward[i])
+            BOOST_ERROR("stream " << i << " is not reproduced");
+        for (Size j=0; j<i; j++) {
+            if (forward[i] == forward[j])
+                BOOST_ERROR("streams " << j << " and " << i
+                            << " are identical");
+        }
+    }
+
+    // the sample mean should be close to zero
+    Real sum = 0.0;
+    for (Size i=0; i<streams; i++)
+        for (Size j=0; j<dimension; j++)
+            sum += forward[i][j];
+    Real mean = sum/(streams*dimension);
+    Real tolerance = 4.0/std::sqrt(Real(streams*dimension));
+    if (std::fabs(mean) > tolerance)
+        BOOST_ERROR("sample mean out of range:"
+                    << "\n    calculated: " << mean
+                    << "\n    tolerance:  " << tolerance);
+}
+
+
 test_suite* RngTraitsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("RNG traits tests");
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testGaussian));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testDefaultPoisson));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCustomPoisson));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testPhiloxValues));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCounterBasedStreams));
     return suite;
 }
 
@@ -31,6 +31,8 @@ class RngTraitsTest {
     static void testGaussian();
     static void testDefaultPoisson();
     static void testCustomPoisson();
+    static void testPhiloxValues();
+    static void testCounterBasedStreams();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -24,11 +24,16 @@
 #include "shortratemodels.hpp"
 #include "utilities.hpp"
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/models/shortrate/twofactormodels/g2.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
+#include <ql/experimental/risk/hullwhiteexposuresimulator.hpp>
+#include <ql/instruments/capfloor.hpp>
+#include <ql/pricingengines/capfloor/analyticcapfloorengine.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
+#include <ql/currencies/europe.hpp>
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/math/optimization/simplex.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
@@ -427,6 +432,174 @@ void ShortRateModelTest::testFuturesConvexityBias() {
     }
 }
 
+void ShortRateModelTest::testTreeRollback() {
+    BOOST_TEST_MESSAGE("Testing specialized rollback on short-rate trees...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<YieldTermStructure> termStructure(flatRate(today, 0.04,
+                                                      Actual365Fixed()));
+    TimeGrid grid(10.0, 40);
+
+    Real tolerance = 1.0e-14;
+
+    boost::shared_ptr<OneFactorModel::ShortRateTree> tree1 =
+        boost::dynamic_pointer_cast<OneFactorModel::ShortRateTree>(
+                      HullWhite(termStructure, 0.1, 0.01).tree(grid));
+    for (Size i=0; i<grid.size()-1; ++i) {
+        Array values(tree1->size(i+1));
+        for (Size j=0; j<values.size(); ++j)
+            values[j] = std::sin(Real(j+i));
+        Array expected(tree1->size(i)), calculated(tree1->size(i));
+        tree1->TreeLattice<OneFactorModel::ShortRateTree>::stepback(
+                                                      i, values, expected);
+        tree1->stepback(i, values, calculated);
+        for (Size j=0; j<expected.size(); ++j) {
+            if (std::fabs(calculated[j]-expected[j]) > tolerance)
+                BOOST_FAIL("failed to reproduce one-factor rollback:"
+                           << "\n    step:       " << i
+                           << "\n    node:       " << j
+                           << QL_SCIENTIFIC
+                           << "\n    calculated: " << calculated[j]
+                           << "\n    expected:   " << expected[j]);
+        }
+    }
+
+    Real correlations[] = { -0.7, 0.5 };
+    for (Size k=0; k<LENGTH(correlations); ++k) {
+        boost::shared_ptr<TwoFactorModel::ShortRateTree> tree2 =
+            boost::dynamic_pointer_cast<TwoFactorModel::ShortRateTree>(
+                G2(termStructure, 0.1, 0.01, 0.2, 0.008,
+                   correlations[k]).tree(grid));
+        for (Size i=0; i<grid.size()-1; ++i) {
+            Array values(tree2->size(i+1));
+            for (Size j=0; j<values.size(); ++j)
+                values[j] = std::sin(Real(j+i));
+            Array expected(tree2->size(i)), calculated(tree2->size(i));
+            tree2->TreeLattice<TwoFactorModel::ShortRateTree>::stepback(
+                                                      i, values, expected);
+            tree2->stepback(i, values, calculated);
+            for (Size j=0; j<expected.size(); ++j) {
+                if (std::fabs(calculated[j]-expected[j]) > tolerance)
+                    BOOST_FAIL("failed to reproduce two-factor rollback:"
+                               << "\n    correlation: " << correlations[k]
+                               << "\n    step:        " << i
+                               << "\n    node:        " << j
+                               << QL_SCIENTIFIC
+                               << "\n    calculated:  " << calculated[j]
+                               << "\n    expected:    " << expected[j]);
+            }
+        }
+    }
+}
+
+void ShortRateModelTest::testHullWhiteExposure() {
+    BOOST_TEST_MESSAGE("Testing Hull-White Monte Carlo exposure...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    Calendar calendar = TARGET();
+    today = calendar.adjust(today);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<YieldTermStructure> termStructure(
+                                  flatRate(today, 0.04, Actual365Fixed()));
+    boost::shared_ptr<HullWhite> model(
+                             new HullWhite(termStructure, 0.05, 0.01));
+    // no fixing days, so that the caplets expire at the start of
+    // their accrual periods as assumed by the analytic engine
+    boost::shared_ptr<IborIndex> index(
+                     new IborIndex("index", 6*Months, 0, EURCurrency(),
+                                   calendar, ModifiedFollowing, false,
+                                   Actual360(), termStructure));
+
+    // payer swap starting in two years
+    Date startDate = calendar.advance(today, 2, Years);
+    Date maturity = calendar.advance(startDate, 5, Years);
+    Schedule fixedSchedule(startDate, maturity, Period(Annual),
+                           calendar, Unadjusted, Unadjusted,
+                           DateGeneration::Forward, false);
+    Schedule floatSchedule(startDate, maturity, Period(Semiannual),
+                           calendar, Following, Following,
+                           DateGeneration::Forward, false);
+    Real nominal = 1000000.0;
+    boost::shared_ptr<VanillaSwap> swap(
+        new VanillaSwap(VanillaSwap::Payer, nominal,
+                        fixedSchedule, 0.04, Thirty360(),
+                        floatSchedule, index, 0.0, Actual360()));
+    swap->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                   new DiscountingSwapEngine(termStructure)));
+
+    boost::shared_ptr<CapFloor> cap(
+               new Cap(swap->floatingLeg(), std::vector<Rate>(1, 0.045)));
+    cap->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                       new AnalyticCapFloorEngine(model)));
+
+    // the exposure date precedes all fixings
+    Date exposureDate = calendar.advance(today, 1, Years);
+
+    std::vector<HullWhiteExposureSimulator::NettingSet> nettingSets(2);
+    nettingSets[0].push_back(swap);
+    nettingSets[1].push_back(cap);
+    HullWhiteExposureSimulator simulator(
+                    model, nettingSets,
+                    std::vector<Date>(1, exposureDate), 20000, 42);
+
+    Real tolerance = 1.0e-8;
+    Real calculated = simulator.npv(0), expected = swap->NPV();
+    if (std::fabs(calculated-expected) > tolerance*nominal)
+        BOOST_ERROR("failed to reproduce swap NPV:"
+                    << QL_FIXED << std::setprecision(4)
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+    calculated = simulator.npv(1);
+    expected = cap->NPV();
+    if (std::fabs(calculated-expected) > tolerance*nominal)
+        BOOST_ERROR("failed to reproduce cap NPV:"
+                    << QL_FIXED << std::setprecision(4)
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+
+    // the discounted positive and negative exposures of the swap are
+    // the values of the payer and receiver swaptions expiring at the
+    // exposure date; the one of the cap is its value
+    boost::shared_ptr<PricingEngine> swaptionEngine(
+                                     new JamshidianSwaptionEngine(model));
+    boost::shared_ptr<Exercise> exercise(
+                                      new EuropeanExercise(exposureDate));
+    Swaption payer(swap, exercise);
+    payer.setPricingEngine(swaptionEngine);
+    boost::shared_ptr<VanillaSwap> receiverSwap(
+        new VanillaSwap(VanillaSwap::Receiver, nominal,
+                        fixedSchedule, 0.04, Thirty360(),
+                        floatSchedule, index, 0.0, Actual360()));
+    Swaption receiver(receiverSwap, exercise);
+    receiver.setPricingEngine(swaptionEngine);
+
+    DiscountFactor discount = termStructure->discount(exposureDate);
+    Real results[][2] = {
+        { discount*simulator.expectedExposure(0)[0], payer.NPV() },
+        { discount*simulator.expectedNegativeExposure(0)[0],
+          receiver.NPV() },
+        { discount*simulator.expectedExposure(1)[0], cap->NPV() }
+    };
+    std::string labels[] = { "payer swaption", "receiver swaption", "cap" };
+    // Monte Carlo error
+    tolerance = 0.03;
+    for (Size i=0; i<LENGTH(results); ++i) {
+        Real error = std::fabs(results[i][0]/results[i][1] - 1.0);
+        if (error > tolerance)
+            BOOST_ERROR("failed to reproduce " << labels[i] << " value:"
+                        << QL_FIXED << std::setprecision(4)
+                        << "\n    calculated: " << results[i][0]
+                        << "\n    expected:   " << results[i][1]
+                        << QL_SCIENTIFIC
+                        << "\n    rel. error: " << error);
+    }
+}
+
 test_suite* ShortRateModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Short-rate model tests");
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite));
@@ -434,6 +607,8 @@ test_suite* ShortRateModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite2));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testSwaps));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testTreeRollback));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testHullWhiteExposure));
     return suite;
 }
 
@@ -32,6 +32,8 @@ class ShortRateModelTest {
     static void testCachedHullWhiteFixedReversion();
     static void testCachedHullWhite2();
     static void testSwaps();
+    static void testTreeRollback();
+    static void testHullWhiteExposure();
     static boost::unit_test_framework::test_suite* suite();
 };
 
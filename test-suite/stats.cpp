@@ -27,6 +27,7 @@
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
@@ -124,6 +125,7 @@ void StatisticsTest::testStatistics() {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<StreamingStatistics>(std::string("StreamingStatistics"));
 }
 
 
@@ -389,11 +391,287 @@ void StatisticsTest::testIncrementalStatistics() {
                                  << tol);
 }
 
+void StatisticsTest::testStreamingStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing streaming statistics...");
+
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal_gen(mt);
+
+    const Size n = 200000, parts = 4, tailSize = 10000;
+    std::vector<Real> x(n), w(n);
+    for (Size i=0; i<n; ++i) {
+        x[i] = 0.05 + 0.2*normal_gen.next().value;
+        w[i] = 0.5 + mt.nextReal();
+    }
+
+    RiskStatistics expected;
+    expected.addSequence(x.begin(), x.end(), w.begin());
+
+    // with few samples, the results are the same as those of
+    // the general statistics
+    RiskStatistics few;
+    StreamingRiskStatistics fewStreaming;
+    few.addSequence(x.begin(), x.begin()+2*tailSize, w.begin());
+    fewStreaming.addSequence(x.begin(), x.begin()+2*tailSize, w.begin());
+
+    Real tolerance = 1.0e-12;
+    Real percentiles[] = { 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99 };
+    for (Size i=0; i<LENGTH(percentiles); ++i) {
+        Real p = percentiles[i];
+        if (fewStreaming.percentile(p) != few.percentile(p))
+            BOOST_ERROR("failed to reproduce " << p << " percentile"
+                        << "\n    calculated: " << fewStreaming.percentile(p)
+                        << "\n    expected:   " << few.percentile(p));
+        if (fewStreaming.topPercentile(p) != few.topPercentile(p))
+            BOOST_ERROR("failed to reproduce " << p << " top percentile"
+                        << "\n    calculated: "
+                        << fewStreaming.topPercentile(p)
+                        << "\n    expected:   " << few.topPercentile(p));
+    }
+    if (std::fabs(fewStreaming.semiVariance() - few.semiVariance())
+                                                               > tolerance)
+        BOOST_ERROR("failed to reproduce semivariance"
+                    << "\n    calculated: " << fewStreaming.semiVariance()
+                    << "\n    expected:   " << few.semiVariance());
+
+    // with more samples, the tails are still exact...
+    StreamingRiskStatistics streaming;
+    std::vector<StreamingRiskStatistics> partial(parts);
+    for (Size i=0; i<n; ++i) {
+        streaming.add(x[i], w[i]);
+        partial[(i*parts)/n].add(x[i], w[i]);
+    }
+    // ...also when merging partial results
+    StreamingRiskStatistics merged = partial[0];
+    for (Size k=1; k<parts; ++k)
+        merged.merge(partial[k]);
+
+    StreamingRiskStatistics* results[] = { &streaming, &merged };
+    std::string names[] = { "streaming", "merged" };
+    for (Size k=0; k<LENGTH(results); ++k) {
+        const StreamingRiskStatistics& s = *results[k];
+
+        if (s.samples() != n)
+            BOOST_ERROR(names[k] << ": wrong number of samples"
+                        << "\n    calculated: " << s.samples()
+                        << "\n    expected:   " << n);
+
+        if (s.min() != expected.min() || s.max() != expected.max())
+            BOOST_ERROR(names[k] << ": wrong extrema"
+                        << "\n    calculated: " << s.min() << ", " << s.max()
+                        << "\n    expected:   "
+                        << expected.min() << ", " << expected.max());
+
+        Real moments[][2] = {
+            { s.mean(), expected.mean() },
+            { s.variance(), expected.variance() },
+            { s.skewness(), expected.skewness() },
+            { s.kurtosis(), expected.kurtosis() }
+        };
+        std::string momentNames[] = {
+            "mean", "variance", "skewness", "kurtosis"
+        };
+        for (Size j=0; j<LENGTH(moments); ++j) {
+            if (std::fabs(moments[j][0]-moments[j][1]) > 1.0e-10)
+                BOOST_ERROR(names[k] << ": wrong " << momentNames[j]
+                            << std::setprecision(16)
+                            << "\n    calculated: " << moments[j][0]
+                            << "\n    expected:   " << moments[j][1]);
+        }
+
+        Real centiles[] = { 0.975, 0.99, 0.999 };
+        for (Size j=0; j<LENGTH(centiles); ++j) {
+            Real c = centiles[j];
+            if (s.valueAtRisk(c) != expected.valueAtRisk(c))
+                BOOST_ERROR(names[k] << ": wrong value at risk at "
+                            << io::percent(c)
+                            << "\n    calculated: " << s.valueAtRisk(c)
+                            << "\n    expected:   "
+                            << expected.valueAtRisk(c));
+            if (std::fabs(s.expectedShortfall(c)
+                          - expected.expectedShortfall(c)) > tolerance)
+                BOOST_ERROR(names[k] << ": wrong expected shortfall at "
+                            << io::percent(c)
+                            << "\n    calculated: "
+                            << s.expectedShortfall(c)
+                            << "\n    expected:   "
+                            << expected.expectedShortfall(c));
+            if (s.topPercentile(1.0-c) != expected.topPercentile(1.0-c))
+                BOOST_ERROR(names[k] << ": wrong top percentile at "
+                            << io::percent(c)
+                            << "\n    calculated: "
+                            << s.topPercentile(1.0-c)
+                            << "\n    expected:   "
+                            << expected.topPercentile(1.0-c));
+        }
+
+        // ...while the rank error in the digest is bounded
+        for (Size j=0; j<LENGTH(percentiles); ++j) {
+            Real p = percentiles[j];
+            Real bound = M_PI/s.compression() * std::sqrt(p*(1.0-p));
+            Real calculated = s.percentile(p);
+            Real lower = expected.percentile(std::max(p-bound, 1.0e-6));
+            Real upper = expected.percentile(std::min(p+bound, 1.0));
+            if (calculated < lower || calculated > upper)
+                BOOST_ERROR(names[k] << ": " << p << " percentile"
+                            << " out of expected range"
+                            << "\n    calculated: " << calculated
+                            << "\n    range:      ["
+                            << lower << ", " << upper << "]");
+        }
+
+        if (s.centroids() > Size(s.compression()))
+            BOOST_ERROR(names[k] << ": too many centroids"
+                        << "\n    calculated: " << s.centroids()
+                        << "\n    expected:   " << s.compression()
+                        << " at most");
+    }
+}
+
+void StatisticsTest::testMergedStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing merged statistics...");
+
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal_gen(mt);
+
+    const Size n = 50000, dimension = 4;
+    Size breaks[] = { 0, 1, 1000, 20000, n };
+    const Real offset = 1.0e6;
+    Matrix samples(n, dimension);
+    std::vector<Real> weights(n);
+    for (Size k=0; k<n; ++k) {
+        Real z = normal_gen.next().value;
+        for (Size i=0; i<dimension; ++i)
+            samples[k][i] = offset + (i+1.0)*z + normal_gen.next().value;
+        weights[k] = 0.5 + mt.nextReal();
+    }
+
+    // one-dimensional statistics
+    IncrementalStatistics incremental, mergedIncremental;
+    Statistics general, mergedGeneral;
+    for (Size p=0; p<LENGTH(breaks)-1; ++p) {
+        IncrementalStatistics partialIncremental;
+        Statistics partialGeneral;
+        for (Size k=breaks[p]; k<breaks[p+1]; ++k) {
+            Real x = samples[k][0] - offset;
+            incremental.add(x, weights[k]);
+            partialIncremental.add(x, weights[k]);
+            general.add(x, weights[k]);
+            partialGeneral.add(x, weights[k]);
+        }
+        mergedIncremental.merge(partialIncremental);
+        mergedGeneral.merge(partialGeneral);
+    }
+
+    if (mergedIncremental.samples() != n || mergedGeneral.samples() != n)
+        BOOST_ERROR("wrong number of merged samples"
+                    << "\n    incremental: " << mergedIncremental.samples()
+                    << "\n    general:     " << mergedGeneral.samples()
+                    << "\n    expected:    " << n);
+
+    Real tolerance = 1.0e-10;
+    Real results[][3] = {
+        { mergedIncremental.mean(), incremental.mean(), general.mean() },
+        { mergedIncremental.variance(), incremental.variance(),
+          general.variance() },
+        { mergedIncremental.skewness(), incremental.skewness(),
+          general.skewness() },
+        { mergedIncremental.kurtosis(), incremental.kurtosis(),
+          general.kurtosis() },
+        { mergedIncremental.min(), incremental.min(), general.min() },
+        { mergedIncremental.max(), incremental.max(), general.max() },
+        { mergedIncremental.downsideVariance(),
+          incremental.downsideVariance(), general.downsideVariance() }
+    };
+    std::string names[] = { "mean", "variance", "skewness", "kurtosis",
+                            "min", "max", "downside variance" };
+    for (Size j=0; j<LENGTH(results); ++j) {
+        if (std::fabs(results[j][0]-results[j][1]) > tolerance ||
+            std::fabs(results[j][0]-results[j][2]) > tolerance)
+            BOOST_ERROR("wrong merged " << names[j]
+                        << std::setprecision(16)
+                        << "\n    merged:      " << results[j][0]
+                        << "\n    incremental: " << results[j][1]
+                        << "\n    general:     " << results[j][2]);
+    }
+
+    Real percentiles[] = { 0.01, 0.1, 0.5, 0.9, 0.99 };
+    for (Size j=0; j<LENGTH(percentiles); ++j) {
+        Real p = percentiles[j];
+        if (mergedGeneral.percentile(p) != general.percentile(p))
+            BOOST_ERROR("wrong merged " << p << " percentile"
+                        << "\n    merged:   " << mergedGeneral.percentile(p)
+                        << "\n    expected: " << general.percentile(p));
+    }
+
+    // covariance, with samples added one by one, in blocks and merged
+    SequenceStatisticsInc sequential(dimension), blocks(dimension),
+                          merged(dimension);
+    for (Size p=0; p<LENGTH(breaks)-1; ++p) {
+        Size size = breaks[p+1]-breaks[p];
+        Matrix block(size, dimension);
+        std::vector<Real> blockWeights(size);
+        for (Size k=0; k<size; ++k) {
+            std::copy(samples.row_begin(breaks[p]+k),
+                      samples.row_end(breaks[p]+k), block.row_begin(k));
+            blockWeights[k] = weights[breaks[p]+k];
+            sequential.add(block.row_begin(k), block.row_end(k),
+                           blockWeights[k]);
+        }
+        blocks.addSamples(block, blockWeights);
+        SequenceStatisticsInc partial;
+        partial.addSamples(block, blockWeights);
+        merged.merge(partial);
+    }
+
+    // two-pass calculation
+    std::vector<Real> means(dimension, 0.0);
+    Real weightSum = 0.0;
+    for (Size k=0; k<n; ++k) {
+        weightSum += weights[k];
+        for (Size i=0; i<dimension; ++i)
+            means[i] += weights[k]*samples[k][i];
+    }
+    for (Size i=0; i<dimension; ++i)
+        means[i] /= weightSum;
+    Matrix expected(dimension, dimension, 0.0);
+    for (Size k=0; k<n; ++k)
+        for (Size i=0; i<dimension; ++i)
+            for (Size j=0; j<dimension; ++j)
+                expected[i][j] += weights[k]*(samples[k][i]-means[i])
+                                            *(samples[k][j]-means[j]);
+    expected *= (n/(n-1.0))/weightSum;
+
+    Matrix covariances[] = { sequential.covariance(), blocks.covariance(),
+                             merged.covariance() };
+    std::string methods[] = { "sequential", "block", "merged" };
+    for (Size m=0; m<LENGTH(covariances); ++m) {
+        for (Size i=0; i<dimension; ++i) {
+            for (Size j=0; j<dimension; ++j) {
+                Real calculated = covariances[m][i][j];
+                if (std::fabs(calculated-expected[i][j])
+                                    > tolerance*std::fabs(expected[i][j]))
+                    BOOST_ERROR(methods[m] << " covariance: "
+                                << "wrong (" << i << "," << j
+                                << ") element" << std::setprecision(16)
+                                << "\n    calculated: " << calculated
+                                << "\n    expected:   " << expected[i][j]);
+            }
+        }
+    }
+}
+
 test_suite* StatisticsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testIncrementalStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStreamingStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testMergedStatistics));
     return suite;
 }
@@ -35,6 +35,7 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/currencies/europe.hpp>
+#include <ql/experimental/risk/scenarioanalysis.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -322,6 +323,105 @@ void SwapTest::testCachedValue() {
 }
 
 
+void SwapTest::testScenarioAnalysis() {
+
+    BOOST_TEST_MESSAGE("Testing scenario analysis of swaps...");
+
+    // two independent copies of swaps on two separate curves; the
+    // j-th swap depends on the (j%2)-th quote
+    Size nCopies = 2, nCurves = 2;
+    Integer lengths[] = { 2, 5, 10 };
+    Rate rates[] = { 0.04, 0.05 };
+    std::vector<boost::shared_ptr<CommonVars> > vars;
+    std::vector<ScenarioAnalysis::Portfolio> copies(nCopies);
+    for (Size c=0; c<nCopies; ++c) {
+        for (Size k=0; k<nCurves; ++k) {
+            boost::shared_ptr<CommonVars> v(new CommonVars);
+            boost::shared_ptr<SimpleQuote> rate(new SimpleQuote(rates[k]));
+            v->termStructure.linkTo(flatRate(v->settlement, rate,
+                                             Actual365Fixed()));
+            copies[c].quotes.push_back(Handle<SimpleQuote>(rate));
+            vars.push_back(v);
+        }
+        for (Size i=0; i<LENGTH(lengths); ++i)
+            for (Size k=0; k<nCurves; ++k)
+                copies[c].instruments.push_back(
+                    vars[c*nCurves+k]->makeSwap(lengths[i], 0.045, 0.0));
+    }
+    const ScenarioAnalysis::Portfolio& portfolio = copies[0];
+    Size nInstruments = portfolio.instruments.size();
+
+    ScenarioAnalysis analysis(copies);
+    ScenarioAnalysis serialAnalysis(
+                            std::vector<ScenarioAnalysis::Portfolio>(1,
+                                                                portfolio));
+    for (Size k=0; k<nCurves; ++k) {
+        const std::vector<Size>& dependencies = analysis.dependencies()[k];
+        bool correct = dependencies.size() == LENGTH(lengths);
+        for (Size j=0; j<dependencies.size(); ++j)
+            correct = correct && dependencies[j] % nCurves == k;
+        if (!correct)
+            BOOST_ERROR("wrong dependencies for quote #" << k);
+    }
+
+    Real data[][2] = {
+        {  0.0010,  0.0    },
+        {  0.0,    -0.0020 },
+        { -0.0005,  0.0015 },
+        {  0.0,     0.0    },
+        {  0.0030, -0.0010 }
+    };
+    Matrix shifts(LENGTH(data), nCurves);
+    for (Size s=0; s<shifts.rows(); ++s)
+        std::copy(data[s], data[s]+nCurves, shifts.row_begin(s));
+
+    std::vector<Real> base = analysis.npvs();
+    Matrix calculated = analysis.scenarios(shifts);
+    Matrix serial = serialAnalysis.scenarios(shifts);
+    Real tolerance = 1.0e-10;
+    for (Size s=0; s<shifts.rows(); ++s) {
+        for (Size k=0; k<nCurves; ++k)
+            portfolio.quotes[k]->setValue(rates[k]+shifts[s][k]);
+        for (Size j=0; j<nInstruments; ++j) {
+            Real expected = portfolio.instruments[j]->NPV() - base[j];
+            if (std::fabs(calculated[s][j]-expected) > tolerance
+                || serial[s][j] != calculated[s][j])
+                BOOST_ERROR("failed to reproduce NPV change:"
+                            << "\n    scenario:   " << s
+                            << "\n    instrument: " << j
+                            << QL_SCIENTIFIC
+                            << "\n    calculated: " << calculated[s][j]
+                            << "\n    serial:     " << serial[s][j]
+                            << "\n    expected:   " << expected);
+        }
+        for (Size k=0; k<nCurves; ++k)
+            portfolio.quotes[k]->setValue(rates[k]);
+    }
+
+    std::pair<Matrix, Matrix> sensitivities = analysis.bucketAnalysis();
+    for (Size k=0; k<nCurves; ++k) {
+        for (Size j=0; j<nInstruments; ++j) {
+            std::pair<Real, Real> expected =
+                bucketAnalysis(portfolio.quotes[k],
+                               std::vector<boost::shared_ptr<Instrument> >(
+                                              1, portfolio.instruments[j]),
+                               std::vector<Real>());
+            if (std::fabs(sensitivities.first[k][j]-expected.first) > 1.0e-6
+                || std::fabs(sensitivities.second[k][j]-expected.second)
+                                                                   > 1.0e-2)
+                BOOST_ERROR("failed to reproduce bucket sensitivities:"
+                            << "\n    quote:      " << k
+                            << "\n    instrument: " << j
+                            << QL_SCIENTIFIC
+                            << "\n    calculated: "
+                            << sensitivities.first[k][j] << ", "
+                            << sensitivities.second[k][j]
+                            << "\n    expected:   " << expected.first
+                            << ", " << expected.second);
+        }
+    }
+}
+
 test_suite* SwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swap tests");
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testFairRate));
@@ -330,6 +430,7 @@ test_suite* SwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testSpreadDependency));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testInArrears));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testCachedValue));
+    suite->add(QUANTLIB_TEST_CASE(&SwapTest::testScenarioAnalysis));
     return suite;
 }
 